@@ -0,0 +1,55 @@
+/*
+ * Layout of the files written by the binary writer.
+ *
+ * All values are in the byte order of the computer that wrote the file,
+ * which the reader verifies with the field byteOrder.
+ *
+ * Header
+ *   char     magic[8]      BINARYWRITER_MAGIC, without '\0'
+ *   uint32_t byteOrder     BINARYWRITER_BYTE_ORDER
+ *   uint32_t version       BINARYWRITER_VERSION
+ *   uint32_t numColumns    Number of columns, including the time
+ *   uint32_t chunkRows     Maximum number of rows of a chunk
+ *   uint64_t numRows       Number of rows, written when the file is closed
+ *   For each column:
+ *     uint32_t type        BINARYWRITER_TYPE_DOUBLE
+ *     uint32_t nameLength  Number of characters of the name
+ *     char     name[nameLength], without '\0'
+ *
+ * Chunks, until the end of the file
+ *   uint32_t numRows       Number of rows of the chunk
+ *   uint32_t codec         BINARYWRITER_CODEC_NONE or BINARYWRITER_CODEC_XOR
+ *   uint64_t numBytes      Number of bytes of the data that follow
+ *   data                   Values in column-major order, encoded with codec
+ *
+ * BINARYWRITER_CODEC_XOR encodes each value as the XOR of its bits with the
+ * bits of the previous value of the same column in the chunk, or with 0 for the first row.
+ * Each encoded value starts with a control byte h:
+ *   h & 0x80 != 0   The XOR is zero for this and the next (h & 0x7F) values,
+ *                   which hence repeat the previous value.
+ *   h & 0x80 == 0   The XOR has (h >> 3) leading and (h & 0x07) trailing zero bytes,
+ *                   and its remaining bytes follow, most significant byte first.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_binaryWriterFormat_h
+#define Buildings_binaryWriterFormat_h
+
+#include <stdint.h>
+
+#define BINARYWRITER_MAGIC "BLDGBIN\n"
+#define BINARYWRITER_BYTE_ORDER 0x01020304u
+#define BINARYWRITER_VERSION 1u
+
+#define BINARYWRITER_TYPE_DOUBLE 1u
+
+#define BINARYWRITER_CODEC_NONE 0u
+#define BINARYWRITER_CODEC_XOR 1u
+
+/* Offset of the field numRows in the header */
+#define BINARYWRITER_NUMROWS_OFFSET 24
+
+/* Maximum number of bytes of an encoded value */
+#define BINARYWRITER_MAX_ENCODED 9
+
+#endif
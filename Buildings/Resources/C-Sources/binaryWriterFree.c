@@ -0,0 +1,31 @@
+/* Function that frees the memory for the binary writer.
+ *
+ * agent                                 10/19/2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "binaryWriterFree.h"
+
+void binaryWriterFree(void* ptrFileWriter){
+  FileWriter *ID = (FileWriter*)ptrFileWriter;
+  uint64_t numRows;
+
+  if (ID->fp != NULL){
+    /* Write the rows of the last chunk, and the number of rows to the header */
+    writeBinaryChunk(ptrFileWriter);
+    numRows = (uint64_t)ID->numRows;
+    if (fseek(ID->fp, BINARYWRITER_NUMROWS_OFFSET, SEEK_SET) != 0 ||
+        fwrite(&numRows, sizeof(numRows), 1, ID->fp) != 1)
+      ModelicaFormatError("In binaryWriterFree.c: The file %s could not be written.", ID->fileWriterName);
+    if (fclose(ID->fp) == EOF)
+      ModelicaFormatError("In binaryWriterFree.c: Returned an error when closing %s.", ID->fileWriterName);
+    ID->fp = NULL;
+  }
+  free(ID->chunk);
+  free(ID->encoded);
+
+  freeBase(ptrFileWriter);
+
+  return;
+}
@@ -0,0 +1,17 @@
+/* Function that frees the memory for the binary writer.
+ *
+ * agent                                 10/19/2026
+ */
+
+#ifndef IBPSA_BINARYWRITERFree_h
+#define IBPSA_BINARYWRITERFree_h
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "fileWriterStructure.h"
+#include "binaryWriterInit.h"
+
+void binaryWriterFree(void* ptrFileWriter);
+
+#endif
@@ -0,0 +1,160 @@
+/* Functions that ensures that each binary writer writes to a unique file
+ * and that writes its inputs in chunks of columns, see binaryWriterFormat.h.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "binaryWriterInit.h"
+#include "fileWriterStructure.c"
+
+static void writeBinaryData(FileWriter* ID, const void* data, const size_t size){
+  if (size > 0 && fwrite(data, size, 1, ID->fp) != 1)
+    ModelicaFormatError("In binaryWriterInit.c: Returned an error when writing to %s.", ID->fileWriterName);
+}
+
+static void writeUint32(FileWriter* ID, const uint32_t val){
+  writeBinaryData(ID, &val, sizeof(val));
+}
+
+static void writeUint64(FileWriter* ID, const uint64_t val){
+  writeBinaryData(ID, &val, sizeof(val));
+}
+
+void* binaryWriterInit(
+  const char* instanceName,
+  const char* fileName,
+  const int numColumns,
+  char** columnNames,
+  const int chunkRows,
+  const int compress){
+
+  int i;
+  FileWriter* ID = (FileWriter*)allocateFileWriter(instanceName, fileName);
+
+  if (numColumns < 1)
+    ModelicaFormatError("In binaryWriterInit.c: The binary writer %s must write at least one column.", instanceName);
+  if (chunkRows < 1)
+    ModelicaFormatError("In binaryWriterInit.c: The number of rows of a chunk of the binary writer %s must be positive.", instanceName);
+  if (compress < 0 || compress > 1)
+    ModelicaFormatError("In binaryWriterInit.c: The initialisation flag 'compress' of binary writer %s must equal 0 or 1 but it equals %i.", instanceName, compress);
+  ID->isCombiTimeTable=0;
+  ID->numColumns=numColumns;
+  ID->numRows=0;
+  ID->chunkRows=chunkRows;
+  ID->numRowsChunk=0;
+  ID->compress=compress;
+
+  ID->chunk = malloc((size_t)chunkRows * numColumns * sizeof(double));
+  if ( ID->chunk == NULL )
+    ModelicaFormatError("Not enough memory in binaryWriterInit.c for allocating the chunk of binary writer %s.", instanceName);
+  ID->encoded = NULL;
+  if (compress){
+    ID->encoded = malloc((size_t)chunkRows * numColumns * BINARYWRITER_MAX_ENCODED);
+    if ( ID->encoded == NULL )
+      ModelicaFormatError("Not enough memory in binaryWriterInit.c for allocating the compressed chunk of binary writer %s.", instanceName);
+  }
+
+  ID->fp = fopen(fileName, "wb");
+  if (ID->fp == NULL)
+    ModelicaFormatError("In binaryWriterInit.c: Failed to create file %s during initialisation.", fileName);
+
+  /* Write the header. The number of rows is written in binaryWriterFree(). */
+  writeBinaryData(ID, BINARYWRITER_MAGIC, strlen(BINARYWRITER_MAGIC));
+  writeUint32(ID, BINARYWRITER_BYTE_ORDER);
+  writeUint32(ID, BINARYWRITER_VERSION);
+  writeUint32(ID, (uint32_t)numColumns);
+  writeUint32(ID, (uint32_t)chunkRows);
+  writeUint64(ID, 0);
+  for (i = 0; i < numColumns; ++i){
+    writeUint32(ID, BINARYWRITER_TYPE_DOUBLE);
+    writeUint32(ID, (uint32_t)strlen(columnNames[i]));
+    writeBinaryData(ID, columnNames[i], strlen(columnNames[i]));
+  }
+  return (void*) ID;
+}
+
+/* This function encodes the n values of a column with BINARYWRITER_CODEC_XOR,
+and returns the number of bytes written to out. */
+static size_t encodeColumn(const double* values, const size_t n, unsigned char* out){
+  uint64_t prev = 0;
+  uint64_t cur;
+  uint64_t x;
+  size_t i;
+  size_t k = 0;
+  size_t iRun = 0; /* Position of the control byte of the current run of repeated values */
+  int nRun = 0;    /* Number of values in the current run */
+  int lead;
+  int trail;
+  int j;
+
+  for (i = 0; i < n; ++i){
+    memcpy(&cur, &values[i], sizeof(cur));
+    x = cur ^ prev;
+    prev = cur;
+    if (x == 0){
+      if (nRun > 0 && nRun < 128){
+        out[iRun] = (unsigned char)(0x80 | nRun);
+        nRun++;
+      }
+      else{
+        iRun = k;
+        out[k++] = 0x80;
+        nRun = 1;
+      }
+    }
+    else{
+      nRun = 0;
+      for (lead = 0; ((x >> (56 - 8 * lead)) & 0xFF) == 0; ++lead){}
+      for (trail = 0; ((x >> (8 * trail)) & 0xFF) == 0; ++trail){}
+      out[k++] = (unsigned char)((lead << 3) | trail);
+      for (j = 7 - lead; j >= trail; --j)
+        out[k++] = (unsigned char)((x >> (8 * j)) & 0xFF);
+    }
+  }
+  return k;
+}
+
+/* This function writes the rows that are buffered in the current chunk.
+The chunk is stored uncompressed if compression does not reduce its size. */
+void writeBinaryChunk(void *ptrFileWriter){
+  FileWriter *ID = (FileWriter*)ptrFileWriter;
+  const size_t n = (size_t)ID->numRowsChunk;
+  size_t numBytes = 0;
+  int i;
+
+  if (n == 0)
+    return;
+  if (ID->compress){
+    for (i = 0; i < ID->numColumns; ++i)
+      numBytes += encodeColumn(ID->chunk + (size_t)i * ID->chunkRows, n, ID->encoded + numBytes);
+  }
+  writeUint32(ID, (uint32_t)n);
+  if (ID->compress && numBytes < n * ID->numColumns * sizeof(double)){
+    writeUint32(ID, BINARYWRITER_CODEC_XOR);
+    writeUint64(ID, (uint64_t)numBytes);
+    writeBinaryData(ID, ID->encoded, numBytes);
+  }
+  else{
+    writeUint32(ID, BINARYWRITER_CODEC_NONE);
+    writeUint64(ID, (uint64_t)(n * ID->numColumns * sizeof(double)));
+    for (i = 0; i < ID->numColumns; ++i)
+      writeBinaryData(ID, ID->chunk + (size_t)i * ID->chunkRows, n * sizeof(double));
+  }
+  ID->numRowsChunk = 0;
+}
+
+/* This function adds a row to the current chunk, and writes the chunk once it is full. */
+void writeBinary(void *ptrFileWriter, const double* values, const int numValues){
+  FileWriter *ID = (FileWriter*)ptrFileWriter;
+  int i;
+
+  if (ID->numColumns != numValues)
+    ModelicaFormatError("In binaryWriterInit.c: The binary writer %s writes %d columns but received %d values.",
+      ID->instanceName, ID->numColumns, numValues);
+  for (i = 0; i < numValues; ++i)
+    ID->chunk[(size_t)i * ID->chunkRows + ID->numRowsChunk] = values[i];
+  ID->numRowsChunk++;
+  ID->numRows++;
+  if (ID->numRowsChunk == ID->chunkRows)
+    writeBinaryChunk(ptrFileWriter);
+}
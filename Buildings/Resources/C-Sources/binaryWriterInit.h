@@ -0,0 +1,28 @@
+/* Functions that write the inputs of a binary writer to a
+ * columnar binary file, see binaryWriterFormat.h.
+ *
+ * agent                                 10/19/2026
+ */
+
+#ifndef IBPSA_BINARYWRITERInit_h
+#define IBPSA_BINARYWRITERInit_h
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fileWriterStructure.h"
+#include "binaryWriterFormat.h"
+
+void* binaryWriterInit(
+  const char* instanceName,
+  const char* fileName,
+  const int numColumns,
+  char** columnNames,
+  const int chunkRows,
+  const int compress);
+
+void writeBinary(void *ptrFileWriter, const double* values, const int numValues);
+void writeBinaryChunk(void *ptrFileWriter);
+
+#endif
@@ -0,0 +1,260 @@
+/*
+ * Streaming non-cryptographic hash for fingerprints of files and strings.
+ *
+ * The digest has 128 bits and consists of two lanes of XXH64,
+ * with the seeds 0 and FAST_HASH_SEED, which are computed in the same pass
+ * over the data. The hash is fast enough to fingerprint large idf, weather
+ * and FMU files in milliseconds, but it must not be used where an adversary
+ * could construct collisions.
+ * Words are read in the native byte order. Hence, digests can be compared
+ * on the same computer, but should not be exchanged between computers
+ * with a different byte order.
+ *
+ * Files are read through mmap, except on Windows and if mmap fails,
+ * in which case they are read in blocks.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "fastHash.h"
+
+#ifndef Buildings_fastHash_c
+#define Buildings_fastHash_c
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#ifdef _WIN32
+#include <errno.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+#define FAST_HASH_PRIME1 UINT64_C(0x9E3779B185EBCA87)
+#define FAST_HASH_PRIME2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define FAST_HASH_PRIME3 UINT64_C(0x165667B19E3779F9)
+#define FAST_HASH_PRIME4 UINT64_C(0x85EBCA77C2B2AE63)
+#define FAST_HASH_PRIME5 UINT64_C(0x27D4EB2F165667C5)
+/* Seed of the second lane */
+#define FAST_HASH_SEED UINT64_C(0x9E3779B97F4A7C15)
+/* Size of the blocks if a file is not mapped into memory */
+#define FAST_HASH_BLOCK_SIZE 65536
+
+static const uint64_t FastHashSeeds[2] = {0, FAST_HASH_SEED};
+
+static uint64_t rotl64(uint64_t x, int r){
+  return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t read64(const unsigned char* p){
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint32_t read32(const unsigned char* p){
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint64_t round64(uint64_t acc, uint64_t input){
+  acc += input * FAST_HASH_PRIME2;
+  acc = rotl64(acc, 31);
+  return acc * FAST_HASH_PRIME1;
+}
+
+static uint64_t mergeRound64(uint64_t acc, uint64_t val){
+  acc ^= round64(0, val);
+  return acc * FAST_HASH_PRIME1 + FAST_HASH_PRIME4;
+}
+
+/* Add the stripe of 32 bytes at p to both lanes */
+static void consumeStripe(FastHash* ctx, const unsigned char* p){
+  const uint64_t w0 = read64(p);
+  const uint64_t w1 = read64(p+8);
+  const uint64_t w2 = read64(p+16);
+  const uint64_t w3 = read64(p+24);
+  int l;
+
+  for(l = 0; l < 2; l++){
+    ctx->acc[l][0] = round64(ctx->acc[l][0], w0);
+    ctx->acc[l][1] = round64(ctx->acc[l][1], w1);
+    ctx->acc[l][2] = round64(ctx->acc[l][2], w2);
+    ctx->acc[l][3] = round64(ctx->acc[l][3], w3);
+  }
+}
+
+/* Return the digest of the lane l */
+static uint64_t finalLane(const FastHash* ctx, int l){
+  const unsigned char* p = ctx->buffer;
+  const unsigned char* end = ctx->buffer + ctx->bufferLength;
+  const uint64_t* v = ctx->acc[l];
+  uint64_t h;
+
+  if (ctx->totalLength >= 32){
+    h = rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) + rotl64(v[3], 18);
+    h = mergeRound64(h, v[0]);
+    h = mergeRound64(h, v[1]);
+    h = mergeRound64(h, v[2]);
+    h = mergeRound64(h, v[3]);
+  }
+  else{
+    h = FastHashSeeds[l] + FAST_HASH_PRIME5;
+  }
+  h += ctx->totalLength;
+
+  while (p + 8 <= end){
+    h ^= round64(0, read64(p));
+    h = rotl64(h, 27) * FAST_HASH_PRIME1 + FAST_HASH_PRIME4;
+    p += 8;
+  }
+  if (p + 4 <= end){
+    h ^= (uint64_t)read32(p) * FAST_HASH_PRIME1;
+    h = rotl64(h, 23) * FAST_HASH_PRIME2 + FAST_HASH_PRIME3;
+    p += 4;
+  }
+  while (p < end){
+    h ^= (uint64_t)(*p) * FAST_HASH_PRIME5;
+    h = rotl64(h, 11) * FAST_HASH_PRIME1;
+    p++;
+  }
+
+  h ^= h >> 33;
+  h *= FAST_HASH_PRIME2;
+  h ^= h >> 29;
+  h *= FAST_HASH_PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+void fastHashInit(FastHash* ctx){
+  int l;
+  for(l = 0; l < 2; l++){
+    ctx->acc[l][0] = FastHashSeeds[l] + FAST_HASH_PRIME1 + FAST_HASH_PRIME2;
+    ctx->acc[l][1] = FastHashSeeds[l] + FAST_HASH_PRIME2;
+    ctx->acc[l][2] = FastHashSeeds[l];
+    ctx->acc[l][3] = FastHashSeeds[l] - FAST_HASH_PRIME1;
+  }
+  ctx->bufferLength = 0;
+  ctx->totalLength = 0;
+}
+
+/* Add len bytes at data to the hash */
+void fastHashUpdate(FastHash* ctx, const void* data, size_t len){
+  const unsigned char* p = (const unsigned char*)data;
+  const unsigned char* end = p + len;
+  size_t nFill;
+
+  ctx->totalLength += len;
+  if (ctx->bufferLength + len < 32){
+    if (len > 0)
+      memcpy(ctx->buffer + ctx->bufferLength, p, len);
+    ctx->bufferLength += len;
+    return;
+  }
+
+  /* Complete the stripe of the previous call */
+  if (ctx->bufferLength > 0){
+    nFill = 32 - ctx->bufferLength;
+    memcpy(ctx->buffer + ctx->bufferLength, p, nFill);
+    consumeStripe(ctx, ctx->buffer);
+    p += nFill;
+    ctx->bufferLength = 0;
+  }
+  while ((size_t)(end - p) >= 32){
+    consumeStripe(ctx, p);
+    p += 32;
+  }
+  if (p < end){
+    ctx->bufferLength = (size_t)(end - p);
+    memcpy(ctx->buffer, p, ctx->bufferLength);
+  }
+}
+
+/* Write the digest of all data added so far as a hex string to hexDigest,
+   which must hold FAST_HASH_HEX_LENGTH+1 characters.
+   The context is not changed, hence more data can be added afterwards. */
+void fastHashFinal(const FastHash* ctx, char* hexDigest){
+  sprintf(hexDigest, "%016" PRIx64 "%016" PRIx64, finalLane(ctx, 0), finalLane(ctx, 1));
+}
+
+/* Add the content of the file fileName to the hash.
+   Return 0 on success, or -1 if the file cannot be read, in which case errno is set. */
+int fastHashFile(FastHash* ctx, const char* fileName){
+  unsigned char buff[FAST_HASH_BLOCK_SIZE];
+#ifdef _WIN32
+  FILE* fp;
+  size_t n;
+  int ret = 0;
+
+  fp = fopen(fileName, "rb");
+  if (fp == NULL)
+    return -1;
+  while ((n = fread(buff, 1, sizeof(buff), fp)) > 0)
+    fastHashUpdate(ctx, buff, n);
+  if (ferror(fp)){
+    errno = EIO;
+    ret = -1;
+  }
+  fclose(fp);
+  return ret;
+#else
+  int fd;
+  struct stat st;
+  void* map;
+  ssize_t n;
+  size_t len;
+
+  fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    return -1;
+  if (fstat(fd, &st) != 0){
+    close(fd);
+    return -1;
+  }
+  len = (size_t)st.st_size;
+  if (S_ISREG(st.st_mode) && len > 0){
+    map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED){
+      posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+      fastHashUpdate(ctx, map, len);
+      munmap(map, len);
+      close(fd);
+      return 0;
+    }
+  }
+  /* Empty files, files that are not regular files, and files that cannot be mapped */
+  while ((n = read(fd, buff, sizeof(buff))) != 0){
+    if (n < 0){
+      if (errno == EINTR)
+        continue;
+      close(fd);
+      return -1;
+    }
+    fastHashUpdate(ctx, buff, (size_t)n);
+  }
+  close(fd);
+  return 0;
+#endif
+}
+
+/* Write the digest of the content of the file fileName as a hex string to hexDigest,
+   which must hold FAST_HASH_HEX_LENGTH+1 characters.
+   Return 0 on success, or -1 if the file cannot be read, in which case errno is set. */
+int fastHashFileHex(const char* fileName, char* hexDigest){
+  FastHash ctx;
+
+  fastHashInit(&ctx);
+  if (fastHashFile(&ctx, fileName) != 0)
+    return -1;
+  fastHashFinal(&ctx, hexDigest);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * Streaming non-cryptographic hash for fingerprints of files and strings.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_fastHash_h
+#define Buildings_fastHash_h
+
+#include <stddef.h>  /* stddef defines size_t */
+#include <stdint.h>
+
+/* Number of hex characters of a digest, without the terminating '\0' */
+#define FAST_HASH_HEX_LENGTH 32
+
+typedef struct FastHash
+{
+  uint64_t acc[2][4];          /* Accumulators of the two lanes */
+  unsigned char buffer[32];    /* Input that does not yet fill a stripe of 32 bytes */
+  size_t bufferLength;         /* Number of bytes in buffer */
+  uint64_t totalLength;        /* Number of bytes hashed so far */
+} FastHash;
+
+void fastHashInit(FastHash* ctx);
+
+void fastHashUpdate(FastHash* ctx, const void* data, size_t len);
+
+void fastHashFinal(const FastHash* ctx, char* hexDigest);
+
+int fastHashFile(FastHash* ctx, const char* fileName);
+
+int fastHashFileHex(const char* fileName, char* hexDigest);
+
+#endif
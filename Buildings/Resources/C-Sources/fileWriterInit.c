@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
 
 #include "fileWriterStructure.c"
 
@@ -14,9 +15,11 @@ void* fileWriterInit(
   const char* instanceName,
   const char* fileName,
   const int numColumns,
-  const int isCombiTimeTable){
+  const int isCombiTimeTable,
+  const int flushRows,
+  const int flushBytes,
+  const double flushInterval){
 
-  FILE *fp;
   FileWriter* ID = (FileWriter*)allocateFileWriter(instanceName, fileName);
 
   if (numColumns < 0)
@@ -28,27 +31,65 @@ void* fileWriterInit(
     ModelicaFormatError("In fileWriterInit.c: The initialisation flag 'isCombiTimeTable' of FileWriter %s must equal 0 or 1 but it equals %i.", instanceName, isCombiTimeTable);
   ID->isCombiTimeTable=isCombiTimeTable;
 
-  fp = fopen(fileName, "w");
-  if (fp == NULL)
+  if (flushRows < 1 || flushBytes < 1 || flushInterval < 0)
+    ModelicaFormatError("In fileWriterInit.c: The parameters 'flushRows' and 'flushBytes' of FileWriter %s must be positive and 'flushInterval' cannot be negative.", instanceName);
+  ID->flushRows=flushRows;
+  ID->numRowsBuffered=0;
+  ID->flushInterval=flushInterval;
+  ID->tNextFlush=-DBL_MAX; /* Flush at the first row, and then every flushInterval */
+
+  /* Keep the file open until fileWriterFree() rather than opening it for each line.
+     The lines are buffered and written once flushBytes are buffered,
+     or when the file is flushed. */
+  ID->fp = fopen(fileName, "w");
+  if (ID->fp == NULL)
     ModelicaFormatError("In fileWriterInit.c: Failed to create empty .csv file %s during initialisation.", fileName);
-  if (fclose(fp)==EOF)
-    ModelicaFormatError("In fileWriterInit.c: Returned an error when closing %s.", fileName);
+  if (setvbuf(ID->fp, NULL, _IOFBF, (size_t)flushBytes) != 0)
+    ModelicaFormatError("In fileWriterInit.c: Failed to allocate a buffer of %i bytes for file %s.", flushBytes, fileName);
+
+  /* Reserve the CombiTimeTable header, which is overwritten in fileWriterFree()
+     once the number of rows is known. */
+  if (ID->isCombiTimeTable)
+    writeCombiTimeTableHeader(ID);
   return (void*) ID;
 }
 
 /* This function writes a line to the FileWriter object file
 and counts the total number of lines that are written
-by incrementing the counter numRows if isMetaData==0. */
-void writeLine(void *ptrFileWriter, const char* line, const int isMetaData){
+by incrementing the counter numRows if isMetaData==0.
+The file is flushed after flushRows rows and,
+if flushInterval > 0, after flushInterval of simulated time. */
+void writeLine(void *ptrFileWriter, const char* line, const int isMetaData, const double time){
   FileWriter *ID = (FileWriter*)ptrFileWriter;
-  FILE *fOut = fopen(ID->fileWriterName, "a");
-  if (fOut == NULL)
-    ModelicaFormatError("In fileWriterInit.c: Failed open .csv file %s for appending.", ID->fileWriterName);
-  if (fputs(line, fOut)==EOF){
+  if (fputs(line, ID->fp)==EOF){
     ModelicaFormatError("In fileWriterInit.c: Returned an error when writing to %s.", ID->fileWriterName);
   }
-  if (isMetaData==0)
+  if (isMetaData==0){
     ID->numRows=ID->numRows+1;
-  if (fclose(fOut)==EOF)
-    ModelicaFormatError("In fileWriterInit.c: Returned an error when closing %s.", ID->fileWriterName);
+    ID->numRowsBuffered=ID->numRowsBuffered+1;
+    if (ID->numRowsBuffered >= ID->flushRows ||
+       (ID->flushInterval > 0 && time >= ID->tNextFlush)){
+      if (fflush(ID->fp)==EOF)
+        ModelicaFormatError("In fileWriterInit.c: Returned an error when writing to %s.", ID->fileWriterName);
+      ID->numRowsBuffered=0;
+      if (ID->flushInterval > 0 && time >= ID->tNextFlush)
+        ID->tNextFlush=time+ID->flushInterval;
+    }
+  }
+}
+
+/* This function writes the CombiTimeTable header with the current number
+of rows. The header is padded with spaces to COMBITIMETABLE_HEADER_LENGTH characters
+so that it can be overwritten in place. */
+void writeCombiTimeTableHeader(void *ptrFileWriter){
+  FileWriter *ID = (FileWriter*)ptrFileWriter;
+  char buf[COMBITIMETABLE_HEADER_LENGTH+32];
+  int n = sprintf(buf,"#1\ndouble csv(%i,%i)",ID->numRows,ID->numColumns);
+  if (n < 0 || n > COMBITIMETABLE_HEADER_LENGTH-1)
+    ModelicaFormatError("In fileWriterInit.c: Failed to write the CombiTimeTable header of %s.", ID->fileWriterName);
+  memset(buf+n, ' ', COMBITIMETABLE_HEADER_LENGTH-1-n);
+  buf[COMBITIMETABLE_HEADER_LENGTH-1]='\n';
+  buf[COMBITIMETABLE_HEADER_LENGTH]='\0';
+  if (fputs(buf, ID->fp)==EOF)
+    ModelicaFormatError("In fileWriterInit.c: Returned an error when writing to %s.", ID->fileWriterName);
 }
@@ -62,6 +62,7 @@ void* allocateFileWriter(
   if ( ID->instanceName == NULL )
     ModelicaFormatError("Not enough memory in fileWriterStructure.c for allocating ID->instanceName in FileWriter %s.", instanceName);
   strcpy(ID->instanceName, instanceName);
+  ID->fp = NULL;
 
   fp = fopen(fileName, "w");
   if (fp == NULL)
@@ -11,8 +11,10 @@ static char** FileWriterNames; /* Array with pointers to all file names */
 static char** InstanceNames; /* Array with pointers to all instance names */
 static unsigned int FileWriterNames_n = 0;     /* Number of files */
 
+#define COMBITIMETABLE_HEADER_LENGTH 48 /* Number of characters reserved for the CombiTimeTable header at the start of the file */
+
 typedef struct FileWriter {
-  /* Common for CSV and JSON writer */
+  /* Common for CSV, JSON and binary writer */
   char* fileWriterName; /* The result data file of this file writer */
   char* instanceName; /* The name of the Modelica model instance that corresponds to this file writer. For error reporting purposes. */
 
@@ -20,6 +22,18 @@ typedef struct FileWriter {
   int isCombiTimeTable; /* Indicates whether combiTimeTable header should be prepended before destruction */
   int numRows; /* Number of lines that have been written to file */
   int numColumns; /* Number of rows that the file writer is storing */
+  FILE* fp; /* File that stays open while the FileWriter exists, or NULL */
+  int flushRows; /* Number of rows after which the file is flushed */
+  int numRowsBuffered; /* Number of rows that have been written since the last flush */
+  double flushInterval; /* Simulated time after which the file is flushed, or 0 */
+  double tNextFlush; /* Simulated time at which the file is flushed next if flushInterval > 0 */
+
+  /* Parameters for binary writer only, which also uses numRows, numColumns and fp */
+  int chunkRows; /* Number of rows of a chunk */
+  int numRowsChunk; /* Number of rows in the current chunk */
+  int compress; /* Indicates whether the chunks are compressed */
+  double *chunk; /* Values of the current chunk, in column-major order with chunkRows rows */
+  unsigned char *encoded; /* Buffer for the compressed chunk */
 
   /* Parameters for JSON writer only */
   int dumpAtDestruction; /* Indicates whether json data should be dumped before destruction */
@@ -29,7 +43,9 @@ typedef struct FileWriter {
 
 } FileWriter;
 
-void writeLine(void *ptrFileWriter, const char* line, const int isMetaData); /* This function writes a line to the FileWriter object file and counts the number of lines that are written. */
+void writeLine(void *ptrFileWriter, const char* line, const int isMetaData, const double time); /* This function writes a line to the FileWriter object file and counts the number of lines that are written. */
+
+void writeCombiTimeTableHeader(void *ptrFileWriter); /* This function writes the CombiTimeTable header with COMBITIMETABLE_HEADER_LENGTH characters at the current position of the file. */
 
 void* allocateFileWriter(const char* instanceName, const char* fileName); /* This function verifies whether a file writer with the same path does not yet exist */
 
@@ -54,3 +54,40 @@ def r1_r1PassPythonObject(xR, obj):
     res = obj['a'] + obj['b']
     #raise Exception("Result is {}".format(res))
     return [res, obj]
+
+# Functions for arrays that are passed as lists, memoryviews or NumPy arrays,
+# see the environment variable MODELICA_BUILDINGS_PYTHON_ARRAYS
+def r3_r3Array(xR):
+    # Return an object with the buffer protocol, which is copied in bulk
+    import array
+    return array.array('d', [2.*x for x in xR])
+
+def r3i3_r3i3Reversed(xR, xI):
+    # Return the arguments in reverse order. For memoryviews and NumPy arrays,
+    # these are strided views that share the memory of the simulator.
+    return [xR[::-1], xI[::-1]]
+
+# Function that keeps a reference to its argument.
+# The argument lists are reused between calls, but not if Python still
+# references them. Hence, the list stored in obj must not change.
+def r2_r1KeepArgument(xR, obj):
+    if obj is not None and obj['x'] != obj['copy']:
+        raise Exception("Argument of previous call changed from {} to {}".format(obj['copy'], obj['x']))
+    return [xR[0] + xR[1], {'x': xR, 'copy': list(xR)}]
+
+# Function that processes a batch of 4 samples per call.
+# xR has one row per sample, and one row per sample is returned.
+# The values returned to Modelica lag the arguments by 4 samples.
+def r2_r1Batch(xR):
+    # Rows of two-dimensional memoryviews cannot be iterated, hence convert them
+    rows = xR.tolist() if hasattr(xR, 'tolist') else xR
+    return [[row[0] + row[1]] for row in rows]
+r2_r1Batch.modelica_batch_size = 4
+
+# Function that returns twice its argument, the id of the process
+# that runs it, and the id of the parent of this process.
+# If MODELICA_BUILDINGS_PYTHON_WORKER=1, this is the worker of the Python object,
+# and the parent is the simulator.
+def r1_r3Worker(xR):
+    import os
+    return [2.*xR, float(os.getpid()), float(os.getppid())]
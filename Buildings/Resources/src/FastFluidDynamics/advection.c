@@ -155,6 +155,8 @@ int trace_vx(PARA_DATA *para, REAL **var, int var_type, REAL *d, REAL *d0,
           +(w[IX(i+1,j,k)]+w[IX(i+1,j, k-1)])*(gx[IX(i,  j,k)]- x[IX(i,j,k)]))
         / (x[IX(i+1,j,k)]-x[IX(i,j,k)]);
     /* Find the location at previous time step*/
+    if(para->solv->steady==1)
+      dt = local_time_step(para, var, VX, i, j, k);
     OL[X] =gx[IX(i,j,k)] - u0*dt;
     OL[Y] = y[IX(i,j,k)] - v0*dt;
     OL[Z] = z[IX(i,j,k)] - w0*dt;
@@ -286,6 +288,8 @@ int trace_vy(PARA_DATA *para, REAL **var, int var_type, REAL *d, REAL *d0,
          +(w[IX(i,j+1,k)]+w[IX(i,j+1,k-1)])*(gy[IX(i,j,k)]-y[IX(i,j,k)]))
        / (y[IX(i,j+1,k)]-y[IX(i,j,k)]);
     /* Find the location at previous time step*/
+    if(para->solv->steady==1)
+      dt = local_time_step(para, var, VY, i, j, k);
     OL[X] = x[IX(i,j,k)] - u0*dt;
     OL[Y] = gy[IX(i,j,k)] - v0*dt;
     OL[Z] = z[IX(i,j,k)] - w0*dt;
@@ -401,6 +405,8 @@ int trace_vz(PARA_DATA *para, REAL **var, int var_type, REAL *d, REAL *d0,
        /  (z[IX(i,j,k+1)]-z[IX(i,j,k)]);
     w0 = w[IX(i,j,k)];
     /* Find the location at previous time step*/
+    if(para->solv->steady==1)
+      dt = local_time_step(para, var, VZ, i, j, k);
     OL[X] = x[IX(i,j,k)] - u0*dt;
     OL[Y] = y[IX(i,j,k)] - v0*dt;
     OL[Z] = gz[IX(i,j,k)] - w0*dt;
@@ -510,6 +516,8 @@ int trace_scalar(PARA_DATA *para, REAL **var, int var_type, int index,
     v0 = (REAL) 0.5 * (v[IX(i,j,k)]+v[IX(i,j-1,k  )]);
     w0 = (REAL) 0.5 * (w[IX(i,j,k)]+w[IX(i,j  ,k-1)]);
     /* Find the location at previous time step*/
+    if(para->solv->steady==1)
+      dt = local_time_step(para, var, var_type, i, j, k);
     OL[X] = x[IX(i,j,k)] - u0*dt;
     OL[Y] = y[IX(i,j,k)] - v0*dt;
     OL[Z] = z[IX(i,j,k)] - w0*dt;
@@ -561,8 +569,10 @@ int trace_scalar(PARA_DATA *para, REAL **var, int var_type, int index,
     if(w0<0 && LOC[Z]==1) OC[Z] -=1;
 
     /*Store the local minimum and maximum values*/
-    var[LOCMIN][IX(i,j,k)]=check_min(para, d0, OC[X], OC[Y], OC[Z]);
-    var[LOCMAX][IX(i,j,k)]=check_max(para, d0, OC[X], OC[Y], OC[Z]);
+    if(var[LOCMIN]!=NULL) {
+      var[LOCMIN][IX(i,j,k)]=check_min(para, d0, OC[X], OC[Y], OC[Z]);
+      var[LOCMAX][IX(i,j,k)]=check_max(para, d0, OC[X], OC[Y], OC[Z]);
+    }
 
     /*-------------------------------------------------------------------------
     | Interpolate
@@ -52,6 +52,11 @@
 #include "solver.h"
 #endif
 
+#ifndef _STEADY_H
+#define _STEADY_H
+#include "steady.h"
+#endif
+
 /*
 	* Entrance of advection step
 	*
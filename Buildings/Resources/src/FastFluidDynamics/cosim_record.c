@@ -0,0 +1,581 @@
+/*
+	*
+	* \file   cosim_record.c
+	*
+	* \brief  Record the data exchanged with Modelica to a binary trace file
+	*
+	* \author agent
+	*
+	* \date   10/19/2026
+	*
+	* This file provides functions that write and read a compact binary trace
+	* of the coupled simulation. See cosim_record.h for the file layout.
+	*
+	*/
+
+#include "cosim_record.h"
+
+static FILE *file_record = NULL;
+static REAL *record_buffer = NULL;
+
+	/*
+		* Get the length of the input vector u[] of cfdExchangeData()
+		*
+		* @param cosimPara Pointer to the coupled simulation parameters
+		*
+		* @return Number of inputs
+		*/
+int cosim_record_nU(ParameterSharedData *cosimPara) {
+  int n = cosimPara->nSur + 3
+        + cosimPara->nPorts*(2 + cosimPara->nXi + cosimPara->nC);
+
+  if(cosimPara->sha==1) n += 2*cosimPara->nConExtWin;
+
+  return n;
+} /* End of cosim_record_nU()*/
+
+	/*
+		* Get the length of the output vector y[] of cfdExchangeData()
+		*
+		* @param cosimPara Pointer to the coupled simulation parameters
+		*
+		* @return Number of outputs
+		*/
+int cosim_record_nY(ParameterSharedData *cosimPara) {
+  int n = cosimPara->nSur + 1 + cosimPara->nSen
+        + cosimPara->nPorts*(1 + cosimPara->nXi + cosimPara->nC);
+
+  if(cosimPara->sha==1) n += cosimPara->nConExtWin;
+
+  return n;
+} /* End of cosim_record_nY()*/
+
+	/*
+		* Pack the Modelica data into the input vector in the order of cfdExchangeData()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		* @param u Pointer to the input vector
+		*
+		* @return No return needed
+		*/
+void cosim_record_pack_input(CosimulationData *cosim, REAL *u) {
+  int i, j, k;
+
+  for(i=0; i<cosim->para->nSur; i++)
+    u[i] = cosim->modelica->temHea[i];
+
+  if(cosim->para->sha==1) {
+    for(j=0; j<cosim->para->nConExtWin; j++) {
+      u[i+j] = cosim->modelica->shaConSig[j];
+      u[i+j+cosim->para->nConExtWin] = cosim->modelica->shaAbsRad[j];
+    }
+    i = i + 2*cosim->para->nConExtWin;
+  }
+
+  u[i++] = cosim->modelica->sensibleHeat;
+  u[i++] = cosim->modelica->latentHeat;
+  u[i++] = cosim->modelica->p;
+
+  for(j=0; j<cosim->para->nPorts; j++) {
+    u[i+j] = cosim->modelica->mFloRatPor[j];
+    u[i+j+cosim->para->nPorts] = cosim->modelica->TPor[j];
+  }
+  i = i + 2*cosim->para->nPorts;
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nXi; k++, i++)
+      u[i] = cosim->modelica->XiPor[j][k];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nC; k++, i++)
+      u[i] = cosim->modelica->CPor[j][k];
+} /* End of cosim_record_pack_input()*/
+
+	/*
+		* Unpack the input vector into the Modelica data in the order of cfdExchangeData()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		* @param u Pointer to the input vector
+		*
+		* @return No return needed
+		*/
+void cosim_record_unpack_input(CosimulationData *cosim, REAL *u) {
+  int i, j, k;
+
+  for(i=0; i<cosim->para->nSur; i++)
+    cosim->modelica->temHea[i] = u[i];
+
+  if(cosim->para->sha==1) {
+    for(j=0; j<cosim->para->nConExtWin; j++) {
+      cosim->modelica->shaConSig[j] = u[i+j];
+      cosim->modelica->shaAbsRad[j] = u[i+j+cosim->para->nConExtWin];
+    }
+    i = i + 2*cosim->para->nConExtWin;
+  }
+
+  cosim->modelica->sensibleHeat = u[i++];
+  cosim->modelica->latentHeat = u[i++];
+  cosim->modelica->p = u[i++];
+
+  for(j=0; j<cosim->para->nPorts; j++) {
+    cosim->modelica->mFloRatPor[j] = u[i+j];
+    cosim->modelica->TPor[j] = u[i+j+cosim->para->nPorts];
+  }
+  i = i + 2*cosim->para->nPorts;
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nXi; k++, i++)
+      cosim->modelica->XiPor[j][k] = u[i];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nC; k++, i++)
+      cosim->modelica->CPor[j][k] = u[i];
+} /* End of cosim_record_unpack_input()*/
+
+	/*
+		* Pack the FFD data into the output vector in the order of cfdExchangeData()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		* @param y Pointer to the output vector
+		*
+		* @return No return needed
+		*/
+void cosim_record_pack_output(CosimulationData *cosim, REAL *y) {
+  int i, j, k;
+
+  for(i=0; i<cosim->para->nSur; i++)
+    y[i] = cosim->ffd->temHea[i];
+
+  y[i++] = cosim->ffd->TRoo;
+
+  if(cosim->para->sha==1)
+    for(j=0; j<cosim->para->nConExtWin; i++, j++)
+      y[i] = cosim->ffd->TSha[j];
+
+  for(j=0; j<cosim->para->nPorts; i++, j++)
+    y[i] = cosim->ffd->TPor[j];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nXi; k++, i++)
+      y[i] = cosim->ffd->XiPor[j][k];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nC; k++, i++)
+      y[i] = cosim->ffd->CPor[j][k];
+
+  for(j=0; j<cosim->para->nSen; j++, i++)
+    y[i] = cosim->ffd->senVal[j];
+} /* End of cosim_record_pack_output()*/
+
+	/*
+		* Unpack the output vector into the FFD data in the order of cfdExchangeData()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		* @param y Pointer to the output vector
+		*
+		* @return No return needed
+		*/
+void cosim_record_unpack_output(CosimulationData *cosim, REAL *y) {
+  int i, j, k;
+
+  for(i=0; i<cosim->para->nSur; i++)
+    cosim->ffd->temHea[i] = y[i];
+
+  cosim->ffd->TRoo = y[i++];
+
+  if(cosim->para->sha==1)
+    for(j=0; j<cosim->para->nConExtWin; i++, j++)
+      cosim->ffd->TSha[j] = y[i];
+
+  for(j=0; j<cosim->para->nPorts; i++, j++)
+    cosim->ffd->TPor[j] = y[i];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nXi; k++, i++)
+      cosim->ffd->XiPor[j][k] = y[i];
+
+  for(j=0; j<cosim->para->nPorts; j++)
+    for(k=0; k<cosim->para->nC; k++, i++)
+      cosim->ffd->CPor[j][k] = y[i];
+
+  for(j=0; j<cosim->para->nSen; j++, i++)
+    cosim->ffd->senVal[j] = y[i];
+} /* End of cosim_record_unpack_output()*/
+
+	/*
+		* Write a string to the trace file
+		*
+		* @param f Pointer to the trace file
+		* @param s Pointer to the string
+		*
+		* @return 0 if no error occurred
+		*/
+static int write_string(FILE *f, char *s) {
+  int n = s==NULL ? 0 : (int) strlen(s);
+
+  if(fwrite(&n, sizeof(int), 1, f)!=1) return 1;
+  if(n>0 && fwrite(s, sizeof(char), n, f)!=(size_t) n) return 1;
+  return 0;
+} /* End of write_string()*/
+
+	/*
+		* Open the trace file and write the coupled simulation parameters
+		*
+		* @param para Pointer to FFD parameters
+		*
+		* @return 0 if no error occurred
+		*/
+int cosim_record_open(PARA_DATA *para) {
+  ParameterSharedData *cp = para->cosim->para;
+  int i, flag = 0;
+  int header[9];
+  int nBuf;
+
+  if((file_record=fopen(para->inpu->record_file_name, "wb"))==NULL) {
+    sprintf(msg, "cosim_record_open(): Could not open the trace file %.900s",
+            para->inpu->record_file_name);
+    ffd_log(msg, FFD_ERROR);
+    return 1;
+  }
+
+  header[0] = cp->nSur;
+  header[1] = cp->nSen;
+  header[2] = cp->nConExtWin;
+  header[3] = cp->nPorts;
+  header[4] = cp->nXi;
+  header[5] = cp->nC;
+  header[6] = cp->sha;
+  header[7] = cosim_record_nU(cp);
+  header[8] = cosim_record_nY(cp);
+
+  /****************************************************************************
+  | Allocate a buffer that can hold the time stamps and the larger vector
+  ****************************************************************************/
+  nBuf = 2 + (header[7]>header[8] ? header[7] : header[8]);
+  record_buffer = (REAL *) malloc(nBuf*sizeof(REAL));
+  if(record_buffer==NULL) {
+    ffd_log("cosim_record_open(): Could not allocate memory for the trace "
+            "buffer.", FFD_ERROR);
+    cosim_record_close();
+    return 1;
+  }
+
+  flag += fwrite(COSIM_RECORD_MAGIC, sizeof(char), 8, file_record)!=8;
+  flag += fwrite(header, sizeof(int), 9, file_record)!=9;
+  flag += fwrite(&cp->rho_start, sizeof(REAL), 1, file_record)!=1;
+  flag += write_string(file_record, cp->fileName);
+  for(i=0; i<cp->nSur; i++)
+    flag += write_string(file_record, cp->name[i]);
+  for(i=0; i<cp->nPorts; i++)
+    flag += write_string(file_record, cp->portName[i]);
+  for(i=0; i<cp->nSen; i++)
+    flag += write_string(file_record, cp->sensorName[i]);
+  if(cp->nSur>0) {
+    flag += fwrite(cp->are, sizeof(REAL), cp->nSur, file_record)!=(size_t) cp->nSur;
+    flag += fwrite(cp->til, sizeof(REAL), cp->nSur, file_record)!=(size_t) cp->nSur;
+    flag += fwrite(cp->bouCon, sizeof(int), cp->nSur, file_record)!=(size_t) cp->nSur;
+  }
+
+  if(flag!=0) {
+    sprintf(msg, "cosim_record_open(): Could not write the header of trace "
+            "file %.900s", para->inpu->record_file_name);
+    ffd_log(msg, FFD_ERROR);
+    cosim_record_close();
+    return 1;
+  }
+
+  sprintf(msg, "cosim_record_open(): Recording the coupled simulation to %.900s "
+          "with nU=%d, nY=%d", para->inpu->record_file_name,
+          header[7], header[8]);
+  ffd_log(msg, FFD_NORMAL);
+
+  return 0;
+} /* End of cosim_record_open()*/
+
+	/*
+		* Write the data received from Modelica to the trace file
+		*
+		* @param para Pointer to FFD parameters
+		*
+		* @return 0 if no error occurred
+		*/
+int cosim_record_input(PARA_DATA *para) {
+  int tag = COSIM_RECORD_INPUT;
+  int n = 2 + cosim_record_nU(para->cosim->para);
+
+  if(file_record==NULL) return 0;
+
+  record_buffer[0] = para->cosim->modelica->t;
+  record_buffer[1] = para->cosim->modelica->dt;
+  cosim_record_pack_input(para->cosim, record_buffer+2);
+
+  if(fwrite(&tag, sizeof(int), 1, file_record)!=1
+     || fwrite(record_buffer, sizeof(REAL), n, file_record)!=(size_t) n) {
+    ffd_log("cosim_record_input(): Could not write to the trace file.",
+            FFD_ERROR);
+    return 1;
+  }
+
+  return 0;
+} /* End of cosim_record_input()*/
+
+	/*
+		* Write the data sent to Modelica to the trace file
+		*
+		* @param para Pointer to FFD parameters
+		*
+		* @return 0 if no error occurred
+		*/
+int cosim_record_output(PARA_DATA *para) {
+  int tag = COSIM_RECORD_OUTPUT;
+  int n = 1 + cosim_record_nY(para->cosim->para);
+
+  if(file_record==NULL) return 0;
+
+  record_buffer[0] = para->cosim->ffd->t;
+  cosim_record_pack_output(para->cosim, record_buffer+1);
+
+  if(fwrite(&tag, sizeof(int), 1, file_record)!=1
+     || fwrite(record_buffer, sizeof(REAL), n, file_record)!=(size_t) n) {
+    ffd_log("cosim_record_output(): Could not write to the trace file.",
+            FFD_ERROR);
+    return 1;
+  }
+
+  return 0;
+} /* End of cosim_record_output()*/
+
+	/*
+		* Close the trace file
+		*
+		* @return No return needed
+		*/
+void cosim_record_close() {
+  if(file_record!=NULL) {
+    fclose(file_record);
+    file_record = NULL;
+  }
+  if(record_buffer!=NULL) {
+    free(record_buffer);
+    record_buffer = NULL;
+  }
+} /* End of cosim_record_close()*/
+
+	/*
+		* Read a string written by the trace writer
+		*
+		* @param f Pointer to the trace file
+		*
+		* @return Pointer to the allocated string, NULL if an error occurred
+		*/
+char *cosim_record_read_string(FILE *f) {
+  int n;
+  char *s;
+
+  if(fread(&n, sizeof(int), 1, f)!=1 || n<0) return NULL;
+
+  s = (char *) malloc((n+1)*sizeof(char));
+  if(s==NULL) return NULL;
+
+  if(n>0 && fread(s, sizeof(char), n, f)!=(size_t) n) {
+    free(s);
+    return NULL;
+  }
+  s[n] = '\0';
+
+  return s;
+} /* End of cosim_record_read_string()*/
+
+	/*
+		* Allocate a two dimensional array
+		*
+		* @param n1 Number of rows
+		* @param n2 Number of columns
+		*
+		* @return Pointer to the array, NULL if an error occurred
+		*/
+static REAL **allocate_2d(int n1, int n2) {
+  int i;
+  REAL **a = (REAL **) calloc(n1>0 ? n1 : 1, sizeof(REAL *));
+
+  if(a==NULL) return NULL;
+  for(i=0; i<n1; i++) {
+    a[i] = (REAL *) calloc(n2>0 ? n2 : 1, sizeof(REAL));
+    if(a[i]==NULL) return NULL;
+  }
+  return a;
+} /* End of allocate_2d()*/
+
+	/*
+		* Free a two dimensional array allocated by allocate_2d()
+		*
+		* @param a Pointer to the array
+		* @param n1 Number of rows
+		*
+		* @return No return needed
+		*/
+static void free_2d(REAL **a, int n1) {
+  int i;
+
+  if(a==NULL) return;
+  for(i=0; i<n1; i++)
+    if(a[i]!=NULL) free(a[i]);
+  free(a);
+} /* End of free_2d()*/
+
+	/*
+		* Allocate the data exchanged between Modelica and FFD
+		*
+		* @param cosim Pointer to the coupled simulation data with allocated
+		*        cosim->para, cosim->modelica and cosim->ffd
+		*
+		* @return 0 if no error occurred
+		*/
+int cosim_record_allocate_exchange(CosimulationData *cosim) {
+  ParameterSharedData *cp = cosim->para;
+  /* calloc(0) may return NULL, so allocate at least one element*/
+  int nSur = cp->nSur>0 ? cp->nSur : 1;
+  int nCon = cp->nConExtWin>0 ? cp->nConExtWin : 1;
+  int nPorts = cp->nPorts>0 ? cp->nPorts : 1;
+
+  cosim->modelica->temHea = (REAL *) calloc(nSur, sizeof(REAL));
+  cosim->modelica->shaConSig = (REAL *) calloc(nCon, sizeof(REAL));
+  cosim->modelica->shaAbsRad = (REAL *) calloc(nCon, sizeof(REAL));
+  cosim->modelica->mFloRatPor = (REAL *) calloc(nPorts, sizeof(REAL));
+  cosim->modelica->TPor = (REAL *) calloc(nPorts, sizeof(REAL));
+  cosim->modelica->XiPor = allocate_2d(cp->nPorts, cp->nXi);
+  cosim->modelica->CPor = allocate_2d(cp->nPorts, cp->nC);
+  cosim->ffd->temHea = (REAL *) calloc(nSur, sizeof(REAL));
+  cosim->ffd->TSha = (REAL *) calloc(nCon, sizeof(REAL));
+  cosim->ffd->TPor = (REAL *) calloc(nPorts, sizeof(REAL));
+  cosim->ffd->XiPor = allocate_2d(cp->nPorts, cp->nXi);
+  cosim->ffd->CPor = allocate_2d(cp->nPorts, cp->nC);
+  cosim->ffd->senVal = (REAL *) calloc(cp->nSen>0 ? cp->nSen : 1, sizeof(REAL));
+  cosim->ffd->msg = NULL;
+  if(cosim->modelica->temHea==NULL || cosim->modelica->shaConSig==NULL
+     || cosim->modelica->shaAbsRad==NULL || cosim->modelica->mFloRatPor==NULL
+     || cosim->modelica->TPor==NULL || cosim->modelica->XiPor==NULL
+     || cosim->modelica->CPor==NULL || cosim->ffd->temHea==NULL
+     || cosim->ffd->TSha==NULL || cosim->ffd->TPor==NULL
+     || cosim->ffd->XiPor==NULL || cosim->ffd->CPor==NULL
+     || cosim->ffd->senVal==NULL)
+    return 1;
+
+  return 0;
+} /* End of cosim_record_allocate_exchange()*/
+
+	/*
+		* Free the data allocated by cosim_record_allocate_exchange()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		*
+		* @return No return needed
+		*/
+void cosim_record_free_exchange(CosimulationData *cosim) {
+  int nPorts = cosim->para->nPorts;
+
+  free(cosim->modelica->temHea);
+  free(cosim->modelica->shaConSig);
+  free(cosim->modelica->shaAbsRad);
+  free(cosim->modelica->mFloRatPor);
+  free(cosim->modelica->TPor);
+  free_2d(cosim->modelica->XiPor, nPorts);
+  free_2d(cosim->modelica->CPor, nPorts);
+  free(cosim->ffd->temHea);
+  free(cosim->ffd->TSha);
+  free(cosim->ffd->TPor);
+  free_2d(cosim->ffd->XiPor, nPorts);
+  free_2d(cosim->ffd->CPor, nPorts);
+  free(cosim->ffd->senVal);
+} /* End of cosim_record_free_exchange()*/
+
+	/*
+		* Read the header of a trace file and allocate the coupled simulation data
+		*
+		* The memory is allocated in the same way as in cfdStartCosimulation().
+		*
+		* @param f Pointer to the trace file
+		* @param cosim Pointer to the coupled simulation data with allocated
+		*        cosim->para, cosim->modelica and cosim->ffd
+		*
+		* @return 0 if no error occurred
+		*/
+int cosim_record_read_header(FILE *f, CosimulationData *cosim) {
+  ParameterSharedData *cp = cosim->para;
+  char magic[8];
+  int header[9];
+  int i, nSur;
+
+  if(fread(magic, sizeof(char), 8, f)!=8
+     || strncmp(magic, COSIM_RECORD_MAGIC, 8)!=0)
+    return 1;
+  if(fread(header, sizeof(int), 9, f)!=9) return 1;
+  if(fread(&cp->rho_start, sizeof(REAL), 1, f)!=1) return 1;
+
+  cp->nSur = header[0];
+  cp->nSen = header[1];
+  cp->nConExtWin = header[2];
+  cp->nPorts = header[3];
+  cp->nXi = header[4];
+  cp->nC = header[5];
+  cp->sha = header[6];
+  if(header[7]!=cosim_record_nU(cp) || header[8]!=cosim_record_nY(cp))
+    return 1;
+
+  /* calloc(0) may return NULL, so allocate at least one element*/
+  nSur = cp->nSur>0 ? cp->nSur : 1;
+
+  if((cp->fileName = cosim_record_read_string(f))==NULL) return 1;
+
+  cp->name = (char **) calloc(nSur, sizeof(char *));
+  cp->portName = (char **) calloc(cp->nPorts>0 ? cp->nPorts : 1, sizeof(char *));
+  cp->sensorName = (char **) calloc(cp->nSen>0 ? cp->nSen : 1, sizeof(char *));
+  cp->are = (REAL *) calloc(nSur, sizeof(REAL));
+  cp->til = (REAL *) calloc(nSur, sizeof(REAL));
+  cp->bouCon = (int *) calloc(nSur, sizeof(int));
+  if(cp->name==NULL || cp->portName==NULL || cp->sensorName==NULL
+     || cp->are==NULL || cp->til==NULL || cp->bouCon==NULL)
+    return 1;
+
+  for(i=0; i<cp->nSur; i++)
+    if((cp->name[i] = cosim_record_read_string(f))==NULL) return 1;
+  for(i=0; i<cp->nPorts; i++)
+    if((cp->portName[i] = cosim_record_read_string(f))==NULL) return 1;
+  for(i=0; i<cp->nSen; i++)
+    if((cp->sensorName[i] = cosim_record_read_string(f))==NULL) return 1;
+
+  if(cp->nSur>0) {
+    if(fread(cp->are, sizeof(REAL), cp->nSur, f)!=(size_t) cp->nSur) return 1;
+    if(fread(cp->til, sizeof(REAL), cp->nSur, f)!=(size_t) cp->nSur) return 1;
+    if(fread(cp->bouCon, sizeof(int), cp->nSur, f)!=(size_t) cp->nSur) return 1;
+  }
+
+  return cosim_record_allocate_exchange(cosim);
+} /* End of cosim_record_read_header()*/
+
+	/*
+		* Free the data allocated by cosim_record_read_header()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		*
+		* @return No return needed
+		*/
+void cosim_record_free_header(CosimulationData *cosim) {
+  ParameterSharedData *cp = cosim->para;
+  int i;
+
+  cosim_record_free_exchange(cosim);
+  if(cp->name!=NULL)
+    for(i=0; i<cp->nSur; i++) free(cp->name[i]);
+  if(cp->portName!=NULL)
+    for(i=0; i<cp->nPorts; i++) free(cp->portName[i]);
+  if(cp->sensorName!=NULL)
+    for(i=0; i<cp->nSen; i++) free(cp->sensorName[i]);
+  free(cp->name);
+  free(cp->portName);
+  free(cp->sensorName);
+  free(cp->are);
+  free(cp->til);
+  free(cp->bouCon);
+  free(cp->fileName);
+} /* End of cosim_record_free_header()*/
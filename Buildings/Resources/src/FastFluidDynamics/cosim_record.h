@@ -0,0 +1,186 @@
+/*
+	*
+	* @file   cosim_record.h
+	*
+	* @brief  Record the data exchanged with Modelica to a binary trace file
+	*
+	* @author agent
+	*
+	* @date   10/19/2026
+	*
+	* This file provides functions that write and read a compact binary trace
+	* of the coupled simulation. The trace stores the parameters received from
+	* cfdStartCosimulation(), each input vector u[] with t0 and dt received from
+	* cfdExchangeData() and each output vector y[] returned to Modelica.
+	* The trace can be replayed with ffd_replay without a Modelica tool.
+	*
+	* Layout of the trace file (native byte order):
+	*   Header:  char[8] COSIM_RECORD_MAGIC
+	*            int nSur, nSen, nConExtWin, nPorts, nXi, nC, sha, nU, nY
+	*            REAL rho_start
+	*            string fileName, name[nSur], portName[nPorts], sensorName[nSen]
+	*            REAL are[nSur], til[nSur]
+	*            int bouCon[nSur]
+	*   Records: int COSIM_RECORD_INPUT,  REAL t0, REAL dt, REAL u[nU]
+	*            int COSIM_RECORD_OUTPUT, REAL t1, REAL y[nY]
+	* A string is stored as an int length followed by the characters without
+	* the terminating zero.
+	*
+	*/
+#ifndef _COSIM_RECORD_H
+#define _COSIM_RECORD_H
+#endif
+
+#ifndef _DATA_STRUCTURE_H
+#define _DATA_STRUCTURE_H
+#include "data_structure.h"
+#endif
+
+#ifndef _UTILITY_H
+#define _UTILITY_H
+#include "utility.h"
+#endif
+
+#define COSIM_RECORD_MAGIC "FFDREC01"
+#define COSIM_RECORD_INPUT 1
+#define COSIM_RECORD_OUTPUT 2
+
+/*
+	* Get the length of the input vector u[] of cfdExchangeData()
+	*
+	* @param cosimPara Pointer to the coupled simulation parameters
+	*
+	* @return Number of inputs
+	*/
+int cosim_record_nU(ParameterSharedData *cosimPara);
+
+/*
+	* Get the length of the output vector y[] of cfdExchangeData()
+	*
+	* @param cosimPara Pointer to the coupled simulation parameters
+	*
+	* @return Number of outputs
+	*/
+int cosim_record_nY(ParameterSharedData *cosimPara);
+
+/*
+	* Pack the Modelica data into the input vector in the order of cfdExchangeData()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	* @param u Pointer to the input vector
+	*
+	* @return No return needed
+	*/
+void cosim_record_pack_input(CosimulationData *cosim, REAL *u);
+
+/*
+	* Unpack the input vector into the Modelica data in the order of cfdExchangeData()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	* @param u Pointer to the input vector
+	*
+	* @return No return needed
+	*/
+void cosim_record_unpack_input(CosimulationData *cosim, REAL *u);
+
+/*
+	* Pack the FFD data into the output vector in the order of cfdExchangeData()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	* @param y Pointer to the output vector
+	*
+	* @return No return needed
+	*/
+void cosim_record_pack_output(CosimulationData *cosim, REAL *y);
+
+/*
+	* Unpack the output vector into the FFD data in the order of cfdExchangeData()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	* @param y Pointer to the output vector
+	*
+	* @return No return needed
+	*/
+void cosim_record_unpack_output(CosimulationData *cosim, REAL *y);
+
+/*
+	* Open the trace file and write the coupled simulation parameters
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return 0 if no error occurred
+	*/
+int cosim_record_open(PARA_DATA *para);
+
+/*
+	* Write the data received from Modelica to the trace file
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return 0 if no error occurred
+	*/
+int cosim_record_input(PARA_DATA *para);
+
+/*
+	* Write the data sent to Modelica to the trace file
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return 0 if no error occurred
+	*/
+int cosim_record_output(PARA_DATA *para);
+
+/*
+	* Close the trace file
+	*
+	* @return No return needed
+	*/
+void cosim_record_close();
+
+/*
+	* Read a string written by the trace writer
+	*
+	* @param f Pointer to the trace file
+	*
+	* @return Pointer to the allocated string, NULL if an error occurred
+	*/
+char *cosim_record_read_string(FILE *f);
+
+/*
+	* Allocate the data exchanged between Modelica and FFD
+	*
+	* @param cosim Pointer to the coupled simulation data with allocated
+	*        cosim->para, cosim->modelica and cosim->ffd
+	*
+	* @return 0 if no error occurred
+	*/
+int cosim_record_allocate_exchange(CosimulationData *cosim);
+
+/*
+	* Free the data allocated by cosim_record_allocate_exchange()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	*
+	* @return No return needed
+	*/
+void cosim_record_free_exchange(CosimulationData *cosim);
+
+/*
+	* Read the header of a trace file and allocate the coupled simulation data
+	*
+	* @param f Pointer to the trace file
+	* @param cosim Pointer to the coupled simulation data with allocated
+	*        cosim->para, cosim->modelica and cosim->ffd
+	*
+	* @return 0 if no error occurred
+	*/
+int cosim_record_read_header(FILE *f, CosimulationData *cosim);
+
+/*
+	* Free the data allocated by cosim_record_read_header()
+	*
+	* @param cosim Pointer to the coupled simulation data
+	*
+	* @return No return needed
+	*/
+void cosim_record_free_header(CosimulationData *cosim);
@@ -209,6 +209,17 @@ int read_cosim_parameter(PARA_DATA *para, REAL **var, int **BINDEX) {
     ffd_log(msg, FFD_NORMAL);
   }
 
+  /****************************************************************************
+  | Start recording the coupled simulation if a trace file is specified
+  ****************************************************************************/
+  if(para->inpu->record_file_name[0]!='\0') {
+    if(cosim_record_open(para)!=0) {
+      ffd_log("read_cosim_parameter(): Could not open the trace file.",
+              FFD_ERROR);
+      return 1;
+    }
+  }
+
   return 0;
 } /* End of read_cosim_parameter()*/
 
@@ -259,6 +270,15 @@ int read_cosim_data(PARA_DATA *para, REAL **var, int **BINDEX) {
     ffd_log(msg, FFD_NORMAL);
   }
 
+  /****************************************************************************
+  | Record the data if the coupled simulation is recorded
+  ****************************************************************************/
+  if(cosim_record_input(para)!=0) {
+    ffd_log("read_cosim_data(): Could not record the Modelica data.",
+            FFD_ERROR);
+    return 1;
+  }
+
   /****************************************************************************
   | Read and assign the thermal boundary conditions
   ****************************************************************************/
@@ -465,6 +485,14 @@ int write_cosim_data(PARA_DATA *para, REAL **var) {
     ffd_log(msg, FFD_NORMAL);
   }
 
+  /****************************************************************************
+  | Record the data if the coupled simulation is recorded
+  ****************************************************************************/
+  if(cosim_record_output(para)!=0) {
+    ffd_log("write_cosim_data(): Could not record the FFD data.", FFD_ERROR);
+    return 1;
+  }
+
   /****************************************************************************
   | Inform Modelica that the FFD data is updated
   ****************************************************************************/
@@ -33,6 +33,11 @@
 #include "geometry.h"
 #endif
 
+#ifndef _COSIM_RECORD_H
+#define _COSIM_RECORD_H
+#include "cosim_record.h"
+#endif
+
 #ifndef _MSC_VER /*Linux*/
 #define Sleep(x) sleep(x/1000)
 #endif
@@ -125,7 +125,8 @@ Place the stdlib.h line above the glut.h line in the code.
 #define C1S 52
 #define C2S 53
 #define C1BC 54
-#define C2BC 55  /* Last variable*/
+#define C2BC 55
+#define DTL 56  /* Local pseudo time step for the steady state simulation; Last variable*/
 
 typedef enum{NOSLIP, SLIP, INFLOW, OUTFLOW, PERIODIC, SYMMETRY} BCTYPE;
 
@@ -202,6 +203,7 @@ typedef struct{
   char block_file_name[1024]; /* Name of file stores block information*/
   int read_old_ffd_file; /* 1: Read previous FFD file; 0: False*/
   char old_ffd_file_name[100]; /* Name of previous FFD simulation data file*/
+  char record_file_name[1024]; /* Name of trace file for recording the coupled simulation; empty: no recording*/
 } INPU_DATA;
 
 typedef struct{
@@ -297,6 +299,14 @@ typedef struct {
   INTERPOLATION interpolation; /* Interpolation in semi-Lagrangian method: BILINEAR, FSJ, HYBRID*/
   int cosimulation;  /* 0: single; 1: coupled simulation*/
   int nextstep; /* Internal: 1: yes; 0: no, wait*/
+  int steady; /* 1: solve for the steady state with local pseudo time steps; 0: transient simulation*/
+  REAL steady_cfl; /* Courant number of the local pseudo time steps*/
+  REAL steady_dt_ratio; /* Maximum ratio of the local pseudo time step to mytime.dt*/
+  REAL steady_tol; /* Tolerance of the residuals and the boundary integrals for the steady state*/
+  int steady_itmax; /* Maximum number of iterations for the steady state*/
+  REAL relax_p; /* Under-relaxation factor of the projected velocity for the steady state*/
+  REAL residual; /* Internal: maximum residual of the momentum and scalar equations in the current step*/
+  REAL residual_p; /* Internal: residual of the pressure equation in the current step*/
 }SOLV_DATA;
 
 typedef struct {
@@ -304,6 +314,7 @@ typedef struct {
   REAL u; /* Initial velocity for u*/
   REAL v; /* Initial velocity for v*/
   REAL w; /* Initial velocity for w*/
+  int coarsen; /* Coarsening factor of the mesh for the initialization: 1: no coarsening; 2 or 4*/
 }INIT_DATA;
 
 typedef struct {
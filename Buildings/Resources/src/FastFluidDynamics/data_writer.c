@@ -79,7 +79,7 @@ int write_tecplot_data(PARA_DATA *para, REAL **var, char *name) {
        x[IX(i,j,k)], y[IX(i,j,k)], z[IX(i,j,k)], i, j, k);
     fprintf(datafile, "%f\t%f\t%f\t%f\t%f\t%f\t%f\n",
             u[IX(i,j,k)], v[IX(i,j,k)], w[IX(i,j,k)], T[IX(i,j,k)],
-            Xi[IX(i,j,k)], flagp[IX(i,j,k)], p[IX(i,j,k)]);
+            Xi!=NULL ? Xi[IX(i,j,k)] : 0, flagp[IX(i,j,k)], p[IX(i,j,k)]);
   END_FOR
 
   sprintf(msg, "write_tecplot_data(): Wrote file %s.", filename);
@@ -231,30 +231,36 @@ void convert_to_tecplot(PARA_DATA *para, REAL **var) {
   for(j=0; j<=jmax+1; j++)
     for(k=0; k<=kmax+1; k++) {
       u[IX(imax+1,j,k)] = u[IX(imax,j,k)];
-      um[IX(imax+1,j,k)] = um[IX(imax,j,k)];
+      if(um!=NULL)
+        um[IX(imax+1,j,k)] = um[IX(imax,j,k)];
       for(i=imax; i>=1; i--) {
         u[IX(i,j,k)] = (REAL) (0.5 * (u[IX(i,j,k)]+u[IX(i-1,j,k)]));
-        um[IX(i,j,k)] = (REAL) (0.5 * (um[IX(i,j,k)]+um[IX(i-1,j,k)]));
+        if(um!=NULL)
+          um[IX(i,j,k)] = (REAL) (0.5 * (um[IX(i,j,k)]+um[IX(i-1,j,k)]));
       }
     }
 
   for(i=0; i<=imax+1; i++)
     for(k=0; k<=kmax+1; k++) {
       v[IX(i,jmax+1,k)] = v[IX(i,jmax,k)];
-      vm[IX(i,jmax+1,k)] = vm[IX(i,jmax,k)];
+      if(vm!=NULL)
+        vm[IX(i,jmax+1,k)] = vm[IX(i,jmax,k)];
       for(j=jmax; j>=1; j--) {
         v[IX(i,j,k)] = (REAL) (0.5 * (v[IX(i,j,k)]+v[IX(i,j-1,k)]));
-        vm[IX(i,j,k)] = (REAL) (0.5 * (vm[IX(i,j,k)]+vm[IX(i,j-1,k)]));
+        if(vm!=NULL)
+          vm[IX(i,j,k)] = (REAL) (0.5 * (vm[IX(i,j,k)]+vm[IX(i,j-1,k)]));
       }
     }
 
   for(i=0; i<=imax+1; i++)
     for(j=0; j<=jmax+1; j++) {
       w[IX(i,j,kmax+1)] = w[IX(i,j,kmax)];
-      wm[IX(i,j,kmax+1)] = wm[IX(i,j,kmax)];
+      if(wm!=NULL)
+        wm[IX(i,j,kmax+1)] = wm[IX(i,j,kmax)];
       for(k=kmax; k>=1; k--) {
         w[IX(i,j,k)] = (REAL) (0.5 * (w[IX(i,j,k)]+w[IX(i,j,k-1)]));
-        wm[IX(i,j,k)] = (REAL) (0.5 * (wm[IX(i,j,k)]+wm[IX(i,j,k-1)]));
+        if(wm!=NULL)
+          wm[IX(i,j,k)] = (REAL) (0.5 * (wm[IX(i,j,k)]+wm[IX(i,j,k-1)]));
       }
     }
 
@@ -262,9 +268,9 @@ void convert_to_tecplot(PARA_DATA *para, REAL **var) {
   | Convert variables at corners
   ****************************************************************************/
   convert_to_tecplot_corners(para, var, p);
-  convert_to_tecplot_corners(para, var, d);
+  if(d!=NULL) convert_to_tecplot_corners(para, var, d);
   convert_to_tecplot_corners(para, var, T);
-  convert_to_tecplot_corners(para, var, Tm);
+  if(Tm!=NULL) convert_to_tecplot_corners(para, var, Tm);
 } /* End of convert_to_tecplot()*/
 
 	/*
@@ -353,7 +359,8 @@ int write_unsteady(PARA_DATA *para, REAL **var, char *name){
 
   FOR_ALL_CELL
     fprintf( datafile, "%f\t%f\t%f\t",u[IX(i,j,k)], v[IX(i,j,k)], w[IX(i,j,k)]);
-    fprintf( datafile, "%f\t%f\t%f\n",T[IX(i,j,k)], d[IX(i,j,k)], p[IX(i,j,k)]);
+    fprintf( datafile, "%f\t%f\t%f\n",T[IX(i,j,k)],
+             d!=NULL ? d[IX(i,j,k)] : 0, p[IX(i,j,k)]);
   END_FOR
 
   sprintf(msg, "write_unsteady(): Wrote the unsteady data file %s.", filename);
@@ -432,10 +439,12 @@ int write_SCI(PARA_DATA *para, REAL **var, char *name) {
   for(j=0; j<=jmax+1; j++) {
     for(k=0; k<=kmax+1; k++) {
       u[IX(imax+1,j,k)] = u[IX(imax,j,k)];
-      um[IX(imax+1,j,k)] = um[IX(imax,j,k)];
+      if(um!=NULL)
+        um[IX(imax+1,j,k)] = um[IX(imax,j,k)];
       for(i=imax; i>=1; i--) {
         u[IX(i,j,k)] = (REAL) 0.5 * (u[IX(i,j,k)]+u[IX(i-1,j,k)]);
-        um[IX(i,j,k)] = (REAL) 0.5 * (um[IX(i,j,k)]+um[IX(i-1,j,k)]);
+        if(um!=NULL)
+          um[IX(i,j,k)] = (REAL) 0.5 * (um[IX(i,j,k)]+um[IX(i-1,j,k)]);
       }
     }
   }
@@ -443,10 +452,12 @@ int write_SCI(PARA_DATA *para, REAL **var, char *name) {
   for(i=0; i<=imax+1; i++) {
     for(k=0; k<=kmax+1; k++) {
       v[IX(i,jmax+1,k)] = v[IX(i,jmax,k)];
-      vm[IX(i,jmax+1,k)] = vm[IX(i,jmax,k)];
+      if(vm!=NULL)
+        vm[IX(i,jmax+1,k)] = vm[IX(i,jmax,k)];
       for(j=jmax; j>=1; j--) {
           v[IX(i,j,k)] = (REAL) 0.5 * (v[IX(i,j,k)]+v[IX(i,j-1,k)]);
-          vm[IX(i,j,k)] = (REAL) 0.5 * (vm[IX(i,j,k)]+vm[IX(i,j-1,k)]);
+          if(vm!=NULL)
+            vm[IX(i,j,k)] = (REAL) 0.5 * (vm[IX(i,j,k)]+vm[IX(i,j-1,k)]);
         }
     }
   }
@@ -454,10 +465,12 @@ int write_SCI(PARA_DATA *para, REAL **var, char *name) {
   for(i=0; i<=imax+1; i++) {
     for(j=0; j<=jmax+1; j++) {
       w[IX(i,j,kmax+1)] = w[IX(i,j,kmax)];
-      wm[IX(i,j,kmax+1)] = wm[IX(i,j,kmax)];
+      if(wm!=NULL)
+        wm[IX(i,j,kmax+1)] = wm[IX(i,j,kmax)];
       for(k=kmax; k>=1; k--) {
         w[IX(i,j,k)] = (REAL) 0.5 * (w[IX(i,j,k)]+w[IX(i,j,k-1)]);
-        wm[IX(i,j,k)] = (REAL) 0.5 * (wm[IX(i,j,k)]+wm[IX(i,j,k-1)]);
+        if(wm!=NULL)
+          wm[IX(i,j,k)] = (REAL) 0.5 * (wm[IX(i,j,k)]+wm[IX(i,j,k-1)]);
       }
     }
   }
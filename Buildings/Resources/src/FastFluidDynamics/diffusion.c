@@ -90,6 +90,7 @@ int diffusion(PARA_DATA *para, REAL **var, int var_type, int index,
         sprintf(msg, "diffusion(): Residual of Specie %d is %f",
                 index, check_residual(para, var, psi));
         ffd_log(msg, FFD_NORMAL);
+        break;
       default:
         sprintf(msg, "diffusion(): No solver for variable type %d",
                 var_type);
@@ -164,6 +165,8 @@ int coef_diff(PARA_DATA *para, REAL **var, REAL *psi, REAL *psi0,
         as[IX(i,j,k)] = kapa*Dx*Dz/dys;
         af[IX(i,j,k)] = kapa*Dx*Dy/dzf;
         ab[IX(i,j,k)] = kapa*Dx*Dy/dzb;
+        if(para->solv->steady==1)
+          dt = local_time_step(para, var, VX, i, j, k);
         ap0[IX(i,j,k)] = Dx*Dy*Dz/dt;
         b[IX(i,j,k)] = psi0[IX(i,j,k)]*ap0[IX(i,j,k)]
                      - beta*gravx*(Temp[IX(i,j,k)]-Temp_Buoyancy)*Dx*Dy*Dz
@@ -206,6 +209,8 @@ int coef_diff(PARA_DATA *para, REAL **var, REAL *psi, REAL *psi0,
         as[IX(i,j,k)] = kapa*Dx*Dz/dys;
         af[IX(i,j,k)] = kapa*Dx*Dy/dzf;
         ab[IX(i,j,k)] = kapa*Dx*Dy/dzb;
+        if(para->solv->steady==1)
+          dt = local_time_step(para, var, VY, i, j, k);
         ap0[IX(i,j,k)] = Dx*Dy*Dz/dt;
         b[IX(i,j,k)] = psi0[IX(i,j,k)]*ap0[IX(i,j,k)]
                      - beta*gravy*(Temp[IX(i,j,k)]-Temp_Buoyancy)*Dx*Dy*Dz
@@ -248,6 +253,8 @@ int coef_diff(PARA_DATA *para, REAL **var, REAL *psi, REAL *psi0,
         as[IX(i,j,k)] = kapa*Dx*Dz/dys;
         af[IX(i,j,k)] = kapa*Dx*Dy/dzf;
         ab[IX(i,j,k)] = kapa*Dx*Dy/dzb;
+        if(para->solv->steady==1)
+          dt = local_time_step(para, var, VZ, i, j, k);
         ap0[IX(i,j,k)] = Dx*Dy*Dz/dt;
         b[IX(i,j,k)] = psi0[IX(i,j,k)]*ap0[IX(i,j,k)]
                      - beta*gravz*(Temp[IX(i,j,k)]-Temp_Buoyancy)*Dx*Dy*Dz
@@ -295,6 +302,8 @@ int coef_diff(PARA_DATA *para, REAL **var, REAL *psi, REAL *psi0,
         as[IX(i,j,k)] = kapa*Dx*Dz/dys;
         af[IX(i,j,k)] = kapa*Dx*Dy/dzf;
         ab[IX(i,j,k)] = kapa*Dx*Dy/dzb;
+        if(para->solv->steady==1)
+          dt = local_time_step(para, var, var_type, i, j, k);
         ap0[IX(i,j,k)] = Dx*Dy*Dz/dt;
         b[IX(i,j,k)] = psi0[IX(i,j,k)]*ap0[IX(i,j,k)];
       END_FOR
@@ -338,13 +347,13 @@ int source_diff(PARA_DATA *para, REAL **var, int var_type, int index) {
   FOR_EACH_CELL
     switch(var_type) {
       case VX:
-        b[IX(i,j,k)] += var[VXS][IX(i,j,k)];
+        if(var[VXS]!=NULL) b[IX(i,j,k)] += var[VXS][IX(i,j,k)];
         break;
       case VY:
-        b[IX(i,j,k)] += var[VYS][IX(i,j,k)];
+        if(var[VYS]!=NULL) b[IX(i,j,k)] += var[VYS][IX(i,j,k)];
         break;
       case VZ:
-        b[IX(i,j,k)] += var[VZS][IX(i,j,k)];
+        if(var[VZS]!=NULL) b[IX(i,j,k)] += var[VZS][IX(i,j,k)];
         break;
       case TEMP:
         b[IX(i,j,k)] += var[TEMPS][IX(i,j,k)]/(para->prob->rho*para->prob->Cp);
@@ -46,6 +46,11 @@
 #include "chen_zero_equ_model.h"
 #endif
 
+#ifndef _STEADY_H
+#define _STEADY_H
+#include "steady.h"
+#endif
+
 /*
 	* Entrance of calculating diffusion equation
 	*
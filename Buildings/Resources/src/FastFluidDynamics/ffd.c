@@ -35,62 +35,167 @@ static INIT_DATA init;
 clock_t start, end;
 
 /*
-	* Allcoate memory for variables
+	* Check if a simulation variable is used with the given parameters
+	*
+	* The species and trace substances are only used up to bc.nb_Xi and
+	* bc.nb_C. The time averaged data is used by the coupled simulation,
+	* while the single simulation allocates it once it starts to calculate
+	* the mean values. The local pseudo time step is only used for the
+	* steady state. The source terms of the velocities and the local extrema
+	* of the advection are not used but written by write_tecplot_all_data().
 	*
 	* @param para Pointer to FFD parameters
+	* @param var_type Type of variable
 	*
-	* @return No return needed
+	* @return 1 if the variable is used, 0 if not
 	*/
-int allocate_memory (PARA_DATA *para) {
+int var_required(PARA_DATA *para, int var_type) {
+  /* write_tecplot_all_data() writes all the variables*/
+  if(para->outp->version==DEBUG) return 1;
 
-  int nb_var, i;
-  int size = (geom.imax+2) * (geom.jmax+2) * (geom.kmax+2);
+  switch(var_type) {
+    case Xi1:
+    case Xi1S:
+    case Xi1BC:
+      return para->bc->nb_Xi>0 ? 1 : 0;
+    case Xi2:
+    case Xi2S:
+    case Xi2BC:
+      return para->bc->nb_Xi>1 ? 1 : 0;
+    case C1:
+    case C1S:
+    case C1BC:
+      return para->bc->nb_C>0 ? 1 : 0;
+    case C2:
+    case C2S:
+    case C2BC:
+      return para->bc->nb_C>1 ? 1 : 0;
+    case VXM:
+    case VYM:
+    case VZM:
+    case TEMPM:
+      return para->solv->cosimulation==1 || para->outp->cal_mean==1 ? 1 : 0;
+    case DTL:
+      return para->solv->steady==1 ? 1 : 0;
+    case VXS:
+    case VYS:
+    case VZS:
+    case LOCMIN:
+    case LOCMAX:
+      return 0;
+    default:
+      return 1;
+  }
+} /* End of var_required()*/
 
-  /****************************************************************************
-  | Allocate memory for variables
-  ****************************************************************************/
-  nb_var = C2BC+1;
-  var       = (REAL **) malloc ( nb_var*sizeof(REAL*) );
-  if(var==NULL) {
-    ffd_log("allocate_memory(): Could not allocate memory for var.",
+/*
+	* Allocate memory for the simulation variables
+	*
+	* The variables that are not used with the given parameters are set to NULL.
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return Pointer to the variables, NULL if an error occurred
+	*/
+REAL **allocate_var(PARA_DATA *para) {
+  REAL **v;
+  int nb_var, i, nb_allocated = 0;
+  int size = (para->geom->imax+2) * (para->geom->jmax+2)
+           * (para->geom->kmax+2);
+
+  nb_var = DTL+1;
+  v = (REAL **) malloc ( nb_var*sizeof(REAL*) );
+  if(v==NULL) {
+    ffd_log("allocate_var(): Could not allocate memory for var.",
             FFD_ERROR);
-    return 1;
+    return NULL;
   }
 
   for(i=0; i<nb_var; i++) {
-    var[i] = (REAL *) calloc(size, sizeof(REAL));
-    if(var[i]==NULL) {
+    if(var_required(para, i)==0) {
+      v[i] = NULL;
+      continue;
+    }
+    v[i] = (REAL *) calloc(size, sizeof(REAL));
+    if(v[i]==NULL) {
       sprintf(msg,
-              "allocate_memory(): Could not allocate memory for var[%d]", i);
+              "allocate_var(): Could not allocate memory for var[%d]", i);
       ffd_log(msg, FFD_ERROR);
-      return 1;
+      return NULL;
     }
+    nb_allocated++;
   }
 
-  /****************************************************************************
-  | Allocate memory for boundary cells
-  | BINDEX[0]: i of global coordinate in IX(i,j,k)
-  | BINDEX[1]: j of global coordinate in IX(i,j,k)
-  | BINDEX[2]: k of global coordinate in IX(i,j,k)
-  | BINDEX[3]: Fixed temperature or fixed heat flux
-  | BINDEX[4]: Boundary ID to identify which boundary it belongs to
-  ****************************************************************************/
-  BINDEX = (int **)malloc(5*sizeof(int*));
-  if(BINDEX==NULL) {
-    ffd_log("allocate_memory(): Could not allocate memory for BINDEX.",
+  sprintf(msg, "allocate_var(): Allocated %d of %d variables with %d cells "
+          "(%.2f MB).", nb_allocated, nb_var, size,
+          (double) nb_allocated * size * sizeof(REAL) / 1048576.0);
+  ffd_log(msg, FFD_NORMAL);
+
+  return v;
+} /* End of allocate_var()*/
+
+/*
+	* Allocate memory for the boundary cell index
+	*
+	* The index is allocated for all the cells since the number of boundary
+	* cells is only known after reading the input files. It is reduced to
+	* geom.index by resize_index() afterwards.
+	*
+	* BINDEX[0]: i of global coordinate in IX(i,j,k)
+	* BINDEX[1]: j of global coordinate in IX(i,j,k)
+	* BINDEX[2]: k of global coordinate in IX(i,j,k)
+	* BINDEX[3]: Fixed temperature or fixed heat flux
+	* BINDEX[4]: Boundary ID to identify which boundary it belongs to
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return Pointer to the index, NULL if an error occurred
+	*/
+int **allocate_index(PARA_DATA *para) {
+  int **b;
+  int i;
+  int size = (para->geom->imax+2) * (para->geom->jmax+2)
+           * (para->geom->kmax+2);
+
+  b = (int **)malloc(5*sizeof(int*));
+  if(b==NULL) {
+    ffd_log("allocate_index(): Could not allocate memory for BINDEX.",
             FFD_ERROR);
-    return 1;
+    return NULL;
   }
 
   for(i=0; i<5; i++) {
-    BINDEX[i] = (int *) malloc(size*sizeof(int));
-    if(BINDEX[i]==NULL) {
+    b[i] = (int *) malloc(size*sizeof(int));
+    if(b[i]==NULL) {
       sprintf(msg,
-              "allocate_memory(): Could not allocate memory for BINDEX[%d]", i);
+              "allocate_index(): Could not allocate memory for BINDEX[%d]", i);
       ffd_log(msg, FFD_ERROR);
-      return 1;
+      return NULL;
     }
   }
+  return b;
+} /* End of allocate_index()*/
+
+/*
+	* Allcoate memory for variables
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return No return needed
+	*/
+int allocate_memory (PARA_DATA *para) {
+  /****************************************************************************
+  | Allocate memory for variables
+  ****************************************************************************/
+  var = allocate_var(para);
+  if(var==NULL) return 1;
+
+  /****************************************************************************
+  | Allocate memory for boundary cells
+  ****************************************************************************/
+  BINDEX = allocate_index(para);
+  if(BINDEX==NULL) return 1;
+
   return 0;
 } /* End of allocate_memory()*/
 
@@ -208,6 +313,9 @@ int ffd(int cosimulation) {
   /* Write the data in SCI format*/
   write_SCI(&para, var, "output");
 
+  /* Close the trace file if the coupled simulation was recorded*/
+  cosim_record_close();
+
   /* Free the memory*/
   free_data(var);
   free_index(BINDEX);
@@ -229,6 +337,9 @@ int ffd(int cosimulation) {
 		* @return no return
 		*/
 void modelicaError(char *msg) {
+  /* No Modelica is attached if FFD runs through the step API in ffd_context.c*/
+  if(para.cosim==NULL) return;
+
 	/*Allocate memory for cosim->ffd->msg*/
 	para.cosim->ffd->msg = (char *) malloc(400*sizeof(char));
   if (para.cosim->ffd->msg == NULL){
@@ -48,6 +48,11 @@
 #include "data_writer.h"
 #endif
 
+#ifndef _COSIM_RECORD_H
+#define _COSIM_RECORD_H
+#include "cosim_record.h"
+#endif
+
 #ifndef _INITIALIZATION_H
 #define _INITIALIZATION_H
 #include "initialization.h"
@@ -71,6 +76,34 @@ int ffd_cosimulation(CosimulationData *cosim);
 	*/
 int ffd(int cosimulation);
 
+/*
+	* Check if a simulation variable is used with the given parameters
+	*
+	* @param para Pointer to FFD parameters
+	* @param var_type Type of variable
+	*
+	* @return 1 if the variable is used, 0 if not
+	*/
+int var_required(PARA_DATA *para, int var_type);
+
+/*
+	* Allocate memory for the simulation variables
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return Pointer to the variables, NULL if an error occurred
+	*/
+REAL **allocate_var(PARA_DATA *para);
+
+/*
+	* Allocate memory for the boundary cell index
+	*
+	* @param para Pointer to FFD parameters
+	*
+	* @return Pointer to the index, NULL if an error occurred
+	*/
+int **allocate_index(PARA_DATA *para);
+
 /*
 	* Allocate memory for variables
 	*
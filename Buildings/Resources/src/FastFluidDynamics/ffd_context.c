@@ -0,0 +1,453 @@
+/*
+	*
+	* \file   ffd_context.c
+	*
+	* \brief  Synchronous step interface to embed FFD in other programs
+	*
+	* \author agent
+	*
+	* \date   10/19/2026
+	*
+	* This file provides functions to run FFD on the thread of the caller.
+	* The functions reuse read_cosim_data() and write_cosim_data() with the
+	* flags of the exchange data set such that they never wait, so that a step
+	* performs exactly the same operations as FFD_solver() does between two
+	* synchronization points of a coupled simulation.
+	*
+	*/
+
+#include "ffd_context.h"
+
+	/*
+		* Get the number of cells including the ghost cells
+		*
+		* @param ctx Pointer to the context
+		*
+		* @return Number of cells
+		*/
+static int context_size(FFD_CONTEXT *ctx) {
+  return (ctx->geom.imax+2) * (ctx->geom.jmax+2) * (ctx->geom.kmax+2);
+} /* End of context_size()*/
+
+	/*
+		* Get the number of time averaged boundary and sensor values
+		*
+		* @param ctx Pointer to the context
+		*
+		* @return Number of values
+		*/
+static int context_nMean(FFD_CONTEXT *ctx) {
+  return ctx->bc.nb_wall + 1 + ctx->sens.nb_sensor
+       + ctx->bc.nb_port*(2 + ctx->bc.nb_Xi + ctx->bc.nb_C);
+} /* End of context_nMean()*/
+
+	/*
+		* Copy the time averaged boundary and sensor values from or to a buffer
+		*
+		* @param ctx Pointer to the context
+		* @param buf Pointer to the buffer
+		* @param save 1: Copy from the context to buf; 0: Copy from buf to the context
+		*
+		* @return No return needed
+		*/
+static void context_copy_mean(FFD_CONTEXT *ctx, REAL *buf, int save) {
+  BC_DATA *bc = &ctx->bc;
+  REAL *dat[4];
+  int n[4];
+  int i, j, k, l = 0;
+
+  dat[0] = bc->temHeaMean; n[0] = bc->nb_wall;
+  dat[1] = bc->TPortMean; n[1] = bc->nb_port;
+  dat[2] = bc->velPortMean; n[2] = bc->nb_port;
+  dat[3] = ctx->sens.senValMean; n[3] = ctx->sens.nb_sensor;
+
+  for(k=0; k<4; k++)
+    for(i=0; i<n[k]; i++, l++) {
+      if(save==1) buf[l] = dat[k][i];
+      else dat[k][i] = buf[l];
+    }
+
+  for(i=0; i<bc->nb_port; i++) {
+    for(j=0; j<bc->nb_Xi; j++, l++) {
+      if(save==1) buf[l] = bc->XiPortMean[i][j];
+      else bc->XiPortMean[i][j] = buf[l];
+    }
+    for(j=0; j<bc->nb_C; j++, l++) {
+      if(save==1) buf[l] = bc->CPortMean[i][j];
+      else bc->CPortMean[i][j] = buf[l];
+    }
+  }
+
+  if(save==1) buf[l] = ctx->sens.TRooMean;
+  else ctx->sens.TRooMean = buf[l];
+} /* End of context_copy_mean()*/
+
+	/*
+		* Create an FFD instance and initialize it with the inputs u0
+		*
+		* The initialization is the same as in ffd() for a coupled simulation.
+		*
+		* @param cosimPara Pointer to the coupled simulation parameters as set by
+		*        cfdStartCosimulation(). The data must stay valid until the
+		*        context is freed.
+		* @param u0 Pointer to the initial input vector
+		*
+		* @return Pointer to the context, NULL if an error occurred
+		*/
+FFD_CONTEXT *ffd_context_create(ParameterSharedData *cosimPara, REAL *u0) {
+  FFD_CONTEXT *ctx;
+
+  ctx = (FFD_CONTEXT *) calloc(1, sizeof(FFD_CONTEXT));
+  if(ctx==NULL) {
+    ffd_log("ffd_context_create(): Could not allocate memory for the context.",
+            FFD_ERROR);
+    return NULL;
+  }
+
+  ctx->para.geom = &ctx->geom;
+  ctx->para.inpu = &ctx->inpu;
+  ctx->para.outp = &ctx->outp;
+  ctx->para.prob = &ctx->prob;
+  ctx->para.mytime = &ctx->mytime;
+  ctx->para.bc = &ctx->bc;
+  ctx->para.solv = &ctx->solv;
+  ctx->para.sens = &ctx->sens;
+  ctx->para.init = &ctx->init;
+  ctx->para.cosim = &ctx->cosim;
+  ctx->cosim.para = cosimPara;
+  ctx->cosim.modelica = &ctx->modelica;
+  ctx->cosim.ffd = &ctx->ffd;
+  /* The step interface uses the data exchange of the coupled simulation*/
+  ctx->solv.cosimulation = 1;
+
+  ctx->nU = cosim_record_nU(cosimPara);
+  ctx->nY = cosim_record_nY(cosimPara);
+
+  if(cosim_record_allocate_exchange(&ctx->cosim)!=0) {
+    ffd_log("ffd_context_create(): Could not allocate memory for the "
+            "exchange data.", FFD_ERROR);
+    ffd_context_free(ctx);
+    return NULL;
+  }
+
+  cosimPara->flag = 1;
+  cosimPara->ffdError = 0;
+
+  if(initialize(&ctx->para)!=0) {
+    ffd_log("ffd_context_create(): Could not initialize simulation parameters.",
+            FFD_ERROR);
+    ffd_context_free(ctx);
+    return NULL;
+  }
+
+  /* Overwrite the mesh and simulation data using SCI generated file*/
+  if(ctx->inpu.parameter_file_format == SCI) {
+    if(read_sci_max(&ctx->para, ctx->var)!=0) {
+      ffd_log("ffd_context_create(): Could not read SCI data.", FFD_ERROR);
+      ffd_context_free(ctx);
+      return NULL;
+    }
+  }
+
+  ctx->var = allocate_var(&ctx->para);
+  ctx->BINDEX = allocate_index(&ctx->para);
+  if(ctx->var==NULL || ctx->BINDEX==NULL) {
+    ffd_log("ffd_context_create(): Could not allocate memory for the "
+            "simulation.", FFD_ERROR);
+    ffd_context_free(ctx);
+    return NULL;
+  }
+
+  /****************************************************************************
+  | Provide the initial inputs so that set_initial_data() does not wait
+  ****************************************************************************/
+  cosim_record_unpack_input(&ctx->cosim, u0);
+  ctx->modelica.t = 0;
+  ctx->modelica.dt = 0;
+  ctx->modelica.flag = 1;
+  ctx->ffd.flag = 0;
+
+  if(set_initial_data(&ctx->para, ctx->var, ctx->BINDEX)!=0) {
+    ffd_log("ffd_context_create(): Could not set initial data.", FFD_ERROR);
+    ffd_context_free(ctx);
+    return NULL;
+  }
+
+  /* Read previous simulation data as initial values*/
+  if(ctx->inpu.read_old_ffd_file==1) read_ffd_data(&ctx->para, ctx->var);
+
+  return ctx;
+} /* End of ffd_context_create()*/
+
+	/*
+		* Set the inputs used for the next step
+		*
+		* @param ctx Pointer to the context
+		* @param u Pointer to the input vector
+		*
+		* @return No return needed
+		*/
+void ffd_context_set_input(FFD_CONTEXT *ctx, REAL *u) {
+  cosim_record_unpack_input(&ctx->cosim, u);
+} /* End of ffd_context_set_input()*/
+
+	/*
+		* Advance the simulation to the target time
+		*
+		* The inputs are assigned to the boundary conditions, the equations are
+		* integrated until the target time and the outputs are averaged over
+		* the step, as done by FFD_solver() between two synchronization points.
+		*
+		* @param ctx Pointer to the context
+		* @param t Target time, which must be a multiple of the FFD time step
+		*        ahead of the current time
+		*
+		* @return 0 if no error occurred
+		*/
+int ffd_context_step(FFD_CONTEXT *ctx, REAL t) {
+  PARA_DATA *para = &ctx->para;
+  REAL **var = ctx->var;
+  int **BINDEX = ctx->BINDEX;
+  int flag;
+
+  if(t-para->mytime->t<SMALL) {
+    sprintf(msg, "ffd_context_step(): Target time %f[s] is not after "
+            "the current time %f[s].", t, para->mytime->t);
+    ffd_log(msg, FFD_ERROR);
+    return 1;
+  }
+
+  /****************************************************************************
+  | Assign the inputs. The flags are set such that no waiting occurs.
+  ****************************************************************************/
+  ctx->modelica.t = para->mytime->t;
+  ctx->modelica.dt = t - para->mytime->t;
+  ctx->modelica.flag = 1;
+  ctx->cosim.para->flag = 1;
+
+  flag = read_cosim_data(para, var, BINDEX);
+  if(flag != 0) {
+    ffd_log("ffd_context_step(): Could not read the inputs.", FFD_ERROR);
+    return flag;
+  }
+
+  /****************************************************************************
+  | Integrate until the target time
+  ****************************************************************************/
+  while(1) {
+    flag = vel_step(para, var, BINDEX);
+    if(flag != 0) {
+      ffd_log("ffd_context_step(): Could not solve velocity.", FFD_ERROR);
+      return flag;
+    }
+
+    flag = temp_step(para, var, BINDEX);
+    if(flag != 0) {
+      ffd_log("ffd_context_step(): Could not solve temperature.", FFD_ERROR);
+      return flag;
+    }
+
+    flag = den_step(para, var, BINDEX);
+    if(flag != 0) {
+      ffd_log("ffd_context_step(): Could not solve trace substance.",
+              FFD_ERROR);
+      return flag;
+    }
+
+    timing(para);
+
+    /* Reached the target time*/
+    if(fabs(para->mytime->t - t)<SMALL)
+      break;
+    /* Missed the target time*/
+    else if(para->mytime->t-t>SMALL) {
+      sprintf(msg,
+              "ffd_context_step(): Mis-matched target time with "
+              "t_ffd=%f[s], t=%f[s], dt_ffd=%f[s].",
+              para->mytime->t, t, para->mytime->dt);
+      ffd_log(msg, FFD_ERROR);
+      return 1;
+    }
+
+    flag = surface_integrate(para, var, BINDEX);
+    if(flag != 0) {
+      ffd_log("ffd_context_step(): Could not average the data on boundary.",
+              FFD_ERROR);
+      return flag;
+    }
+
+    flag = add_time_averaged_data(para, var);
+    if(flag != 0) {
+      ffd_log("ffd_context_step(): Could not add the averaged data.",
+              FFD_ERROR);
+      return flag;
+    }
+  }
+
+  /****************************************************************************
+  | Compute the outputs and reset the averaged data
+  ****************************************************************************/
+  flag = average_time(para, var);
+  if(flag != 0) {
+    ffd_log("ffd_context_step(): Could not average the data over time.",
+            FFD_ERROR);
+    return flag;
+  }
+
+  ctx->ffd.flag = 0;
+  flag = write_cosim_data(para, var);
+  if(flag != 0) {
+    ffd_log("ffd_context_step(): Could not write the outputs.", FFD_ERROR);
+    return flag;
+  }
+
+  flag = reset_time_averaged_data(para, var);
+  if(flag != 0) {
+    ffd_log("ffd_context_step(): Could not reset averaged data.", FFD_ERROR);
+    return flag;
+  }
+
+  return 0;
+} /* End of ffd_context_step()*/
+
+	/*
+		* Get the outputs averaged over the last step
+		*
+		* @param ctx Pointer to the context
+		* @param y Pointer to the output vector
+		*
+		* @return Time of the outputs
+		*/
+REAL ffd_context_get_output(FFD_CONTEXT *ctx, REAL *y) {
+  cosim_record_pack_output(&ctx->cosim, y);
+  return ctx->ffd.t;
+} /* End of ffd_context_get_output()*/
+
+	/*
+		* Save the state of the simulation
+		*
+		* The state consists of the simulation variables, the time, the time
+		* averaged data as well as the current inputs and outputs.
+		*
+		* @param ctx Pointer to the context
+		*
+		* @return Pointer to the snapshot, NULL if an error occurred
+		*/
+FFD_SNAPSHOT *ffd_context_snapshot(FFD_CONTEXT *ctx) {
+  FFD_SNAPSHOT *snap;
+  int size = context_size(ctx);
+  int i;
+
+  snap = (FFD_SNAPSHOT *) calloc(1, sizeof(FFD_SNAPSHOT));
+  if(snap==NULL) {
+    ffd_log("ffd_context_snapshot(): Could not allocate memory for snapshot.",
+            FFD_ERROR);
+    return NULL;
+  }
+
+  snap->var = (REAL **) calloc(DTL+1, sizeof(REAL *));
+  snap->u = (REAL *) malloc((ctx->nU+1)*sizeof(REAL));
+  snap->y = (REAL *) malloc((ctx->nY+1)*sizeof(REAL));
+  snap->mean = (REAL *) malloc((context_nMean(ctx)+1)*sizeof(REAL));
+  if(snap->var==NULL || snap->u==NULL || snap->y==NULL || snap->mean==NULL) {
+    ffd_log("ffd_context_snapshot(): Could not allocate memory for snapshot.",
+            FFD_ERROR);
+    ffd_snapshot_free(snap);
+    return NULL;
+  }
+
+  for(i=0; i<DTL+1; i++) {
+    /* Variables that are not used are not allocated*/
+    if(ctx->var[i]==NULL) continue;
+    snap->var[i] = (REAL *) malloc(size*sizeof(REAL));
+    if(snap->var[i]==NULL) {
+      sprintf(msg, "ffd_context_snapshot(): Could not allocate memory for "
+              "var[%d]", i);
+      ffd_log(msg, FFD_ERROR);
+      ffd_snapshot_free(snap);
+      return NULL;
+    }
+    memcpy(snap->var[i], ctx->var[i], size*sizeof(REAL));
+  }
+
+  snap->mytime = ctx->mytime;
+  cosim_record_pack_input(&ctx->cosim, snap->u);
+  cosim_record_pack_output(&ctx->cosim, snap->y);
+  snap->tOut = ctx->ffd.t;
+  context_copy_mean(ctx, snap->mean, 1);
+
+  return snap;
+} /* End of ffd_context_snapshot()*/
+
+	/*
+		* Restore a state saved by ffd_context_snapshot()
+		*
+		* @param ctx Pointer to the context
+		* @param snap Pointer to the snapshot of the same context
+		*
+		* @return No return needed
+		*/
+void ffd_context_restore(FFD_CONTEXT *ctx, FFD_SNAPSHOT *snap) {
+  int size = context_size(ctx);
+  int i;
+
+  for(i=0; i<DTL+1; i++)
+    if(ctx->var[i]!=NULL && snap->var[i]!=NULL)
+      memcpy(ctx->var[i], snap->var[i], size*sizeof(REAL));
+
+  ctx->mytime = snap->mytime;
+  cosim_record_unpack_input(&ctx->cosim, snap->u);
+  cosim_record_unpack_output(&ctx->cosim, snap->y);
+  ctx->ffd.t = snap->tOut;
+  context_copy_mean(ctx, snap->mean, 0);
+} /* End of ffd_context_restore()*/
+
+	/*
+		* Free a snapshot
+		*
+		* @param snap Pointer to the snapshot
+		*
+		* @return No return needed
+		*/
+void ffd_snapshot_free(FFD_SNAPSHOT *snap) {
+  int i;
+
+  if(snap==NULL) return;
+  if(snap->var!=NULL) {
+    for(i=0; i<DTL+1; i++)
+      if(snap->var[i]!=NULL) free(snap->var[i]);
+    free(snap->var);
+  }
+  if(snap->u!=NULL) free(snap->u);
+  if(snap->y!=NULL) free(snap->y);
+  if(snap->mean!=NULL) free(snap->mean);
+  free(snap);
+} /* End of ffd_snapshot_free()*/
+
+	/*
+		* Free an FFD instance
+		*
+		* @param ctx Pointer to the context
+		*
+		* @return No return needed
+		*/
+void ffd_context_free(FFD_CONTEXT *ctx) {
+  int i;
+
+  if(ctx==NULL) return;
+
+  if(ctx->var!=NULL) {
+    for(i=0; i<DTL+1; i++)
+      if(ctx->var[i]!=NULL) free(ctx->var[i]);
+    free(ctx->var);
+  }
+  if(ctx->BINDEX!=NULL) {
+    for(i=0; i<5; i++)
+      if(ctx->BINDEX[i]!=NULL) free(ctx->BINDEX[i]);
+    free(ctx->BINDEX);
+  }
+  if(ctx->modelica.temHea!=NULL)
+    cosim_record_free_exchange(&ctx->cosim);
+
+  free(ctx);
+} /* End of ffd_context_free()*/
@@ -0,0 +1,166 @@
+/*
+	*
+	* @file   ffd_context.h
+	*
+	* @brief  Synchronous step interface to embed FFD in other programs
+	*
+	* @author agent
+	*
+	* @date   10/19/2026
+	*
+	* This file provides functions to run FFD on the thread of the caller,
+	* without the thread and the flag handshake of ffd_dll(). A context holds
+	* its own parameters, variables and boundary index, so that a program can
+	* drive several FFD instances, step them to a target time and read the
+	* outputs directly.
+	*
+	* The inputs and outputs use the same vectors u[] and y[] as
+	* cfdExchangeData(), see cosim_record_nU() and cosim_record_nY().
+	* A typical use is
+	*   ctx = ffd_context_create(cosimPara, u0);
+	*   while(...) {
+	*     ffd_context_set_input(ctx, u);
+	*     ffd_context_step(ctx, t);
+	*     ffd_context_get_output(ctx, y);
+	*   }
+	*   ffd_context_free(ctx);
+	*
+	* Note that the log file ffd.log and the trace file of cosim_record.c are
+	* shared by all contexts of a process. Different contexts should therefore
+	* not be called concurrently from different threads.
+	*
+	*/
+#ifndef _FFD_CONTEXT_H
+#define _FFD_CONTEXT_H
+#endif
+
+#ifndef _DATA_STRUCTURE_H
+#define _DATA_STRUCTURE_H
+#include "data_structure.h"
+#endif
+
+#ifndef _FFD_H
+#define _FFD_H
+#include "ffd.h"
+#endif
+
+#ifndef _COSIMULATION_H
+#define _COSIMULATION_H
+#include "cosimulation.h"
+#endif
+
+#ifndef _COSIM_RECORD_H
+#define _COSIM_RECORD_H
+#include "cosim_record.h"
+#endif
+
+/* Data of one FFD instance*/
+typedef struct {
+  PARA_DATA para; /* FFD parameters pointing to the data below*/
+  GEOM_DATA geom;
+  PROB_DATA prob;
+  TIME_DATA mytime;
+  INPU_DATA inpu;
+  OUTP_DATA outp;
+  BC_DATA bc;
+  SOLV_DATA solv;
+  SENSOR_DATA sens;
+  INIT_DATA init;
+  CosimulationData cosim; /* Exchange data as used by cfdExchangeData()*/
+  ModelicaSharedData modelica;
+  ffdSharedData ffd;
+  REAL **var; /* Simulation variables*/
+  int **BINDEX; /* Boundary cell index*/
+  int nU; /* Length of the input vector*/
+  int nY; /* Length of the output vector*/
+} FFD_CONTEXT;
+
+/* Saved state of an FFD instance*/
+typedef struct {
+  TIME_DATA mytime; /* Time of the saved state*/
+  REAL **var; /* var[DTL+1][size]: Simulation variables*/
+  REAL *u; /* u[nU]: Inputs*/
+  REAL *y; /* y[nY]: Outputs*/
+  REAL tOut; /* Time of the outputs*/
+  REAL *mean; /* Time averaged boundary and sensor data*/
+} FFD_SNAPSHOT;
+
+/*
+	* Create an FFD instance and initialize it with the inputs u0
+	*
+	* @param cosimPara Pointer to the coupled simulation parameters as set by
+	*        cfdStartCosimulation(). The data must stay valid until the
+	*        context is freed.
+	* @param u0 Pointer to the initial input vector
+	*
+	* @return Pointer to the context, NULL if an error occurred
+	*/
+FFD_CONTEXT *ffd_context_create(ParameterSharedData *cosimPara, REAL *u0);
+
+/*
+	* Set the inputs used for the next step
+	*
+	* @param ctx Pointer to the context
+	* @param u Pointer to the input vector
+	*
+	* @return No return needed
+	*/
+void ffd_context_set_input(FFD_CONTEXT *ctx, REAL *u);
+
+/*
+	* Advance the simulation to the target time
+	*
+	* @param ctx Pointer to the context
+	* @param t Target time, which must be a multiple of the FFD time step
+	*        ahead of the current time
+	*
+	* @return 0 if no error occurred
+	*/
+int ffd_context_step(FFD_CONTEXT *ctx, REAL t);
+
+/*
+	* Get the outputs averaged over the last step
+	*
+	* @param ctx Pointer to the context
+	* @param y Pointer to the output vector
+	*
+	* @return Time of the outputs
+	*/
+REAL ffd_context_get_output(FFD_CONTEXT *ctx, REAL *y);
+
+/*
+	* Save the state of the simulation
+	*
+	* @param ctx Pointer to the context
+	*
+	* @return Pointer to the snapshot, NULL if an error occurred
+	*/
+FFD_SNAPSHOT *ffd_context_snapshot(FFD_CONTEXT *ctx);
+
+/*
+	* Restore a state saved by ffd_context_snapshot()
+	*
+	* @param ctx Pointer to the context
+	* @param snap Pointer to the snapshot of the same context
+	*
+	* @return No return needed
+	*/
+void ffd_context_restore(FFD_CONTEXT *ctx, FFD_SNAPSHOT *snap);
+
+/*
+	* Free a snapshot
+	*
+	* @param snap Pointer to the snapshot
+	*
+	* @return No return needed
+	*/
+void ffd_snapshot_free(FFD_SNAPSHOT *snap);
+
+/*
+	* Free an FFD instance
+	*
+	* @param ctx Pointer to the context
+	*
+	* @return No return needed
+	*/
+void ffd_context_free(FFD_CONTEXT *ctx);
@@ -32,6 +32,7 @@ int read_ffd_data(PARA_DATA *para, REAL **var) {
   int kmax = para->geom->kmax;
   int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
   char string[400];
+  REAL Xi;
 
   if((file_old_ffd=fopen(para->inpu->old_ffd_file_name,"r"))==NULL) {
     sprintf(msg, "ffd_data_reader.c: Can not open file \"%s\".",
@@ -44,7 +45,9 @@ int read_ffd_data(PARA_DATA *para, REAL **var) {
    fgets(string, 400, file_old_ffd);
    sscanf(string,"%lf%lf%lf%lf%lf%lf", &var[VX][IX(i,j,k)], &var[VY][IX(i,j,k)],
           &var[VZ][IX(i,j,k)], &var[TEMP][IX(i,j,k)],
-          &var[Xi1][IX(i,j,k)], &var[IP][IX(i,j,k)]);
+          &Xi, &var[IP][IX(i,j,k)]);
+   /* The species is only allocated if it is simulated*/
+   if(var[Xi1]!=NULL) var[Xi1][IX(i,j,k)] = Xi;
   END_FOR
 
   fclose(file_old_ffd);
@@ -0,0 +1,343 @@
+/*
+	*
+	* \file   ffd_replay.c
+	*
+	* \brief  Replay a recorded coupled simulation without a Modelica tool
+	*
+	* \author agent
+	*
+	* \date   10/19/2026
+	*
+	* This file provides a stand-alone program that drives the FFD library with
+	* the data of a trace file written when inpu.record_file_name is set in the
+	* FFD parameter file. The program takes the role of cfdStartCosimulation()
+	* and cfdExchangeData(): it launches FFD through ffd_dll(), sends each
+	* recorded input vector u[], waits for the output vector y[] and compares
+	* it with the recorded one. The wall clock time of each synchronization is
+	* reported, so that changes of the solver can be benchmarked and checked
+	* for regressions on real workloads.
+	*
+	* Usage:
+	*   ffd_replay trace_file [tolerance [ffd_input_file]]
+	*
+	* tolerance is the maximum absolute difference between the recorded and the
+	* replayed outputs before a synchronization is flagged as diverged
+	* (default 1E-6). ffd_input_file overwrites the name of the FFD parameter
+	* file that was recorded in the trace. The parameter file used for the replay
+	* should not set inpu.record_file_name to the trace that is replayed,
+	* as FFD would overwrite it while it is read.
+	*
+	* The program returns 0 if all outputs agree within the tolerance,
+	* 1 if at least one output diverged and 2 if an error occurred.
+	*
+	*/
+#ifndef _MSC_VER
+#define _XOPEN_SOURCE 500
+#include <sys/time.h>
+#endif
+
+#ifndef _COSIM_RECORD_H
+#define _COSIM_RECORD_H
+#include "cosim_record.h"
+#endif
+
+#ifndef _FFD_DLL_H
+#define _FFD_DLL_H
+#include "ffd_dll.h"
+#endif
+
+	/*
+		* Get the wall clock time
+		*
+		* @return Wall clock time in seconds
+		*/
+static double wall_time() {
+#ifdef _MSC_VER
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double) count.QuadPart / (double) frequency.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double) tv.tv_sec + 1E-6 * (double) tv.tv_usec;
+#endif
+} /* End of wall_time()*/
+
+	/*
+		* Yield the processor while waiting for the FFD thread
+		*
+		* @return No return needed
+		*/
+static void replay_wait() {
+#ifdef _MSC_VER
+  Sleep(0);
+#else
+  usleep(50);
+#endif
+} /* End of replay_wait()*/
+
+	/*
+		* Wait until the given flag differs from value
+		*
+		* @param cosim Pointer to the coupled simulation data
+		* @param flag Pointer to the flag
+		* @param value Value to wait on
+		*
+		* @return 0 if no error occurred, 1 if FFD reported an error
+		*/
+static int wait_flag(CosimulationData *cosim, int *flag, int value) {
+  while(*flag==value) {
+    if(cosim->para->ffdError==1) {
+      fprintf(stderr, "ffd_replay: FFD reported an error. See ffd.log.\n");
+      return 1;
+    }
+    replay_wait();
+  }
+  return 0;
+} /* End of wait_flag()*/
+
+	/*
+		* Stop FFD as done in cfdSendStopCommand()
+		*
+		* @param cosim Pointer to the coupled simulation data
+		*
+		* @return 0 if no error occurred, 1 if FFD reported an error
+		*/
+static int stop_ffd(CosimulationData *cosim) {
+  cosim->para->flag = 0;
+  return wait_flag(cosim, &cosim->para->flag, 0);
+} /* End of stop_ffd()*/
+
+	/*
+		* Free the data allocated by main()
+		*
+		* @param cosim Pointer to the coupled simulation data, or NULL
+		* @param u Pointer to the input vector
+		* @param y Pointer to the output vector
+		* @param yRec Pointer to the recorded output vector
+		*
+		* @return No return needed
+		*/
+static void free_replay(CosimulationData *cosim, REAL *u, REAL *y,
+                        REAL *yRec) {
+  if(cosim!=NULL) {
+    if(cosim->para!=NULL && cosim->modelica!=NULL && cosim->ffd!=NULL)
+      cosim_record_free_header(cosim);
+    free(cosim->para);
+    free(cosim->modelica);
+    free(cosim->ffd);
+    free(cosim);
+  }
+  free(u);
+  free(y);
+  free(yRec);
+} /* End of free_replay()*/
+
+	/*
+		* Exchange the recorded data with FFD as done in cfdExchangeData()
+		*
+		* @param f Pointer to the trace file, positioned after the header
+		* @param cosim Pointer to the coupled simulation data
+		* @param u Pointer to the input vector with nU+2 elements
+		* @param y Pointer to the output vector with nY elements
+		* @param yRec Pointer to the recorded output vector with nY+1 elements
+		* @param tol Tolerance for the outputs
+		*
+		* @return 0 if the replay matched the trace, 1 if the outputs diverged,
+		*         2 if an error occurred
+		*/
+static int replay(FILE *f, CosimulationData *cosim, REAL *u, REAL *y,
+                  REAL *yRec, REAL tol) {
+  REAL t0, dt, dtMis, dy, dyMax;
+  double tSta, tEnd, tSyn, tSum = 0, tMax = 0;
+  int nU, nY, tag, i, nSyn = 0, nDiv = 0, iMax;
+
+  nU = cosim_record_nU(cosim->para);
+  nY = cosim_record_nY(cosim->para);
+
+  printf("%8s %14s %14s %12s %14s\n", "sync", "t0 [s]", "dt [s]",
+         "wall [ms]", "max |dy|");
+
+  while(fread(&tag, sizeof(int), 1, f)==1) {
+    if(tag!=COSIM_RECORD_INPUT) {
+      fprintf(stderr, "ffd_replay: Expected an input record at sync %d.\n",
+              nSyn);
+      return 2;
+    }
+    if(fread(u, sizeof(REAL), nU+2, f)!=(size_t) (nU+2)) {
+      fprintf(stderr, "ffd_replay: Truncated input record at sync %d.\n",
+              nSyn);
+      return 2;
+    }
+    t0 = u[0];
+    dt = u[1];
+
+    if(wait_flag(cosim, &cosim->modelica->flag, 1)!=0) return 2;
+
+    tSta = wall_time();
+    cosim->modelica->t = t0;
+    cosim->modelica->dt = dt;
+    cosim->modelica->lt = t0;
+    cosim_record_unpack_input(cosim, u+2);
+    cosim->modelica->flag = 1;
+
+    if(wait_flag(cosim, &cosim->ffd->flag, 0)!=0) return 2;
+    cosim_record_pack_output(cosim, y);
+    cosim->ffd->flag = 0;
+    tEnd = wall_time();
+
+    /*-------------------------------------------------------------------------
+    | Compare with the recorded output
+    -------------------------------------------------------------------------*/
+    if(fread(&tag, sizeof(int), 1, f)!=1 || tag!=COSIM_RECORD_OUTPUT
+       || fread(yRec, sizeof(REAL), nY+1, f)!=(size_t) (nY+1)) {
+      fprintf(stderr, "ffd_replay: Missing output record at sync %d.\n",
+              nSyn);
+      return 2;
+    }
+
+    /* The time at the end of the synchronization is compared separately*/
+    dtMis = fabs(cosim->ffd->t - yRec[0]);
+    dyMax = 0;
+    iMax = -1;
+    for(i=0; i<nY; i++) {
+      dy = fabs(y[i] - yRec[i+1]);
+      /* NaN is always flagged*/
+      if(dy>dyMax || dy!=dy) {
+        dyMax = dy;
+        iMax = i;
+      }
+    }
+
+    tSyn = tEnd - tSta;
+    tSum += tSyn;
+    if(tSyn>tMax) tMax = tSyn;
+
+    printf("%8d %14.4f %14.4f %12.3f %14.6e", nSyn, t0, dt, 1E3*tSyn, dyMax);
+    if(dtMis>tol || dtMis!=dtMis || dyMax>tol || dyMax!=dyMax) {
+      nDiv++;
+      printf("  DIVERGED");
+      if(dtMis>tol || dtMis!=dtMis)
+        printf(" in t1 by %e s", dtMis);
+      if(dyMax>tol || dyMax!=dyMax)
+        printf(" at y[%d]", iMax);
+    }
+    printf("\n");
+    nSyn++;
+  }
+
+  printf("Replayed %d synchronizations in %.3f s "
+         "(mean %.3f ms, max %.3f ms), %d diverged.\n",
+         nSyn, tSum, nSyn>0 ? 1E3*tSum/nSyn : 0.0, 1E3*tMax, nDiv);
+
+  return nDiv>0 ? 1 : 0;
+} /* End of replay()*/
+
+	/*
+		* Main routine of the replay program
+		*
+		* @param argc Number of arguments
+		* @param argv Pointer to the arguments
+		*
+		* @return 0 if the replay matched the trace, 1 if the outputs diverged,
+		*         2 if an error occurred
+		*/
+int main(int argc, char **argv) {
+  FILE *f;
+  CosimulationData *cosim;
+  REAL tol = 1E-6;
+  REAL *u = NULL, *y = NULL, *yRec = NULL;
+  int nU, nY, status;
+
+  if(argc<2) {
+    fprintf(stderr,
+            "Usage: %s trace_file [tolerance [ffd_input_file]]\n", argv[0]);
+    return 2;
+  }
+  if(argc>2) tol = atof(argv[2]);
+
+  if((f=fopen(argv[1], "rb"))==NULL) {
+    fprintf(stderr, "ffd_replay: Could not open trace file %s\n", argv[1]);
+    return 2;
+  }
+
+  /****************************************************************************
+  | Allocate the coupled simulation data as done in cfdcosim()
+  ****************************************************************************/
+  cosim = (CosimulationData *) calloc(1, sizeof(CosimulationData));
+  if(cosim==NULL) {
+    fprintf(stderr, "ffd_replay: Could not allocate memory for cosim.\n");
+    fclose(f);
+    return 2;
+  }
+  cosim->para = (ParameterSharedData *) calloc(1, sizeof(ParameterSharedData));
+  cosim->modelica = (ModelicaSharedData *) calloc(1, sizeof(ModelicaSharedData));
+  cosim->ffd = (ffdSharedData *) calloc(1, sizeof(ffdSharedData));
+  if(cosim->para==NULL || cosim->modelica==NULL || cosim->ffd==NULL) {
+    fprintf(stderr, "ffd_replay: Could not allocate memory for cosim.\n");
+    free_replay(cosim, u, y, yRec);
+    fclose(f);
+    return 2;
+  }
+
+  if(cosim_record_read_header(f, cosim)!=0) {
+    fprintf(stderr, "ffd_replay: %s is not a valid trace file.\n", argv[1]);
+    free_replay(cosim, u, y, yRec);
+    fclose(f);
+    return 2;
+  }
+
+  if(argc>3) {
+    free(cosim->para->fileName);
+    cosim->para->fileName = (char *) malloc((strlen(argv[3])+1)*sizeof(char));
+    if(cosim->para->fileName==NULL) {
+      fprintf(stderr, "ffd_replay: Could not allocate memory for fileName.\n");
+      free_replay(cosim, u, y, yRec);
+      fclose(f);
+      return 2;
+    }
+    strcpy(cosim->para->fileName, argv[3]);
+  }
+
+  nU = cosim_record_nU(cosim->para);
+  nY = cosim_record_nY(cosim->para);
+  u = (REAL *) malloc((nU+2)*sizeof(REAL));
+  y = (REAL *) malloc(nY*sizeof(REAL));
+  yRec = (REAL *) malloc((nY+1)*sizeof(REAL));
+  if(u==NULL || y==NULL || yRec==NULL) {
+    fprintf(stderr, "ffd_replay: Could not allocate memory for the data.\n");
+    free_replay(cosim, u, y, yRec);
+    fclose(f);
+    return 2;
+  }
+
+  printf("Replaying %s with FFD input file %s\n", argv[1],
+         cosim->para->fileName);
+  printf("nSur=%d, nPorts=%d, nSen=%d, nXi=%d, nC=%d, nU=%d, nY=%d, "
+         "tolerance=%g\n", cosim->para->nSur, cosim->para->nPorts,
+         cosim->para->nSen, cosim->para->nXi, cosim->para->nC, nU, nY, tol);
+
+  /****************************************************************************
+  | Launch FFD as done in cfdStartCosimulation()
+  ****************************************************************************/
+  cosim->modelica->flag = 0;
+  cosim->ffd->flag = 0;
+  cosim->para->flag = 1;
+  cosim->para->ffdError = 0;
+  cosim->modelica->t = 0;
+  cosim->modelica->lt = -1;
+  ffd_dll(cosim);
+
+  status = replay(f, cosim, u, y, yRec, tol);
+  fclose(f);
+
+  /****************************************************************************
+  | Stop FFD, which no longer uses cosim once it confirmed the stop
+  ****************************************************************************/
+  if(stop_ffd(cosim)!=0) status = 2;
+
+  free_replay(cosim, u, y, yRec);
+
+  return status;
+} /* End of main()*/
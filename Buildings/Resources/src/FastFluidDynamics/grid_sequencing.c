@@ -0,0 +1,446 @@
+/*
+	*
+	* \file   grid_sequencing.c
+	*
+	* \brief  Initialize the flow field with a solution on a coarsened mesh
+	*
+	* \author agent
+	*
+	* \date   10/19/2026
+	*
+	* This file provides the functions to restrict the mesh, the cell flags
+	* and the boundary conditions onto a mesh that is coarser by the factor
+	* init.coarsen, to integrate the flow on this mesh over mytime.t_steady
+	* and to interpolate the result back onto the original mesh.
+	*
+	*/
+
+#include "grid_sequencing.h"
+
+/* Index of the cell (i,j,k) on the coarse mesh*/
+#define IXC(i,j,k) ((i)+(IMAXC)*(j)+(IJMAXC)*(k))
+
+/* Maximum number of fields that are restricted onto the coarse mesh*/
+#define NB_RESTRICTED 18
+
+	/*
+		* Get the coarse index of a fine cell in one direction
+		*
+		* @param i Index of the fine cell
+		* @param n Number of interior fine cells
+		* @param nc Number of interior coarse cells
+		* @param r Coarsening factor
+		*
+		* @return Index of the coarse cell
+		*/
+static int coarse_index(int i, int n, int nc, int r) {
+  if(i<1) return 0;
+  else if(i>n) return nc+1;
+  else return (i-1)/r + 1;
+} /* End of coarse_index()*/
+
+	/*
+		* Get the fine index of the upper face of a coarse cell in one direction
+		*
+		* @param I Index of the coarse cell
+		* @param n Number of interior fine cells
+		* @param nc Number of interior coarse cells
+		* @param r Coarsening factor
+		*
+		* @return Index of the fine cell with the same upper face
+		*/
+static int fine_face(int I, int n, int nc, int r) {
+  if(I<1) return 0;
+  else if(I>nc) return n+1;
+  else return I*r<n ? I*r : n;
+} /* End of fine_face()*/
+
+	/*
+		* Rank the cell flags for the restriction
+		*
+		* A coarse cell takes the flag with the highest rank among its fine
+		* cells, so that inlets and outlets are never lost.
+		*
+		* @param flag Cell flag
+		*
+		* @return Rank of the flag
+		*/
+static int flag_rank(REAL flag) {
+  if(flag==INLET) return 3;
+  else if(flag==OUTLET) return 2;
+  else if(flag==SOLID) return 1;
+  else return 0;
+} /* End of flag_rank()*/
+
+	/*
+		* Get the interpolation weights from the coarse to the fine mesh in one
+		* direction
+		*
+		* @param xf Pointer to the fine coordinate of cell 0
+		* @param strideF Distance between two fine cells in the array
+		* @param n Number of interior fine cells
+		* @param xc Pointer to the coarse coordinate of cell 0
+		* @param strideC Distance between two coarse cells in the array
+		* @param nc Number of interior coarse cells
+		* @param lo Pointer to the lower coarse index for each fine cell
+		* @param w Pointer to the weight of the upper coarse cell
+		*
+		* @return No return needed
+		*/
+static void axis_weight(REAL *xf, int strideF, int n, REAL *xc, int strideC,
+                        int nc, int *lo, REAL *w) {
+  int i, I = 0;
+  REAL x, x0, x1;
+
+  for(i=0; i<=n+1; i++) {
+    x = xf[i*strideF];
+    while(I<nc && xc[(I+1)*strideC]<x) I++;
+    x0 = xc[I*strideC];
+    x1 = xc[(I+1)*strideC];
+    lo[i] = I;
+    if(x1-x0>SMALL*SMALL) w[i] = (x-x0) / (x1-x0);
+    else w[i] = 0;
+    if(w[i]<0) w[i] = 0;
+    if(w[i]>1) w[i] = 1;
+  }
+} /* End of axis_weight()*/
+
+	/*
+		* Interpolate a coarse variable trilinearly
+		*
+		* @param psi Pointer to the coarse variable
+		* @param IMAXC Number of coarse cells in x-direction including ghost cells
+		* @param IJMAXC Number of coarse cells in a x-y plane including ghost cells
+		* @param I Lower coarse index in x-direction
+		* @param J Lower coarse index in y-direction
+		* @param K Lower coarse index in z-direction
+		* @param wx Weight in x-direction
+		* @param wy Weight in y-direction
+		* @param wz Weight in z-direction
+		*
+		* @return Interpolated value
+		*/
+static REAL interpolate_coarse(REAL *psi, int IMAXC, int IJMAXC,
+                               int I, int J, int K,
+                               REAL wx, REAL wy, REAL wz) {
+  REAL v0, v1;
+
+  v0 = (1-wy) * ((1-wx)*psi[IXC(I,J,K)] + wx*psi[IXC(I+1,J,K)])
+     + wy * ((1-wx)*psi[IXC(I,J+1,K)] + wx*psi[IXC(I+1,J+1,K)]);
+  v1 = (1-wy) * ((1-wx)*psi[IXC(I,J,K+1)] + wx*psi[IXC(I+1,J,K+1)])
+     + wy * ((1-wx)*psi[IXC(I,J+1,K+1)] + wx*psi[IXC(I+1,J+1,K+1)]);
+
+  return (1-wz)*v0 + wz*v1;
+} /* End of interpolate_coarse()*/
+
+	/*
+		* Free the coarse data
+		*
+		* @param varC Pointer to the coarse variables
+		* @param BINDEXC Pointer to the coarse boundary index
+		* @param count Pointer to the number of fine cells in each coarse cell
+		* @param bnd Pointer to the boundary data of each coarse cell
+		* @param lo Pointer to the lower coarse indices
+		* @param w Pointer to the interpolation weights
+		*
+		* @return No return needed
+		*/
+static void free_coarse(REAL **varC, int **BINDEXC, int *count, int *bnd,
+                        int **lo, REAL **w) {
+  int i;
+
+  if(varC!=NULL) {
+    for(i=0; i<DTL+1; i++)
+      if(varC[i]!=NULL) free(varC[i]);
+    free(varC);
+  }
+  if(BINDEXC!=NULL) {
+    for(i=0; i<5; i++)
+      if(BINDEXC[i]!=NULL) free(BINDEXC[i]);
+    free(BINDEXC);
+  }
+  if(count!=NULL) free(count);
+  if(bnd!=NULL) free(bnd);
+  for(i=0; i<6; i++) {
+    if(lo[i]!=NULL) free(lo[i]);
+    if(w[i]!=NULL) free(w[i]);
+  }
+} /* End of free_coarse()*/
+
+	/*
+		* Initialize the flow field with a solution on a coarsened mesh
+		*
+		* The fields VX, VY, VZ, TEMP and IP of the fluid cells are overwritten.
+		* The boundary conditions must have been assigned before the call.
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		* @param BINDEX Pointer to boundary index
+		*
+		* @return 0 if no error occurred
+		*/
+int grid_sequencing(PARA_DATA *para, REAL **var, int **BINDEX) {
+  int r = para->init->coarsen;
+  int imax = para->geom->imax, jmax = para->geom->jmax;
+  int kmax = para->geom->kmax;
+  int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
+  int imaxC = (imax+r-1)/r, jmaxC = (jmax+r-1)/r, kmaxC = (kmax+r-1)/r;
+  int IMAXC = imaxC+2, IJMAXC = (imaxC+2)*(jmaxC+2);
+  int sizeC = (imaxC+2) * (jmaxC+2) * (kmaxC+2);
+  int restricted[NB_RESTRICTED], nb_restricted;
+  int i, j, k, I, J, K, c, l, it, n, nStep, flag;
+  int indexC = 0;
+  int *count = NULL, *bnd = NULL;
+  int *lo[6];
+  REAL *w[6];
+  REAL **varC = NULL;
+  int **BINDEXC = NULL;
+  REAL *flagp = var[FLAGP];
+  REAL Lx = para->geom->Lx, Ly = para->geom->Ly, Lz = para->geom->Lz;
+  GEOM_DATA geomC;
+  TIME_DATA timeC;
+  SOLV_DATA solvC;
+  PARA_DATA paraC;
+  clock_t start;
+
+  if(r<2) return 0;
+  if(r!=2 && r!=4) {
+    sprintf(msg, "grid_sequencing(): Coarsening factor init.coarsen=%d "
+            "is not supported. Use 1, 2 or 4.", r);
+    ffd_log(msg, FFD_ERROR);
+    return 1;
+  }
+
+  start = clock();
+
+  restricted[0] = VX; restricted[1] = VY; restricted[2] = VZ;
+  restricted[3] = TEMP; restricted[4] = IP; restricted[5] = VXBC;
+  restricted[6] = VYBC; restricted[7] = VZBC; restricted[8] = TEMPBC;
+  restricted[9] = QFLUXBC; restricted[10] = Xi1; restricted[11] = Xi2;
+  restricted[12] = Xi1BC; restricted[13] = Xi2BC; restricted[14] = C1;
+  restricted[15] = C2; restricted[16] = C1BC; restricted[17] = C2BC;
+
+  /* Skip the species and trace substances that are not allocated*/
+  nb_restricted = 0;
+  for(l=0; l<NB_RESTRICTED; l++)
+    if(var[restricted[l]]!=NULL) restricted[nb_restricted++] = restricted[l];
+
+  for(l=0; l<6; l++) {
+    lo[l] = NULL;
+    w[l] = NULL;
+  }
+
+  /****************************************************************************
+  | Set up the parameters of the coarse mesh. All other data is shared.
+  ****************************************************************************/
+  geomC = *para->geom;
+  geomC.imax = imaxC;
+  geomC.jmax = jmaxC;
+  geomC.kmax = kmaxC;
+  geomC.dx = para->geom->dx * r;
+  geomC.dy = para->geom->dy * r;
+  geomC.dz = para->geom->dz * r;
+
+  timeC = *para->mytime;
+  timeC.dt = para->mytime->dt * r;
+  timeC.t = 0;
+  timeC.step_current = 0;
+
+  /* The coarse mesh is integrated in time, also for a steady state*/
+  solvC = *para->solv;
+  solvC.steady = 0;
+
+  paraC = *para;
+  paraC.geom = &geomC;
+  paraC.mytime = &timeC;
+  paraC.solv = &solvC;
+
+  varC = allocate_var(&paraC);
+  BINDEXC = allocate_index(&paraC);
+  count = (int *) malloc(sizeC*sizeof(int));
+  bnd = (int *) malloc(2*sizeC*sizeof(int));
+  if(varC==NULL || BINDEXC==NULL || count==NULL || bnd==NULL) {
+    ffd_log("grid_sequencing(): Could not allocate memory for the coarse mesh.",
+            FFD_ERROR);
+    free_coarse(varC, BINDEXC, count, bnd, lo, w);
+    return 1;
+  }
+
+  for(c=0; c<sizeC; c++) {
+    varC[FLAGP][c] = FLUID;
+    varC[FLAGU][c] = FLUID;
+    varC[FLAGV][c] = FLUID;
+    varC[FLAGW][c] = FLUID;
+    count[c] = 0;
+  }
+
+  /****************************************************************************
+  | Coarse cell faces coincide with every r-th fine cell face
+  ****************************************************************************/
+  for(I=0; I<=imaxC+1; I++)
+    for(J=0; J<=jmaxC+1; J++)
+      for(K=0; K<=kmaxC+1; K++) {
+        c = IXC(I,J,K);
+        varC[GX][c] = var[GX][IX(fine_face(I, imax, imaxC, r), 0, 0)];
+        varC[GY][c] = var[GY][IX(0, fine_face(J, jmax, jmaxC, r), 0)];
+        varC[GZ][c] = var[GZ][IX(0, 0, fine_face(K, kmax, kmaxC, r))];
+      }
+
+  for(I=0; I<=imaxC+1; I++)
+    for(J=0; J<=jmaxC+1; J++)
+      for(K=0; K<=kmaxC+1; K++) {
+        c = IXC(I,J,K);
+        if(I<1) varC[X][c] = 0;
+        else if(I>imaxC) varC[X][c] = Lx;
+        else varC[X][c] = (REAL) 0.5 * (varC[GX][c]+varC[GX][IXC(I-1,J,K)]);
+
+        if(J<1) varC[Y][c] = 0;
+        else if(J>jmaxC) varC[Y][c] = Ly;
+        else varC[Y][c] = (REAL) 0.5 * (varC[GY][c]+varC[GY][IXC(I,J-1,K)]);
+
+        if(K<1) varC[Z][c] = 0;
+        else if(K>kmaxC) varC[Z][c] = Lz;
+        else varC[Z][c] = (REAL) 0.5 * (varC[GZ][c]+varC[GZ][IXC(I,J,K-1)]);
+      }
+
+  /****************************************************************************
+  | Restrict the variables, the boundary conditions and the cell flags.
+  | Averaging over all fine cells conserves the inflow through an inlet
+  | that covers only a part of a coarse cell.
+  ****************************************************************************/
+  FOR_ALL_CELL
+    c = IXC(coarse_index(i, imax, imaxC, r), coarse_index(j, jmax, jmaxC, r),
+            coarse_index(k, kmax, kmaxC, r));
+    count[c]++;
+    for(l=0; l<nb_restricted; l++)
+      varC[restricted[l]][c] += var[restricted[l]][IX(i,j,k)];
+    if(flag_rank(flagp[IX(i,j,k)])>flag_rank(varC[FLAGP][c]))
+      varC[FLAGP][c] = flagp[IX(i,j,k)];
+  END_FOR
+
+  for(c=0; c<sizeC; c++) {
+    if(count[c]>0)
+      for(l=0; l<nb_restricted; l++)
+        varC[restricted[l]][c] /= count[c];
+    /* Reuse count to mark the coarse boundary cells that got an index*/
+    count[c] = 0;
+  }
+
+  /****************************************************************************
+  | Take the type of thermal boundary condition and the boundary ID from
+  | the first fine boundary cell that has the same flag as the coarse cell
+  ****************************************************************************/
+  for(it=0; it<para->geom->index; it++) {
+    i = BINDEX[0][it];
+    j = BINDEX[1][it];
+    k = BINDEX[2][it];
+    c = IXC(coarse_index(i, imax, imaxC, r), coarse_index(j, jmax, jmaxC, r),
+            coarse_index(k, kmax, kmaxC, r));
+    if(count[c]==0 && flagp[IX(i,j,k)]==varC[FLAGP][c]) {
+      count[c] = 1;
+      bnd[2*c] = BINDEX[3][it];
+      bnd[2*c+1] = BINDEX[4][it];
+    }
+  }
+
+  for(K=0; K<=kmaxC+1; K++)
+    for(J=0; J<=jmaxC+1; J++)
+      for(I=0; I<=imaxC+1; I++) {
+        c = IXC(I,J,K);
+        if(varC[FLAGP][c]>=0 && count[c]==1) {
+          BINDEXC[0][indexC] = I;
+          BINDEXC[1][indexC] = J;
+          BINDEXC[2][indexC] = K;
+          BINDEXC[3][indexC] = bnd[2*c];
+          BINDEXC[4][indexC] = bnd[2*c+1];
+          indexC++;
+        }
+      }
+  geomC.index = indexC;
+
+  mark_cell(&paraC, varC);
+  geomC.volFlu = fluid_volume(&paraC, varC);
+  geomC.pindex = (int) jmaxC/2;
+
+  /****************************************************************************
+  | Integrate on the coarse mesh
+  ****************************************************************************/
+  nStep = (int) (para->mytime->t_steady/timeC.dt + 0.5);
+  if(nStep<1) nStep = 1;
+
+  sprintf(msg, "grid_sequencing(): Start %d steps with dt=%f[s] on the "
+          "coarse mesh %dx%dx%d with %d boundary cells.",
+          nStep, timeC.dt, imaxC, jmaxC, kmaxC, indexC);
+  ffd_log(msg, FFD_NORMAL);
+
+  for(n=0; n<nStep; n++) {
+    flag = vel_step(&paraC, varC, BINDEXC);
+    if(flag==0) flag = temp_step(&paraC, varC, BINDEXC);
+    if(flag==0) flag = den_step(&paraC, varC, BINDEXC);
+    if(flag!=0) {
+      ffd_log("grid_sequencing(): Could not solve on the coarse mesh.",
+              FFD_ERROR);
+      free_coarse(varC, BINDEXC, count, bnd, lo, w);
+      return flag;
+    }
+    timeC.t += timeC.dt;
+    timeC.step_current++;
+  }
+
+  /****************************************************************************
+  | Prolong the velocity, temperature and pressure onto the fine mesh.
+  | The velocities are located at the cell faces.
+  ****************************************************************************/
+  lo[0] = (int *) malloc((imax+2)*sizeof(int));
+  lo[1] = (int *) malloc((imax+2)*sizeof(int));
+  lo[2] = (int *) malloc((jmax+2)*sizeof(int));
+  lo[3] = (int *) malloc((jmax+2)*sizeof(int));
+  lo[4] = (int *) malloc((kmax+2)*sizeof(int));
+  lo[5] = (int *) malloc((kmax+2)*sizeof(int));
+  w[0] = (REAL *) malloc((imax+2)*sizeof(REAL));
+  w[1] = (REAL *) malloc((imax+2)*sizeof(REAL));
+  w[2] = (REAL *) malloc((jmax+2)*sizeof(REAL));
+  w[3] = (REAL *) malloc((jmax+2)*sizeof(REAL));
+  w[4] = (REAL *) malloc((kmax+2)*sizeof(REAL));
+  w[5] = (REAL *) malloc((kmax+2)*sizeof(REAL));
+  for(l=0; l<6; l++)
+    if(lo[l]==NULL || w[l]==NULL) {
+      ffd_log("grid_sequencing(): Could not allocate memory for the "
+              "interpolation weights.", FFD_ERROR);
+      free_coarse(varC, BINDEXC, count, bnd, lo, w);
+      return 1;
+    }
+
+  axis_weight(var[X], 1, imax, varC[X], 1, imaxC, lo[0], w[0]);
+  axis_weight(var[GX], 1, imax, varC[GX], 1, imaxC, lo[1], w[1]);
+  axis_weight(var[Y], IMAX, jmax, varC[Y], IMAXC, jmaxC, lo[2], w[2]);
+  axis_weight(var[GY], IMAX, jmax, varC[GY], IMAXC, jmaxC, lo[3], w[3]);
+  axis_weight(var[Z], IJMAX, kmax, varC[Z], IJMAXC, kmaxC, lo[4], w[4]);
+  axis_weight(var[GZ], IJMAX, kmax, varC[GZ], IJMAXC, kmaxC, lo[5], w[5]);
+
+  FOR_EACH_CELL
+    if(flagp[IX(i,j,k)]<0) {
+      var[TEMP][IX(i,j,k)] = interpolate_coarse(varC[TEMP], IMAXC, IJMAXC,
+                               lo[0][i], lo[2][j], lo[4][k], w[0][i], w[2][j], w[4][k]);
+      var[IP][IX(i,j,k)] = interpolate_coarse(varC[IP], IMAXC, IJMAXC,
+                               lo[0][i], lo[2][j], lo[4][k], w[0][i], w[2][j], w[4][k]);
+    }
+    if(var[FLAGU][IX(i,j,k)]<0)
+      var[VX][IX(i,j,k)] = interpolate_coarse(varC[VX], IMAXC, IJMAXC,
+                             lo[1][i], lo[2][j], lo[4][k], w[1][i], w[2][j], w[4][k]);
+    if(var[FLAGV][IX(i,j,k)]<0)
+      var[VY][IX(i,j,k)] = interpolate_coarse(varC[VY], IMAXC, IJMAXC,
+                             lo[0][i], lo[3][j], lo[4][k], w[0][i], w[3][j], w[4][k]);
+    if(var[FLAGW][IX(i,j,k)]<0)
+      var[VZ][IX(i,j,k)] = interpolate_coarse(varC[VZ], IMAXC, IJMAXC,
+                             lo[0][i], lo[2][j], lo[5][k], w[0][i], w[2][j], w[5][k]);
+  END_FOR
+
+  sprintf(msg, "grid_sequencing(): Initialized the flow field with %d steps "
+          "on the coarse mesh in %f[s] CPU time.",
+          nStep, (double) (clock()-start) / CLOCKS_PER_SEC);
+  ffd_log(msg, FFD_NORMAL);
+
+  free_coarse(varC, BINDEXC, count, bnd, lo, w);
+  return 0;
+} /* End of grid_sequencing()*/
@@ -0,0 +1,52 @@
+/*
+	*
+	* @file   grid_sequencing.h
+	*
+	* @brief  Initialize the flow field with a solution on a coarsened mesh
+	*
+	* @author agent
+	*
+	* @date   10/19/2026
+	*
+	* The mesh, the cell flags and the boundary conditions are coarsened by
+	* the factor init.coarsen. The flow on the coarse mesh is integrated over
+	* mytime.t_steady and the velocity, temperature and pressure are then
+	* interpolated onto the original mesh. Since the coarse mesh has fewer
+	* cells and allows a larger time step, the start-up transient is washed
+	* out at a fraction of the cost on the original mesh.
+	*
+	*/
+#ifndef _GRID_SEQUENCING_H
+#define _GRID_SEQUENCING_H
+#endif
+
+#ifndef _DATA_STRUCTURE_H
+#define _DATA_STRUCTURE_H
+#include "data_structure.h"
+#endif
+
+#ifndef _FFD_H
+#define _FFD_H
+#include "ffd.h"
+#endif
+
+#ifndef _SCI_READER_H
+#define _SCI_READER_H
+#include "sci_reader.h"
+#endif
+
+#ifndef _GEOMETRY_H
+#define _GEOMETRY_H
+#include "geometry.h"
+#endif
+
+/*
+	* Initialize the flow field with a solution on a coarsened mesh
+	*
+	* @param para Pointer to FFD parameters
+	* @param var Pointer to FFD simulation variables
+	* @param BINDEX Pointer to boundary index
+	*
+	* @return 0 if no error occurred
+	*/
+int grid_sequencing(PARA_DATA *para, REAL **var, int **BINDEX);
@@ -82,9 +82,19 @@ void set_default_parameter(PARA_DATA *para) {
   para->solv->check_residual = 0;
   para->solv->solver = GS; /* Gauss-Seidel Solver*/
   para->solv->interpolation = BILINEAR; /* Bilinear interpolation*/
+  para->solv->steady = 0; /* Transient simulation*/
+  para->solv->steady_cfl = 1.0;
+  para->solv->steady_dt_ratio = 5.0;
+  para->solv->steady_tol = (REAL) 1e-5;
+  para->solv->steady_itmax = 10000;
+  para->solv->relax_p = (REAL) 0.7; /* Only used for the steady state*/
 
   /* Default values for Input*/
   para->inpu->read_old_ffd_file = 0; /* Do not read the old FFD data as initial value*/
+  para->inpu->record_file_name[0] = '\0'; /* Do not record the coupled simulation*/
+
+  /* Default values for Initialization*/
+  para->init->coarsen = 1; /* Do not initialize on a coarsened mesh*/
 
   /* Default values for Output*/
   para->outp->Temp_ref   = 0;/*35.5f;//10.25f;*/
@@ -135,14 +145,7 @@ int set_initial_data(PARA_DATA *para, REAL **var, int **BINDEX) {
     var[VX][i]      = para->init->u;
     var[VY][i]      = para->init->v;
     var[VZ][i]      = para->init->w;
-    var[VXM][i]     = 0.0;
-    var[VYM][i]     = 0.0;
-    var[VZM][i]     = 0.0;
-    var[VXS][i]     = 0.0;
-    var[VYS][i]     = 0.0;
-    var[VZS][i]     = 0.0;
     var[TEMP][i]    = para->init->T;
-    var[TEMPM][i]   = 0.0;
     var[TEMPS][i]   = 0.0;  /* Source of temperature*/
     var[IP][i]      = 0.0;
     var[AP][i]      = 0.0;
@@ -168,20 +171,13 @@ int set_initial_data(PARA_DATA *para, REAL **var, int **BINDEX) {
     var[TEMPBC][i]  = 0.0;
     var[QFLUXBC][i] = 0.0;
     var[QFLUX][i]   = 0.0;
-    var[Xi1][i]     = 0.0;
-    var[Xi2][i]     = 0.0;
-    var[Xi1S][i]    = 0.0;
-    var[Xi2S][i]    = 0.0;
-    var[Xi1BC][i]   = 0.0;
-    var[Xi2BC][i]   = 0.0;
-    var[C1][i]      = 0.0;
-    var[C2][i]      = 0.0;
-    var[C1S][i]     = 0.0;
-    var[C2S][i]     = 0.0;
-    var[C1BC][i]    = 0.0;
-    var[C2BC][i]    = 0.0;
   }
 
+  /* The optional variables are set to 0 by allocate_var()*/
+  if(var[DTL]!=NULL)
+    for(i=0; i<size; i++)
+      var[DTL][i] = para->mytime->dt;
+
   /* Calculate the thermal diffusivity*/
   para->prob->alpha = para->prob->cond / (para->prob->rho*para->prob->Cp);
 
@@ -203,6 +199,14 @@ int set_initial_data(PARA_DATA *para, REAL **var, int **BINDEX) {
       return flag;
     }
     mark_cell(para, var);
+
+    /* The number of boundary cells is known after reading the files*/
+    flag = resize_index(para, BINDEX);
+    if(flag != 0) {
+      ffd_log("set_inital_data(): Could not resize the boundary index",
+               FFD_ERROR);
+      return flag;
+    }
   }
 
   /****************************************************************************
@@ -321,6 +325,18 @@ int set_initial_data(PARA_DATA *para, REAL **var, int **BINDEX) {
     return flag;
   }
 
+  /****************************************************************************
+  | Initialize the flow field on a coarsened mesh for stand alone simulation
+  ****************************************************************************/
+  if(para->solv->cosimulation==0 && para->init->coarsen>1) {
+    flag = grid_sequencing(para, var, BINDEX);
+    if(flag != 0) {
+      ffd_log("set_initial_data(): Could not initialize on the coarse mesh.",
+              FFD_ERROR);
+      return flag;
+    }
+  }
+
   /****************************************************************************
   | Conduct the data exchange at the initial state of cosimulation
   ****************************************************************************/
@@ -353,6 +369,19 @@ int set_initial_data(PARA_DATA *para, REAL **var, int **BINDEX) {
       return flag;
     }
 
+    /*------------------------------------------------------------------------
+    | Initialize the flow field on a coarsened mesh with the boundary
+    | conditions received from Modelica
+    ------------------------------------------------------------------------*/
+    if(para->init->coarsen>1) {
+      flag = grid_sequencing(para, var, BINDEX);
+      if(flag != 0) {
+        ffd_log("set_initial_data(): Could not initialize on the coarse mesh.",
+                FFD_ERROR);
+        return flag;
+      }
+    }
+
     /*------------------------------------------------------------------------
     | Perform the simulation for one step to update the FFD initial condition
     ------------------------------------------------------------------------*/
@@ -53,6 +53,11 @@
 #include "geometry.h"
 #endif
 
+#ifndef _GRID_SEQUENCING_H
+#define _GRID_SEQUENCING_H
+#include "grid_sequencing.h"
+#endif
+
 /*
 	* Initialize the parameters
 	*
@@ -186,6 +186,12 @@ int assign_parameter(PARA_DATA *para, char *string) {
     sprintf(msg, "assign_parameter(): %s=%s", tmp, para->inpu->old_ffd_file_name);
     ffd_log(msg, FFD_NORMAL);
   }
+  else if(!strcmp(tmp, "inpu.record_file_name")) {
+    sscanf(string, "%s%s", tmp, tmp_par);
+    sprintf (para->inpu->record_file_name, "%s%s", para->cosim->para->filePath, tmp_par);
+    sprintf(msg, "assign_parameter(): inpu.record_file_name=%.900s", para->inpu->record_file_name);
+    ffd_log(msg, FFD_NORMAL);
+  }
   else if(!strcmp(tmp, "prob.nu")) {
     sscanf(string, "%s%lf", tmp, &para->prob->nu);
     sprintf(msg, "assign_parameter(): %s=%f", tmp, para->prob->nu);
@@ -345,6 +351,36 @@ int assign_parameter(PARA_DATA *para, char *string) {
     sprintf(msg, "assign_parameter(): %s=%d", tmp, para->solv->cosimulation);
     ffd_log(msg, FFD_NORMAL);
   }
+  else if(!strcmp(tmp, "solv.steady")) {
+    sscanf(string, "%s%d", tmp, &para->solv->steady);
+    sprintf(msg, "assign_parameter(): %s=%d", tmp, para->solv->steady);
+    ffd_log(msg, FFD_NORMAL);
+  }
+  else if(!strcmp(tmp, "solv.steady_cfl")) {
+    sscanf(string, "%s%lf", tmp, &para->solv->steady_cfl);
+    sprintf(msg, "assign_parameter(): %s=%f", tmp, para->solv->steady_cfl);
+    ffd_log(msg, FFD_NORMAL);
+  }
+  else if(!strcmp(tmp, "solv.steady_dt_ratio")) {
+    sscanf(string, "%s%lf", tmp, &para->solv->steady_dt_ratio);
+    sprintf(msg, "assign_parameter(): %s=%f", tmp, para->solv->steady_dt_ratio);
+    ffd_log(msg, FFD_NORMAL);
+  }
+  else if(!strcmp(tmp, "solv.steady_tol")) {
+    sscanf(string, "%s%lf", tmp, &para->solv->steady_tol);
+    sprintf(msg, "assign_parameter(): %s=%e", tmp, para->solv->steady_tol);
+    ffd_log(msg, FFD_NORMAL);
+  }
+  else if(!strcmp(tmp, "solv.steady_itmax")) {
+    sscanf(string, "%s%d", tmp, &para->solv->steady_itmax);
+    sprintf(msg, "assign_parameter(): %s=%d", tmp, para->solv->steady_itmax);
+    ffd_log(msg, FFD_NORMAL);
+  }
+  else if(!strcmp(tmp, "solv.relax_p")) {
+    sscanf(string, "%s%lf", tmp, &para->solv->relax_p);
+    sprintf(msg, "assign_parameter(): %s=%f", tmp, para->solv->relax_p);
+    ffd_log(msg, FFD_NORMAL);
+  }
   /****************************************************************************
   | get the initial condition
   ****************************************************************************/
@@ -368,6 +404,11 @@ int assign_parameter(PARA_DATA *para, char *string) {
     sprintf(msg, "assign_parameter(): %s=%f", tmp, para->init->w);
     ffd_log(msg, FFD_NORMAL);
   }
+  else if(!strcmp(tmp, "init.coarsen")) {
+    sscanf(string, "%s%d", tmp, &para->init->coarsen);
+    sprintf(msg, "assign_parameter(): %s=%d", tmp, para->init->coarsen);
+    ffd_log(msg, FFD_NORMAL);
+  }
   /****************************************************************************
   | get the boundary conditions
   ****************************************************************************/
@@ -283,7 +283,7 @@ int read_sci_input(PARA_DATA *para, REAL **var, int **BINDEX) {
             var[VXBC][IX(ii,ij,ik)] = U;
             var[VYBC][IX(ii,ij,ik)] = V;
             var[VZBC][IX(ii,ij,ik)] = W;
-            var[Xi1BC][IX(ii,ij,ik)] = MASS;
+            if(var[Xi1BC]!=NULL) var[Xi1BC][IX(ii,ij,ik)] = MASS;
 
             flagp[IX(ii,ij,ik)] = INLET; /* Cell flag to be inlet*/
             if(para->outp->version==DEBUG) {
@@ -385,7 +385,7 @@ int read_sci_input(PARA_DATA *para, REAL **var, int **BINDEX) {
             var[VXBC][IX(ii,ij,ik)] = U;
             var[VYBC][IX(ii,ij,ik)] = V;
             var[VZBC][IX(ii,ij,ik)] = W;
-            var[Xi1BC][IX(ii,ij,ik)] = MASS;
+            if(var[Xi1BC]!=NULL) var[Xi1BC][IX(ii,ij,ik)] = MASS;
             flagp[IX(ii,ij,ik)] = OUTLET;
             if(para->outp->version==DEBUG) {
               sprintf(msg, "read_sci_input(): get outlet cell[%d,%d,%d]=%.1f",
@@ -38,6 +38,12 @@ int FFD_solver(PARA_DATA *para, REAL **var, int **BINDEX) {
   double t_cosim;
   int flag, next;
 
+  /***************************************************************************
+  | Steady state of a single simulation
+  ***************************************************************************/
+  if(para->solv->steady==1 && para->solv->cosimulation==0)
+    return steady_solver(para, var, BINDEX);
+
   if(para->solv->cosimulation == 1)
     t_cosim = para->mytime->t + para->cosim->modelica->dt;
 
@@ -212,6 +218,12 @@ int FFD_solver(PARA_DATA *para, REAL **var, int **BINDEX) {
       /* Start to record data for calculating mean velocity if needed*/
       if(para->mytime->t>t_steady && para->outp->cal_mean==0) {
         para->outp->cal_mean = 1;
+        flag = allocate_time_averaged_data(para, var);
+        if(flag != 0) {
+          ffd_log("FFD_solver(): Could not allocate averaged data.",
+            FFD_ERROR);
+          return flag;
+        }
         flag = reset_time_averaged_data(para, var);
         if(flag != 0) {
           ffd_log("FFD_solver(): Could not reset averaged data.",
@@ -312,14 +324,14 @@ int den_step(PARA_DATA *para, REAL **var, int **BINDEX) {
       ffd_log(msg, FFD_NORMAL);
     }
     den = var[C1+i];
-    flag = advect(para, var, Xi1, i, den0, den, BINDEX);
+    flag = advect(para, var, C1+i, i, den0, den, BINDEX);
     if(flag!=0) {
       sprintf(msg, "den_step(): Could not advect trace substance %d", i+1);
       ffd_log(msg, FFD_ERROR);
       return flag;
     }
 
-    flag = diffusion(para, var, Xi1, i, den, den0, BINDEX);
+    flag = diffusion(para, var, C1+i, i, den, den0, BINDEX);
     if(flag!=0) {
       sprintf(msg, "den_step(): Could not diffuse trace substance %d", i+1);
       ffd_log(msg, FFD_ERROR);
@@ -410,16 +422,17 @@ int equ_solver(PARA_DATA *para, REAL **var, int var_type, REAL *psi) {
   REAL *flagp = var[FLAGP], *flagu = var[FLAGU],
        *flagv = var[FLAGV], *flagw = var[FLAGW];
   int flag = 0;
+  REAL residual = 0;
 
   switch(var_type) {
     case VX:
-      Gauss_Seidel(para, var, flagu, psi);
+      residual = Gauss_Seidel(para, var, flagu, psi);
       break;
     case VY:
-      Gauss_Seidel(para, var, flagv, psi);
+      residual = Gauss_Seidel(para, var, flagv, psi);
       break;
     case VZ:
-      Gauss_Seidel(para, var, flagw, psi);
+      residual = Gauss_Seidel(para, var, flagw, psi);
       break;
     case TEMP:
     case IP:
@@ -427,7 +440,7 @@ int equ_solver(PARA_DATA *para, REAL **var, int var_type, REAL *psi) {
     case Xi2:
     case C1:
     case C2:
-      Gauss_Seidel(para, var, flagp, psi);
+      residual = Gauss_Seidel(para, var, flagp, psi);
       break;
     default:
       sprintf(msg, "equ_solver(): Solver for variable type %d is not defined.",
@@ -437,5 +450,8 @@ int equ_solver(PARA_DATA *para, REAL **var, int var_type, REAL *psi) {
       break;
   }
 
+  /* Keep the largest residual of the current step for the steady state*/
+  if(residual>para->solv->residual) para->solv->residual = residual;
+
   return flag;
 }/* end of equ_solver*/
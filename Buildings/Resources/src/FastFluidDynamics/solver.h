@@ -73,6 +73,11 @@
 #include "cosimulation.h"
 #endif
 
+#ifndef _STEADY_H
+#define _STEADY_H
+#include "steady.h"
+#endif
+
 /*
 	* FFD solver
 	*
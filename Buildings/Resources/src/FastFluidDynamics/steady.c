@@ -0,0 +1,314 @@
+/*
+	*
+	* \file   steady.c
+	*
+	* \brief  Steady state solver with local pseudo time steps
+	*
+	* \author agent
+	*
+	* \date   10/19/2026
+	*
+	* This file provides the pseudo time stepping towards the steady state.
+	* The local pseudo time step of a cell is
+	*   dt_local = solv.steady_cfl / (|u|/Dx + |v|/Dy + |w|/Dz)
+	* bounded by mytime.dt and solv.steady_dt_ratio*mytime.dt. Slow regions of
+	* the room therefore advance faster than with the global time step, which
+	* is limited by the fastest region such as the jet of an inlet.
+	*
+	*/
+
+#include "steady.h"
+
+	/*
+		* Get the relative change of boundary integrals and save the new values
+		*
+		* @param val Pointer to the new values
+		* @param old Pointer to the values of the previous iteration
+		* @param n Number of values
+		*
+		* @return Maximum change relative to the largest magnitude of the values
+		*/
+static REAL integral_change(REAL *val, REAL *old, int n) {
+  int i;
+  REAL scale = (REAL) SMALL, change = 0;
+
+  for(i=0; i<n; i++)
+    scale = max(scale, (REAL) fabs(val[i]));
+
+  for(i=0; i<n; i++) {
+    change = max(change, (REAL) fabs(val[i]-old[i]) / scale);
+    old[i] = val[i];
+  }
+
+  return change;
+} /* End of integral_change()*/
+
+	/*
+		* Under-relax the projected velocity
+		*
+		* The velocities of the previous and of the current iteration are both
+		* divergence free, so is their weighted average. Different from relaxing
+		* the velocity correction, this does not change the converged solution.
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		* @param uOld Pointer to the velocity in X-direction of previous iteration
+		* @param vOld Pointer to the velocity in Y-direction of previous iteration
+		* @param wOld Pointer to the velocity in Z-direction of previous iteration
+		*
+		* @return No return needed
+		*/
+static void relax_velocity(PARA_DATA *para, REAL **var, REAL *uOld,
+                           REAL *vOld, REAL *wOld) {
+  int i, j, k;
+  int imax = para->geom->imax, jmax = para->geom->jmax;
+  int kmax = para->geom->kmax;
+  int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
+  REAL *u = var[VX], *v = var[VY], *w = var[VZ];
+  REAL *flagu = var[FLAGU], *flagv = var[FLAGV], *flagw = var[FLAGW];
+  REAL relax = para->solv->relax_p;
+
+  FOR_U_CELL
+    if(flagu[IX(i,j,k)]>=0) continue;
+    u[IX(i,j,k)] = relax*u[IX(i,j,k)] + (1-relax)*uOld[IX(i,j,k)];
+  END_FOR
+
+  FOR_V_CELL
+    if(flagv[IX(i,j,k)]>=0) continue;
+    v[IX(i,j,k)] = relax*v[IX(i,j,k)] + (1-relax)*vOld[IX(i,j,k)];
+  END_FOR
+
+  FOR_W_CELL
+    if(flagw[IX(i,j,k)]>=0) continue;
+    w[IX(i,j,k)] = relax*w[IX(i,j,k)] + (1-relax)*wOld[IX(i,j,k)];
+  END_FOR
+} /* End of relax_velocity()*/
+
+	/*
+		* Solve for the steady state
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		* @param BINDEX Pointer to boundary index
+		*
+		* @return 0 if no error occurred
+		*/
+int steady_solver(PARA_DATA *para, REAL **var, int **BINDEX) {
+  int nb_wall = para->bc->nb_wall, nb_port = para->bc->nb_port;
+  int it, flag = 0, converged = 0;
+  int size = (para->geom->imax+2) * (para->geom->jmax+2)
+           * (para->geom->kmax+2);
+  REAL tol = para->solv->steady_tol;
+  REAL residual = 0, change = 0;
+  REAL *uOld, *vOld, *wOld;
+  REAL *temHeaOld = NULL, *TPortOld = NULL, *velPortOld = NULL;
+  clock_t start;
+
+  uOld = (REAL *) malloc(size*sizeof(REAL));
+  vOld = (REAL *) malloc(size*sizeof(REAL));
+  wOld = (REAL *) malloc(size*sizeof(REAL));
+
+  if(nb_wall>0)
+    temHeaOld = (REAL *) calloc(nb_wall, sizeof(REAL));
+  if(nb_port>0) {
+    TPortOld = (REAL *) calloc(nb_port, sizeof(REAL));
+    velPortOld = (REAL *) calloc(nb_port, sizeof(REAL));
+  }
+
+  /* The local time step is not allocated if solv.steady was set later*/
+  if(var[DTL]==NULL)
+    var[DTL] = (REAL *) calloc(size, sizeof(REAL));
+
+  /* The memory is freed below if the allocation failed*/
+  if(uOld==NULL || vOld==NULL || wOld==NULL) {
+    ffd_log("steady_solver(): Could not allocate memory for the velocity.",
+            FFD_ERROR);
+    flag = 1;
+  }
+  else if((nb_wall>0 && temHeaOld==NULL)
+          || (nb_port>0 && (TPortOld==NULL || velPortOld==NULL))) {
+    ffd_log("steady_solver(): Could not allocate memory for the integrals.",
+            FFD_ERROR);
+    flag = 1;
+  }
+  else if(var[DTL]==NULL) {
+    ffd_log("steady_solver(): Could not allocate memory for the local "
+            "time step.", FFD_ERROR);
+    flag = 1;
+  }
+  else {
+    sprintf(msg, "steady_solver(): Start to solve for the steady state with "
+            "cfl=%f, dt_ratio=%f, relax_p=%f, tol=%e.",
+            para->solv->steady_cfl, para->solv->steady_dt_ratio,
+            para->solv->relax_p, tol);
+    ffd_log(msg, FFD_NORMAL);
+
+    start = clock();
+
+    for(it=1; it<=para->solv->steady_itmax; it++) {
+      set_local_time_step(para, var);
+
+      /* Reset the residuals that are set by the solvers of this iteration*/
+      para->solv->residual = 0;
+      para->solv->residual_p = 0;
+
+      memcpy(uOld, var[VX], size*sizeof(REAL));
+      memcpy(vOld, var[VY], size*sizeof(REAL));
+      memcpy(wOld, var[VZ], size*sizeof(REAL));
+
+      flag = vel_step(para, var, BINDEX);
+      if(flag != 0) {
+        ffd_log("steady_solver(): Could not solve velocity.", FFD_ERROR);
+        break;
+      }
+      relax_velocity(para, var, uOld, vOld, wOld);
+
+      flag = temp_step(para, var, BINDEX);
+      if(flag != 0) {
+        ffd_log("steady_solver(): Could not solve temperature.", FFD_ERROR);
+        break;
+      }
+
+      flag = den_step(para, var, BINDEX);
+      if(flag != 0) {
+        ffd_log("steady_solver(): Could not solve trace substance.", FFD_ERROR);
+        break;
+      }
+
+      para->mytime->step_current += 1;
+
+      /*-----------------------------------------------------------------------
+      | Check the convergence
+      -----------------------------------------------------------------------*/
+      flag = surface_integrate(para, var, BINDEX);
+      if(flag != 0) {
+        ffd_log("steady_solver(): Could not integrate the data on boundary.",
+                FFD_ERROR);
+        break;
+      }
+
+      residual = max(para->solv->residual, para->solv->residual_p);
+      change = integral_change(para->bc->temHeaAve, temHeaOld, nb_wall);
+      change = max(change,
+                   integral_change(para->bc->TPortAve, TPortOld, nb_port));
+      change = max(change,
+                   integral_change(para->bc->velPortAve, velPortOld, nb_port));
+
+      if(para->outp->version==DEBUG) {
+        sprintf(msg, "steady_solver(): Iteration %d: residual=%e, "
+                "residual_p=%e, integral change=%e", it,
+                para->solv->residual, para->solv->residual_p, change);
+        ffd_log(msg, FFD_NORMAL);
+      }
+
+      /* The integrals of the first iteration have no previous value*/
+      if(it>1 && residual<tol && change<tol) {
+        converged = 1;
+        break;
+      }
+    }
+
+    if(flag==0) {
+      sprintf(msg, "steady_solver(): %s after %d iterations in %f s CPU time "
+              "with residual=%e and integral change=%e.",
+              converged==1 ? "Converged" : "Did not converge",
+              converged==1 ? it : it-1,
+              (double) (clock()-start) / CLOCKS_PER_SEC, residual, change);
+      ffd_log(msg, converged==1 ? FFD_NORMAL : FFD_WARNING);
+    }
+  }
+
+  free(uOld);
+  free(vOld);
+  free(wOld);
+  free(temHeaOld);
+  free(TPortOld);
+  free(velPortOld);
+
+  return flag;
+} /* End of steady_solver()*/
+
+	/*
+		* Set the local pseudo time step of all the cells
+		*
+		* The time step of the solid and boundary cells is mytime.dt so that the
+		* faces next to the boundary do not advance faster than in a transient
+		* simulation.
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		*
+		* @return No return needed
+		*/
+void set_local_time_step(PARA_DATA *para, REAL **var) {
+  int i, j, k;
+  int imax = para->geom->imax, jmax = para->geom->jmax;
+  int kmax = para->geom->kmax;
+  int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
+  REAL dt = para->mytime->dt;
+  REAL dtmax = para->solv->steady_dt_ratio * dt;
+  REAL *gx = var[GX], *gy = var[GY], *gz = var[GZ];
+  REAL *u = var[VX], *v = var[VY], *w = var[VZ];
+  REAL *flagp = var[FLAGP], *dtl = var[DTL];
+  REAL rate;
+
+  FOR_ALL_CELL
+    dtl[IX(i,j,k)] = dt;
+  END_FOR
+
+  FOR_EACH_CELL
+    if(flagp[IX(i,j,k)]>=0) continue;
+
+    /* Inverse of the time for the flow to pass the cell*/
+    rate = (REAL) 0.5 * (REAL) fabs(u[IX(i-1,j,k)]+u[IX(i,j,k)])
+         / (gx[IX(i,j,k)]-gx[IX(i-1,j,k)])
+         + (REAL) 0.5 * (REAL) fabs(v[IX(i,j-1,k)]+v[IX(i,j,k)])
+         / (gy[IX(i,j,k)]-gy[IX(i,j-1,k)])
+         + (REAL) 0.5 * (REAL) fabs(w[IX(i,j,k-1)]+w[IX(i,j,k)])
+         / (gz[IX(i,j,k)]-gz[IX(i,j,k-1)]);
+
+    if(rate*dtmax<=para->solv->steady_cfl)
+      dtl[IX(i,j,k)] = dtmax;
+    else
+      dtl[IX(i,j,k)] = max(dt, para->solv->steady_cfl/rate);
+  END_FOR
+} /* End of set_local_time_step()*/
+
+	/*
+		* Get the local pseudo time step at the location of a variable
+		*
+		* The velocities are located on the faces and use the smaller time step
+		* of the two neighboring cells.
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		* @param var_type Type of variable
+		* @param i I-index of the cell
+		* @param j J-index of the cell
+		* @param k K-index of the cell
+		*
+		* @return Local pseudo time step
+		*/
+REAL local_time_step(PARA_DATA *para, REAL **var, int var_type,
+                     int i, int j, int k) {
+  int imax = para->geom->imax, jmax = para->geom->jmax;
+  int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
+  REAL *dtl = var[DTL];
+  REAL dt = dtl[IX(i,j,k)];
+
+  switch(var_type) {
+    case VX:
+      if(dtl[IX(i+1,j,k)]<dt) dt = dtl[IX(i+1,j,k)];
+      break;
+    case VY:
+      if(dtl[IX(i,j+1,k)]<dt) dt = dtl[IX(i,j+1,k)];
+      break;
+    case VZ:
+      if(dtl[IX(i,j,k+1)]<dt) dt = dtl[IX(i,j,k+1)];
+      break;
+    default:
+      break;
+  }
+
+  return dt;
+} /* End of local_time_step()*/
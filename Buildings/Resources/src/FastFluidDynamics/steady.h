@@ -0,0 +1,78 @@
+/*
+	*
+	* @file   steady.h
+	*
+	* @brief  Steady state solver with local pseudo time steps
+	*
+	* @author agent
+	*
+	* @date   10/19/2026
+	*
+	* If solv.steady is 1, the stand-alone simulation does not integrate the
+	* flow in time but iterates towards the steady state. Each cell advances
+	* with its own pseudo time step set by the Courant number solv.steady_cfl
+	* and bounded by mytime.dt and solv.steady_dt_ratio*mytime.dt, and the
+	* projected velocity is under-relaxed by solv.relax_p.
+	* The iteration stops when the residuals of the Gauss-Seidel solvers and
+	* the change of the wall and port integrals fall below solv.steady_tol.
+	*
+	*/
+#ifndef _STEADY_H
+#define _STEADY_H
+#endif
+
+#ifndef _DATA_STRUCTURE_H
+#define _DATA_STRUCTURE_H
+#include "data_structure.h"
+#endif
+
+#ifndef _SOLVER_H
+#define _SOLVER_H
+#include "solver.h"
+#endif
+
+#ifndef _COSIMULATION_H
+#define _COSIMULATION_H
+#include "cosimulation.h"
+#endif
+
+#ifndef _UTILITY_H
+#define _UTILITY_H
+#include "utility.h"
+#endif
+
+/*
+	* Solve for the steady state
+	*
+	* @param para Pointer to FFD parameters
+	* @param var Pointer to FFD simulation variables
+	* @param BINDEX Pointer to boundary index
+	*
+	* @return 0 if no error occurred
+	*/
+int steady_solver(PARA_DATA *para, REAL **var, int **BINDEX);
+
+/*
+	* Set the local pseudo time step of all the cells
+	*
+	* @param para Pointer to FFD parameters
+	* @param var Pointer to FFD simulation variables
+	*
+	* @return No return needed
+	*/
+void set_local_time_step(PARA_DATA *para, REAL **var);
+
+/*
+	* Get the local pseudo time step at the location of a variable
+	*
+	* @param para Pointer to FFD parameters
+	* @param var Pointer to FFD simulation variables
+	* @param var_type Type of variable
+	* @param i I-index of the cell
+	* @param j J-index of the cell
+	* @param k K-index of the cell
+	*
+	* @return Local pseudo time step
+	*/
+REAL local_time_step(PARA_DATA *para, REAL **var, int var_type,
+                     int i, int j, int k);
@@ -320,12 +320,15 @@ int average_time(PARA_DATA *para, REAL **var) {
   int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
   int step = para->mytime->step_mean;
 
-  FOR_ALL_CELL
-    var[VXM][IX(i,j,k)] = var[VXM][IX(i,j,k)] / step;
-    var[VYM][IX(i,j,k)] = var[VYM][IX(i,j,k)] / step;
-    var[VZM][IX(i,j,k)] = var[VZM][IX(i,j,k)] / step;
-    var[TEMPM][IX(i,j,k)] = var[TEMPM][IX(i,j,k)] / step;
-  END_FOR
+  /* The time averaged variables are only allocated when they are used*/
+  if(var[VXM]!=NULL) {
+    FOR_ALL_CELL
+      var[VXM][IX(i,j,k)] = var[VXM][IX(i,j,k)] / step;
+      var[VYM][IX(i,j,k)] = var[VYM][IX(i,j,k)] / step;
+      var[VZM][IX(i,j,k)] = var[VZM][IX(i,j,k)] / step;
+      var[TEMPM][IX(i,j,k)] = var[TEMPM][IX(i,j,k)] / step;
+    END_FOR
+  }
 
   /* Wall surfaces*/
   for(i=0; i<para->bc->nb_wall; i++)
@@ -366,12 +369,14 @@ int reset_time_averaged_data (PARA_DATA *para, REAL **var) {
   int IMAX = imax+2, IJMAX = (imax+2)*(jmax+2);
 
 
-  FOR_ALL_CELL
-    var[VXM][IX(i,j,k)] = 0;
-    var[VYM][IX(i,j,k)] = 0;
-    var[VZM][IX(i,j,k)] = 0;
-    var[TEMPM][IX(i,j,k)] = 0;
-  END_FOR
+  if(var[VXM]!=NULL) {
+    FOR_ALL_CELL
+      var[VXM][IX(i,j,k)] = 0;
+      var[VYM][IX(i,j,k)] = 0;
+      var[VZM][IX(i,j,k)] = 0;
+      var[TEMPM][IX(i,j,k)] = 0;
+    END_FOR
+  }
 
   /* Wall surfaces*/
   for(i=0; i<para->bc->nb_wall; i++)
@@ -415,12 +420,13 @@ int add_time_averaged_data(PARA_DATA *para, REAL **var) {
   int size = (imax+2) * (jmax+2) * (kmax+2);
 
   /* All the cells*/
-  for(i=0; i<size; i++) {
-    var[VXM][i] += var[VX][i];
-    var[VYM][i] += var[VY][i];
-    var[VZM][i] += var[VZ][i];
-    var[TEMPM][i] += var[TEMP][i];
-  }
+  if(var[VXM]!=NULL)
+    for(i=0; i<size; i++) {
+      var[VXM][i] += var[VX][i];
+      var[VYM][i] += var[VY][i];
+      var[VZM][i] += var[VZ][i];
+      var[TEMPM][i] += var[TEMP][i];
+    }
 
   /* Wall surfaces*/
   for(i=0; i<para->bc->nb_wall; i++)
@@ -449,6 +455,70 @@ int add_time_averaged_data(PARA_DATA *para, REAL **var) {
   return 0;
 } /* End of add_time_averaged_data()*/
 
+	/*
+		* Allocate memory for the time averaged variables
+		*
+		* The single simulation only allocates the time averaged variables once
+		* it starts to calculate the mean values.
+		*
+		* @param para Pointer to FFD parameters
+		* @param var Pointer to FFD simulation variables
+		*
+		* @return 0 if no error occurred
+		*/
+int allocate_time_averaged_data(PARA_DATA *para, REAL **var) {
+  int i;
+  int size = (para->geom->imax+2) * (para->geom->jmax+2)
+           * (para->geom->kmax+2);
+  int mean[4];
+
+  mean[0] = VXM; mean[1] = VYM; mean[2] = VZM; mean[3] = TEMPM;
+
+  for(i=0; i<4; i++) {
+    if(var[mean[i]]!=NULL) continue;
+    var[mean[i]] = (REAL *) calloc(size, sizeof(REAL));
+    if(var[mean[i]]==NULL) {
+      sprintf(msg, "allocate_time_averaged_data(): Could not allocate memory "
+              "for var[%d]", mean[i]);
+      ffd_log(msg, FFD_ERROR);
+      return 1;
+    }
+  }
+
+  return 0;
+} /* End of allocate_time_averaged_data()*/
+
+	/*
+		* Reduce the memory for BINDEX to the number of boundary cells
+		*
+		* @param para Pointer to FFD parameters
+		* @param BINDEX Pointer to the boundary index
+		*
+		* @return 0 if no error occurred
+		*/
+int resize_index(PARA_DATA *para, int **BINDEX) {
+  int i;
+  int size = para->geom->index>0 ? para->geom->index : 1;
+  int *tmp;
+
+  for(i=0; i<5; i++) {
+    tmp = (int *) realloc(BINDEX[i], size*sizeof(int));
+    if(tmp==NULL) {
+      sprintf(msg, "resize_index(): Could not reallocate memory for "
+              "BINDEX[%d]", i);
+      ffd_log(msg, FFD_ERROR);
+      return 1;
+    }
+    BINDEX[i] = tmp;
+  }
+
+  sprintf(msg, "resize_index(): BINDEX holds %d boundary cells (%.2f MB).",
+          para->geom->index, (double) 5 * size * sizeof(int) / 1048576.0);
+  ffd_log(msg, FFD_NORMAL);
+
+  return 0;
+} /* End of resize_index()*/
+
 	/*
 		* Check the energy transfer rate through the wall to the air
 		*
@@ -564,6 +634,8 @@ void free_index(int **BINDEX) {
   if(BINDEX[0]) free(BINDEX[0]);
   if(BINDEX[1]) free(BINDEX[1]);
   if(BINDEX[2]) free(BINDEX[2]);
+  if(BINDEX[3]) free(BINDEX[3]);
+  if(BINDEX[4]) free(BINDEX[4]);
 } /* End of free_index ()*/
 
 	/*
@@ -624,6 +696,7 @@ void free_data(REAL **var) {
   if(var[C2])  free(var[C2]);
   if(var[C1BC])  free(var[C1BC]);
   if(var[C2BC])  free(var[C2BC]);
+  if(var[DTL])  free(var[DTL]);
   if(var[QFLUXBC])  free(var[QFLUXBC]);
   if(var[QFLUX])  free(var[QFLUX]);
 
@@ -166,6 +166,26 @@ int reset_time_averaged_data (PARA_DATA *para, REAL **var);
 	*/
 int add_time_averaged_data (PARA_DATA *para, REAL **var);
 
+/*
+	* Allocate memory for the time averaged variables
+	*
+	* @param para Pointer to FFD parameters
+	* @param var Pointer to FFD simulation variables
+	*
+	* @return 0 if no error occurred
+	*/
+int allocate_time_averaged_data(PARA_DATA *para, REAL **var);
+
+/*
+	* Reduce the memory for BINDEX to the number of boundary cells
+	*
+	* @param para Pointer to FFD parameters
+	* @param BINDEX Pointer to the boundary index
+	*
+	* @return 0 if no error occurred
+	*/
+int resize_index(PARA_DATA *para, int **BINDEX);
+
 /*
 	* Check the energy transfer rate through the wall to the air
 	*
@@ -0,0 +1,518 @@
+/*
+ * Mock of the EnergyPlus FMU that is generated by spawn.
+ *
+ * This is an FMI 2.0 for Model Exchange library that has the variables which
+ * spawn generates for the zones, schedules, EMS actuators and output variables
+ * of a building. The variables are listed in the file resources/variables.txt
+ * of the FMU, which is written by mockSpawn.py.
+ * Rather than running EnergyPlus, the mock uses cheap and deterministic dynamics:
+ * At each time step of MOCK_ENERGYPLUS_TIME_STEP seconds, the radiative temperature
+ * of each zone relaxes toward the air temperature, and the solar and people gains
+ * are updated from a daily profile. The convective heat flow rate depends directly
+ * on the air temperature, and its derivative is provided through
+ * fmi2GetDirectionalDerivative.
+ * As in EnergyPlus, temperatures are in degC.
+ *
+ * If the executable that loads the FMU exports the function mockEnergyPlusCountCall,
+ * then this function is called for each call of an FMI function, which allows to
+ * count the FMU calls of the Spawn exchange layer.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "MockEnergyPlus.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include "FMI2/fmi2Functions.h"
+
+#define MOCK_PI 3.14159265358979323846
+/* Convective and radiative heat transfer coefficients in W/(m2.K) */
+#define MOCK_H_CON 3.0
+#define MOCK_H_RAD 5.0
+/* Time constant of the radiative temperature in seconds */
+#define MOCK_TAU 3600.0
+
+typedef enum {
+  roleV, roleAFlo, roleMSenFac,
+  roleT, roleX, roleMInlets_flow, roleTAveInlet, roleQGaiRad_flow,
+  roleTRad, roleQConSen_flow, roleQLat_flow, roleQPeo_flow,
+  roleInput, roleOutput, nRoles
+} MockRole;
+
+static const char* MockRoleNames[] = {
+  "V", "AFlo", "mSenFac",
+  "T", "X", "mInlets_flow", "TAveInlet", "QGaiRad_flow",
+  "TRad", "QConSen_flow", "QLat_flow", "QPeo_flow",
+  "input", "output"};
+
+typedef struct MockVariable{
+  MockRole role; /* Role of the variable */
+  size_t index;  /* Index of the zone, of the input or of the output */
+} MockVariable;
+
+typedef struct MockZone{
+  double AFlo;          /* Floor area in m2 */
+  double V;             /* Volume in m3 */
+  double T;             /* Air temperature in degC */
+  double X;             /* Water vapor mass fraction */
+  double mInlets_flow;  /* Mass flow rate of the inlets in kg/s */
+  double TAveInlet;     /* Average temperature of the inlets in degC */
+  double QGaiRad_flow;  /* Radiative heat gain in W */
+  double TRad;          /* Radiative temperature in degC */
+  double QSol_flow;     /* Solar heat gain of the current time step in W */
+  double QPeo_flow;     /* People heat gain of the current time step in W */
+} MockZone;
+
+typedef struct MockInstance{
+  fmi2String instanceName;               /* Name of the instance */
+  const fmi2CallbackFunctions* functions; /* Callback functions */
+  fmi2Boolean loggingOn;                 /* Flag, true if logging is on */
+  size_t nVar;                           /* Number of variables */
+  MockVariable* vars;                    /* Variables, indexed by their value reference */
+  size_t nZon;                           /* Number of zones */
+  MockZone* zones;                       /* Zones */
+  size_t nInp;                           /* Number of schedules and EMS actuators */
+  double* inputs;                        /* Values of the schedules and EMS actuators */
+  size_t nOut;                           /* Number of output variables */
+  double dt;                             /* Time step in seconds */
+  double time;                           /* Current time */
+  double tLast;                          /* Time of the last update of the states */
+  MockEnergyPlusCounter counter;         /* Function that counts the calls, or NULL */
+} MockInstance;
+
+static void countCall(const MockInstance* c, MockEnergyPlusFunction fun, size_t nValues){
+  if (c->counter != NULL)
+    c->counter(fun, nValues);
+}
+
+static void logError(const MockInstance* c, const char* message){
+  if (c->functions != NULL && c->functions->logger != NULL)
+    c->functions->logger(c->functions->componentEnvironment, c->instanceName, fmi2Error, "logStatusError", message);
+  else
+    fprintf(stderr, "%s: %s\n", c->instanceName, message);
+}
+
+/* Return the solar and the people heat gain per unit floor area for time t */
+static double getSolarGain(double t){
+  const double s = sin(2*MOCK_PI*t/86400.0 - MOCK_PI/2);
+  return s > 0 ? 50.0*s : 0;
+}
+
+static double getPeopleGain(double t){
+  const double hour = fmod(t, 86400.0)/3600.0;
+  return (hour >= 8 && hour < 18) ? 7.0 : 0;
+}
+
+/* Update the states from tLast to time, and set the gains of the new time step */
+static void updateStates(MockInstance* c){
+  const double a = 1 - exp(-(c->time - c->tLast)/MOCK_TAU);
+  size_t i;
+  MockZone* z;
+
+  for(i = 0; i < c->nZon; i++){
+    z = &(c->zones[i]);
+    z->TRad += a * (z->T + (z->QGaiRad_flow + z->QSol_flow)/(MOCK_H_RAD*z->AFlo) - z->TRad);
+    z->QSol_flow = z->AFlo * getSolarGain(c->time);
+    z->QPeo_flow = z->AFlo * getPeopleGain(c->time);
+  }
+  c->tLast = c->time;
+}
+
+static double getValue(const MockInstance* c, const MockVariable* var){
+  const MockZone* z = (var->role < roleInput) ? &(c->zones[var->index]) : NULL;
+  double y;
+  size_t i;
+
+  switch(var->role){
+    case roleV: return z->V;
+    case roleAFlo: return z->AFlo;
+    case roleMSenFac: return 1;
+    case roleT: return z->T;
+    case roleX: return z->X;
+    case roleMInlets_flow: return z->mInlets_flow;
+    case roleTAveInlet: return z->TAveInlet;
+    case roleQGaiRad_flow: return z->QGaiRad_flow;
+    case roleTRad: return z->TRad;
+    case roleQConSen_flow: return MOCK_H_CON * z->AFlo * (z->TRad - z->T) + 0.5 * z->QSol_flow;
+    case roleQLat_flow: return 0.4 * z->QPeo_flow;
+    case roleQPeo_flow: return 0.6 * z->QPeo_flow;
+    case roleInput: return c->inputs[var->index];
+    case roleOutput:
+      /* Average radiative temperature plus the sum of the inputs */
+      y = (double)var->index;
+      for(i = 0; i < c->nZon; i++)
+        y += c->zones[i].TRad/(double)c->nZon;
+      for(i = 0; i < c->nInp; i++)
+        y += c->inputs[i];
+      return y;
+    default: return 0;
+  }
+}
+
+/* Read the variables from the resources directory */
+static int readVariables(MockInstance* c, const char* resourceLocation){
+  char* fileName;
+  const char* dir = resourceLocation;
+  FILE* fp;
+  char role[64];
+  unsigned int valRef;
+  unsigned long index;
+  unsigned long nZon, nInp, nOut, nVar;
+  size_t i;
+  int r;
+  int ret = 0;
+
+  /* The location is a URI such as file:///tmp/dir/resources */
+  if (strncmp(dir, "file://", 7) == 0)
+    dir += 7;
+  else if (strncmp(dir, "file:", 5) == 0)
+    dir += 5;
+  if (strncmp(dir, "localhost/", 10) == 0)
+    dir += 9;
+
+  fileName = (char*)malloc(strlen(dir) + strlen(MOCK_ENERGYPLUS_VARIABLES) + 2);
+  if (fileName == NULL)
+    return -1;
+  sprintf(fileName, "%s/%s", dir, MOCK_ENERGYPLUS_VARIABLES);
+  fp = fopen(fileName, "r");
+  free(fileName);
+  if (fp == NULL)
+    return -1;
+
+  if (fscanf(fp, "%lu %lu %lu %lu", &nVar, &nZon, &nInp, &nOut) != 4){
+    fclose(fp);
+    return -1;
+  }
+  c->nVar = nVar;
+  c->nZon = nZon;
+  c->nInp = nInp;
+  c->nOut = nOut;
+  c->vars = (MockVariable*)calloc(nVar + 1, sizeof(MockVariable));
+  c->zones = (MockZone*)calloc(nZon + 1, sizeof(MockZone));
+  c->inputs = (double*)calloc(nInp + 1, sizeof(double));
+  if (c->vars == NULL || c->zones == NULL || c->inputs == NULL){
+    fclose(fp);
+    return -1;
+  }
+  for(i = 0; i < nVar; i++){
+    if (fscanf(fp, "%u %63s %lu", &valRef, role, &index) != 3 || valRef >= nVar){
+      ret = -1;
+      break;
+    }
+    for(r = 0; r < nRoles && strcmp(role, MockRoleNames[r]) != 0; r++){}
+    if (r == nRoles
+      || (r < roleInput && index >= nZon)
+      || (r == roleInput && index >= nInp)
+      || (r == roleOutput && index >= nOut)){
+      ret = -1;
+      break;
+    }
+    c->vars[valRef].role = (MockRole)r;
+    c->vars[valRef].index = (size_t)index;
+  }
+  fclose(fp);
+  return ret;
+}
+
+FMI2_Export const char* fmi2GetTypesPlatform(){
+  return fmi2TypesPlatform;
+}
+
+FMI2_Export const char* fmi2GetVersion(){
+  return fmi2Version;
+}
+
+FMI2_Export fmi2Status fmi2SetDebugLogging(fmi2Component c, fmi2Boolean loggingOn, size_t nCategories, const fmi2String categories[]){
+  MockInstance* m = (MockInstance*)c;
+  countCall(m, mockSetDebugLogging, 0);
+  m->loggingOn = loggingOn;
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Component fmi2Instantiate(fmi2String instanceName, fmi2Type fmuType, fmi2String fmuGUID,
+  fmi2String fmuResourceLocation, const fmi2CallbackFunctions* functions, fmi2Boolean visible, fmi2Boolean loggingOn){
+  MockInstance* c;
+  const char* str;
+  size_t i;
+
+  c = (MockInstance*)calloc(1, sizeof(MockInstance));
+  if (c == NULL)
+    return NULL;
+  c->instanceName = instanceName;
+  c->functions = functions;
+  c->loggingOn = loggingOn;
+#ifndef _WIN32
+  /* Conversion of the object pointer as recommended by POSIX for dlsym */
+  *(void**)(&(c->counter)) = dlsym(RTLD_DEFAULT, MOCK_ENERGYPLUS_COUNTER);
+#endif
+  countCall(c, mockInstantiate, 0);
+
+  if (fmuType != fmi2ModelExchange){
+    logError(c, "The mock of EnergyPlus only supports Model Exchange.");
+    free(c);
+    return NULL;
+  }
+  if (fmuResourceLocation == NULL || readVariables(c, fmuResourceLocation) != 0){
+    logError(c, "Failed to read the variables from the resources directory.");
+    fmi2FreeInstance(c);
+    return NULL;
+  }
+  str = getenv(MOCK_ENERGYPLUS_TIME_STEP);
+  c->dt = (str == NULL) ? 600 : atof(str);
+  if (c->dt <= 0)
+    c->dt = 600;
+
+  for(i = 0; i < c->nZon; i++){
+    c->zones[i].AFlo = 50.0 + 10.0 * (double)(i % 10);
+    c->zones[i].V = 2.7 * c->zones[i].AFlo;
+    c->zones[i].T = 20;
+    c->zones[i].TAveInlet = 20;
+    c->zones[i].TRad = 20;
+  }
+  return c;
+}
+
+FMI2_Export void fmi2FreeInstance(fmi2Component c){
+  MockInstance* m = (MockInstance*)c;
+  if (m == NULL)
+    return;
+  countCall(m, mockFreeInstance, 0);
+  free(m->vars);
+  free(m->zones);
+  free(m->inputs);
+  free(m);
+}
+
+FMI2_Export fmi2Status fmi2SetupExperiment(fmi2Component c, fmi2Boolean toleranceDefined, fmi2Real tolerance,
+  fmi2Real startTime, fmi2Boolean stopTimeDefined, fmi2Real stopTime){
+  MockInstance* m = (MockInstance*)c;
+  countCall(m, mockSetupExperiment, 0);
+  m->time = startTime;
+  m->tLast = startTime;
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2EnterInitializationMode(fmi2Component c){
+  countCall((MockInstance*)c, mockEnterInitializationMode, 0);
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2ExitInitializationMode(fmi2Component c){
+  MockInstance* m = (MockInstance*)c;
+  countCall(m, mockExitInitializationMode, 0);
+  updateStates(m);
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2Terminate(fmi2Component c){
+  countCall((MockInstance*)c, mockTerminate, 0);
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2Reset(fmi2Component c){
+  countCall((MockInstance*)c, mockOther, 0);
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetReal(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Real value[]){
+  MockInstance* m = (MockInstance*)c;
+  size_t i;
+
+  countCall(m, mockGetReal, nvr);
+  for(i = 0; i < nvr; i++){
+    if (vr[i] >= m->nVar){
+      logError(m, "Invalid value reference in fmi2GetReal.");
+      return fmi2Error;
+    }
+    value[i] = getValue(m, &(m->vars[vr[i]]));
+  }
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2SetReal(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Real value[]){
+  MockInstance* m = (MockInstance*)c;
+  const MockVariable* var;
+  MockZone* z;
+  size_t i;
+
+  countCall(m, mockSetReal, nvr);
+  for(i = 0; i < nvr; i++){
+    if (vr[i] >= m->nVar){
+      logError(m, "Invalid value reference in fmi2SetReal.");
+      return fmi2Error;
+    }
+    var = &(m->vars[vr[i]]);
+    z = (var->role < roleInput) ? &(m->zones[var->index]) : NULL;
+    switch(var->role){
+      case roleT: z->T = value[i]; break;
+      case roleX: z->X = value[i]; break;
+      case roleMInlets_flow: z->mInlets_flow = value[i]; break;
+      case roleTAveInlet: z->TAveInlet = value[i]; break;
+      case roleQGaiRad_flow: z->QGaiRad_flow = value[i]; break;
+      case roleInput: m->inputs[var->index] = value[i]; break;
+      default:
+        logError(m, "Variable in fmi2SetReal is not an input.");
+        return fmi2Error;
+    }
+  }
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2GetInteger(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Integer value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetBoolean(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Boolean value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetString(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2String value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SetInteger(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Integer value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SetBoolean(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Boolean value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SetString(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2String value[]){
+  countCall((MockInstance*)c, mockOther, nvr);
+  return nvr == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetFMUstate(fmi2Component c, fmi2FMUstate* FMUstate){
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SetFMUstate(fmi2Component c, fmi2FMUstate FMUstate){
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2FreeFMUstate(fmi2Component c, fmi2FMUstate* FMUstate){
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SerializedFMUstateSize(fmi2Component c, fmi2FMUstate FMUstate, size_t *size){
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2SerializeFMUstate(fmi2Component c, fmi2FMUstate FMUstate, fmi2Byte serializedState[], size_t size){
+  return fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2DeSerializeFMUstate(fmi2Component c, const fmi2Byte serializedState[], size_t size, fmi2FMUstate* FMUstate){
+  return fmi2Error;
+}
+
+/* Only the convective heat flow rate of a zone depends on an input, which is the air temperature of the zone */
+FMI2_Export fmi2Status fmi2GetDirectionalDerivative(fmi2Component c,
+  const fmi2ValueReference vUnknown_ref[], size_t nUnknown,
+  const fmi2ValueReference vKnown_ref[], size_t nKnown,
+  const fmi2Real dvKnown[], fmi2Real dvUnknown[]){
+  MockInstance* m = (MockInstance*)c;
+  const MockVariable* unk;
+  const MockVariable* kno;
+  size_t i, j;
+
+  countCall(m, mockGetDirectionalDerivative, nUnknown);
+  for(i = 0; i < nUnknown; i++){
+    if (vUnknown_ref[i] >= m->nVar){
+      logError(m, "Invalid value reference in fmi2GetDirectionalDerivative.");
+      return fmi2Error;
+    }
+    unk = &(m->vars[vUnknown_ref[i]]);
+    dvUnknown[i] = 0;
+    for(j = 0; j < nKnown; j++){
+      if (vKnown_ref[j] >= m->nVar){
+        logError(m, "Invalid value reference in fmi2GetDirectionalDerivative.");
+        return fmi2Error;
+      }
+      kno = &(m->vars[vKnown_ref[j]]);
+      if (unk->role == roleQConSen_flow && kno->role == roleT && unk->index == kno->index)
+        dvUnknown[i] += -MOCK_H_CON * m->zones[unk->index].AFlo * dvKnown[j];
+    }
+  }
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2EnterEventMode(fmi2Component c){
+  countCall((MockInstance*)c, mockEnterEventMode, 0);
+  return fmi2OK;
+}
+
+/* Update the states at the end of each time step, and return the end of the next time step as the next event */
+FMI2_Export fmi2Status fmi2NewDiscreteStates(fmi2Component c, fmi2EventInfo* fmi2eventInfo){
+  MockInstance* m = (MockInstance*)c;
+  const double tNext = (floor(m->tLast/m->dt + 1e-9) + 1) * m->dt;
+
+  countCall(m, mockNewDiscreteStates, 0);
+  if (m->time >= tNext - 1e-6)
+    updateStates(m);
+  fmi2eventInfo->newDiscreteStatesNeeded = fmi2False;
+  fmi2eventInfo->terminateSimulation = fmi2False;
+  fmi2eventInfo->nominalsOfContinuousStatesChanged = fmi2False;
+  fmi2eventInfo->valuesOfContinuousStatesChanged = fmi2False;
+  fmi2eventInfo->nextEventTimeDefined = fmi2True;
+  fmi2eventInfo->nextEventTime = (floor(m->tLast/m->dt + 1e-9) + 1) * m->dt;
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2EnterContinuousTimeMode(fmi2Component c){
+  countCall((MockInstance*)c, mockEnterContinuousTimeMode, 0);
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2CompletedIntegratorStep(fmi2Component c, fmi2Boolean noSetFMUStatePriorToCurrentPoint,
+  fmi2Boolean* enterEventMode, fmi2Boolean* terminateSimulation){
+  countCall((MockInstance*)c, mockCompletedIntegratorStep, 0);
+  *enterEventMode = fmi2False;
+  *terminateSimulation = fmi2False;
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2SetTime(fmi2Component c, fmi2Real time){
+  MockInstance* m = (MockInstance*)c;
+  countCall(m, mockSetTime, 0);
+  m->time = time;
+  return fmi2OK;
+}
+
+FMI2_Export fmi2Status fmi2SetContinuousStates(fmi2Component c, const fmi2Real x[], size_t nx){
+  countCall((MockInstance*)c, mockOther, nx);
+  return nx == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetDerivatives(fmi2Component c, fmi2Real derivatives[], size_t nx){
+  countCall((MockInstance*)c, mockOther, nx);
+  return nx == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetEventIndicators(fmi2Component c, fmi2Real eventIndicators[], size_t ni){
+  countCall((MockInstance*)c, mockOther, ni);
+  return ni == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetContinuousStates(fmi2Component c, fmi2Real x[], size_t nx){
+  countCall((MockInstance*)c, mockOther, nx);
+  return nx == 0 ? fmi2OK : fmi2Error;
+}
+
+FMI2_Export fmi2Status fmi2GetNominalsOfContinuousStates(fmi2Component c, fmi2Real x_nominal[], size_t nx){
+  countCall((MockInstance*)c, mockOther, nx);
+  return nx == 0 ? fmi2OK : fmi2Error;
+}
@@ -0,0 +1,45 @@
+/*
+ * Mock of the EnergyPlus FMU that is generated by spawn.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_MockEnergyPlus_h
+#define Buildings_MockEnergyPlus_h
+
+#include <stddef.h>  /* stddef defines size_t */
+
+/* Name of the file in the resources directory of the FMU that lists the variables */
+#define MOCK_ENERGYPLUS_VARIABLES "variables.txt"
+
+/* Environment variable with the time step of the mock in seconds. The default is 600 seconds. */
+#define MOCK_ENERGYPLUS_TIME_STEP "MOCK_ENERGYPLUS_TIME_STEP"
+
+/* Name of the function that the mock calls for each call of an FMI function, if the executable
+   that loads the FMU exports a function with this name and type MockEnergyPlusCounter */
+#define MOCK_ENERGYPLUS_COUNTER "mockEnergyPlusCountCall"
+
+/* FMI functions that are counted */
+typedef enum {
+  mockInstantiate,
+  mockFreeInstance,
+  mockSetupExperiment,
+  mockEnterInitializationMode,
+  mockExitInitializationMode,
+  mockTerminate,
+  mockSetDebugLogging,
+  mockGetReal,
+  mockSetReal,
+  mockGetDirectionalDerivative,
+  mockEnterEventMode,
+  mockNewDiscreteStates,
+  mockEnterContinuousTimeMode,
+  mockCompletedIntegratorStep,
+  mockSetTime,
+  mockOther,
+  mockNFunctions
+} MockEnergyPlusFunction;
+
+/* Function that counts a call of fun, which got or set nValues values */
+typedef void (*MockEnergyPlusCounter)(MockEnergyPlusFunction fun, size_t nValues);
+
+#endif
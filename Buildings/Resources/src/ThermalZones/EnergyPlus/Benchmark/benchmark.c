@@ -0,0 +1,332 @@
+/*
+ * Benchmark of the Spawn exchange layer.
+ *
+ * This program calls the Modelica external functions of ModelicaBuildingsEnergyPlus
+ * for buildings with a given number of zones, schedules and output variables,
+ * in the pattern in which a Modelica simulator calls them: At each time step,
+ * and at each event time that is requested through tNext, the simulator evaluates
+ * the model several times, and each evaluation sets the schedules, exchanges data
+ * with all zones, and reads the output variables.
+ * The FMUs are generated by mockSpawn.py, hence EnergyPlus and spawn are not needed.
+ *
+ * The program reports for each exchange function the number of calls, the latency
+ * per call, and the number of calls of FMI functions per call. The FMI calls are
+ * counted by the mock of EnergyPlus through the exported function
+ * mockEnergyPlusCountCall, which requires the program to be linked with -rdynamic.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "MockEnergyPlus.h"
+
+#include "ZoneAllocate.h"
+#include "ZoneInstantiate.h"
+#include "ZoneExchange.h"
+#include "ZoneFree.h"
+#include "InputVariableAllocate.h"
+#include "InputVariableInstantiate.h"
+#include "InputVariableExchange.h"
+#include "InputVariableFree.h"
+#include "OutputVariableAllocate.h"
+#include "OutputVariableInstantiate.h"
+#include "OutputVariableExchange.h"
+#include "OutputVariableFree.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+
+#define BENCHMARK_NAME_LENGTH 256
+
+typedef enum {phaseInstantiate, phaseZone, phaseInput, phaseOutput, phaseFree, nPhases} BenchmarkPhase;
+
+static const char* BenchmarkPhaseNames[] = {"instantiate", "zone", "input", "output", "free"};
+
+static const char* MockFunctionNames[] = {
+  "fmi2Instantiate", "fmi2FreeInstance", "fmi2SetupExperiment",
+  "fmi2EnterInitializationMode", "fmi2ExitInitializationMode", "fmi2Terminate",
+  "fmi2SetDebugLogging", "fmi2GetReal", "fmi2SetReal", "fmi2GetDirectionalDerivative",
+  "fmi2EnterEventMode", "fmi2NewDiscreteStates", "fmi2EnterContinuousTimeMode",
+  "fmi2CompletedIntegratorStep", "fmi2SetTime", "other"};
+
+typedef struct BenchmarkStatistics{
+  size_t nCalls;      /* Number of calls of the exchange function */
+  double time;        /* Total wall clock time in seconds */
+  double timeMax;     /* Largest wall clock time of a call in seconds */
+  size_t nFMUCalls[mockNFunctions];  /* Number of calls of each FMI function */
+  size_t nFMUValues[mockNFunctions]; /* Number of values that have been got or set by each FMI function */
+} BenchmarkStatistics;
+
+static BenchmarkStatistics Benchmark_Statistics[nPhases];
+static BenchmarkPhase Benchmark_Phase = phaseInstantiate;
+
+/* Function that is called by the mock of EnergyPlus for each FMI call */
+void mockEnergyPlusCountCall(MockEnergyPlusFunction fun, size_t nValues){
+  Benchmark_Statistics[Benchmark_Phase].nFMUCalls[fun]++;
+  Benchmark_Statistics[Benchmark_Phase].nFMUValues[fun] += nValues;
+}
+
+static double getTime(){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1E-9 * (double)ts.tv_nsec;
+}
+
+static void startCall(BenchmarkPhase phase, double* t){
+  Benchmark_Phase = phase;
+  *t = getTime();
+}
+
+static void endCall(double t){
+  BenchmarkStatistics* sta = &(Benchmark_Statistics[Benchmark_Phase]);
+  const double dt = getTime() - t;
+
+  sta->nCalls++;
+  sta->time += dt;
+  if (dt > sta->timeMax)
+    sta->timeMax = dt;
+}
+
+static void spawnMessage(const char *string){
+  fputs(string, stdout);
+}
+
+static void spawnError(const char *string){
+  fprintf(stderr, "Error: %s\n", string);
+  exit(1);
+}
+
+static void spawnFormatMessage(const char *string, ...){
+  va_list args;
+  va_start(args, string);
+  vfprintf(stdout, string, args);
+  va_end(args);
+}
+
+static void spawnFormatError(const char *string, ...){
+  va_list args;
+  va_start(args, string);
+  fprintf(stderr, "Error: ");
+  vfprintf(stderr, string, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/* Write content to the file fileName */
+static void writeFile(const char* fileName, const char* content){
+  FILE* fp = fopen(fileName, "w");
+  if (fp == NULL || fputs(content, fp) < 0 || fclose(fp) != 0)
+    spawnFormatError("Failed to write %s.", fileName);
+}
+
+static void printUsage(const char* prg){
+  printf("Usage: %s [-b nBuildings] [-z nZones] [-i nInputs] [-o nOutputs] [-e tEnd] [-h step] [-n nEvaluations] [-l logLevel]\n", prg);
+  printf("  -b  Number of buildings (default 1)\n");
+  printf("  -z  Number of zones per building (default 10)\n");
+  printf("  -i  Number of schedules per building (default 2)\n");
+  printf("  -o  Number of output variables per building (default 2)\n");
+  printf("  -e  End time in seconds (default 86400)\n");
+  printf("  -h  Step of the simulator in seconds (default 60)\n");
+  printf("  -n  Number of evaluations of the model per step (default 2)\n");
+  printf("  -l  Log level of Spawn (default 1)\n");
+  printf("The environment variable MODELICA_BUILDINGS_SPAWN_EXECUTABLE must be the absolute name of mockSpawn.py.\n");
+}
+
+static void printStatistics(){
+  size_t p, f;
+  const BenchmarkStatistics* sta;
+
+  printf("%-12s %10s %12s %12s %14s %14s\n", "Exchange", "Calls", "Mean [us]", "Max [us]", "FMU calls/call", "Values/call");
+  for(p = 0; p < nPhases; p++){
+    size_t nFMUCalls = 0;
+    size_t nFMUValues = 0;
+    sta = &(Benchmark_Statistics[p]);
+    if (sta->nCalls == 0)
+      continue;
+    for(f = 0; f < mockNFunctions; f++){
+      nFMUCalls += sta->nFMUCalls[f];
+      nFMUValues += sta->nFMUValues[f];
+    }
+    printf("%-12s %10lu %12.3f %12.3f %14.3f %14.3f\n", BenchmarkPhaseNames[p], (unsigned long)sta->nCalls,
+      1E6 * sta->time / (double)sta->nCalls, 1E6 * sta->timeMax,
+      (double)nFMUCalls / (double)sta->nCalls, (double)nFMUValues / (double)sta->nCalls);
+  }
+  printf("\nFMU calls per call of the exchange function:\n");
+  for(p = 0; p < nPhases; p++){
+    sta = &(Benchmark_Statistics[p]);
+    if (sta->nCalls == 0)
+      continue;
+    printf("  %s:\n", BenchmarkPhaseNames[p]);
+    for(f = 0; f < mockNFunctions; f++){
+      if (sta->nFMUCalls[f] > 0)
+        printf("    %-30s %12.4f calls, %12.4f values\n", MockFunctionNames[f],
+          (double)sta->nFMUCalls[f] / (double)sta->nCalls, (double)sta->nFMUValues[f] / (double)sta->nCalls);
+    }
+  }
+}
+
+int main(int argc, char** argv){
+  size_t nBui = 1;
+  size_t nZon = 10;
+  size_t nInp = 2;
+  size_t nOut = 2;
+  double tEnd = 86400;
+  double h = 60;
+  int nEva = 2;
+  int logLevel = 1;
+  int opt;
+
+  char idfName[PATH_MAX];
+  char weaName[PATH_MAX];
+  char epwName[PATH_MAX];
+  char modelicaName[2*BENCHMARK_NAME_LENGTH]; /* Holds the name of the building and a suffix */
+  char modelicaNameBuilding[BENCHMARK_NAME_LENGTH];
+  char name[BENCHMARK_NAME_LENGTH];
+  char key[BENCHMARK_NAME_LENGTH];
+  const char* spawnExe = getenv("MODELICA_BUILDINGS_SPAWN_EXECUTABLE");
+
+  void** zones;
+  void** inputs;
+  void** outputs;
+  double* AFlo;
+  double V, mSenFac;
+  double TRad, QConSen_flow, dQConSen_flow, QLat_flow, QPeo_flow, y, tNext, tNextMin;
+  double t, T, tStart, tCall;
+  size_t i, nSteps;
+  int iEva;
+
+  while ((opt = getopt(argc, argv, "b:z:i:o:e:h:n:l:")) != -1){
+    switch(opt){
+      case 'b': nBui = (size_t)atol(optarg); break;
+      case 'z': nZon = (size_t)atol(optarg); break;
+      case 'i': nInp = (size_t)atol(optarg); break;
+      case 'o': nOut = (size_t)atol(optarg); break;
+      case 'e': tEnd = atof(optarg); break;
+      case 'h': h = atof(optarg); break;
+      case 'n': nEva = atoi(optarg); break;
+      case 'l': logLevel = atoi(optarg); break;
+      default:
+        printUsage(argv[0]);
+        return 1;
+    }
+  }
+  if (nBui == 0 || nZon == 0 || h <= 0 || nEva < 1){
+    printUsage(argv[0]);
+    return 1;
+  }
+  if (spawnExe == NULL){
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  /* The idf and weather files are not read by the mock, but they need to exist */
+  if (getcwd(idfName, sizeof(idfName) - 20) == NULL)
+    spawnFormatError("Failed to get the current working directory.");
+  strcpy(weaName, idfName);
+  strcpy(epwName, idfName);
+  strcat(idfName, "/benchmark.idf");
+  strcat(weaName, "/benchmark.mos");
+  strcat(epwName, "/benchmark.epw");
+  writeFile(idfName, "! Mock of an idf file for the benchmark of the Spawn exchange layer\n");
+  writeFile(weaName, "#1\n");
+  writeFile(epwName, "LOCATION,Mock\n");
+
+  zones = (void**)malloc(nBui * nZon * sizeof(void*));
+  inputs = (void**)malloc((nBui * nInp + 1) * sizeof(void*));
+  outputs = (void**)malloc((nBui * nOut + 1) * sizeof(void*));
+  AFlo = (double*)malloc(nBui * nZon * sizeof(double));
+  if (zones == NULL || inputs == NULL || outputs == NULL || AFlo == NULL)
+    spawnFormatError("Failed to allocate memory.");
+
+  /* Allocate and instantiate the objects */
+  tStart = getTime();
+  Benchmark_Phase = phaseInstantiate;
+  for(i = 0; i < nBui * nZon; i++){
+    snprintf(modelicaNameBuilding, sizeof(modelicaNameBuilding), "benchmark.bui%lu", (unsigned long)(i / nZon + 1));
+    snprintf(modelicaName, sizeof(modelicaName), "%s.zon%lu", modelicaNameBuilding, (unsigned long)(i % nZon + 1));
+    snprintf(name, sizeof(name), "Zone %lu", (unsigned long)(i % nZon + 1));
+    zones[i] = EnergyPlusZoneAllocate(modelicaNameBuilding, modelicaName, idfName, weaName, name,
+      0, "", "", logLevel, spawnMessage, spawnError, spawnFormatMessage, spawnFormatError);
+  }
+  for(i = 0; i < nBui * nInp; i++){
+    snprintf(modelicaNameBuilding, sizeof(modelicaNameBuilding), "benchmark.bui%lu", (unsigned long)(i / nInp + 1));
+    snprintf(modelicaName, sizeof(modelicaName), "%s.inp%lu", modelicaNameBuilding, (unsigned long)(i % nInp + 1));
+    snprintf(name, sizeof(name), "Schedule %lu", (unsigned long)(i % nInp + 1));
+    inputs[i] = EnergyPlusInputVariableAllocate(2, modelicaNameBuilding, modelicaName, idfName, weaName, name,
+      "", "", "1", 0, "", "", logLevel, spawnMessage, spawnError, spawnFormatMessage, spawnFormatError);
+  }
+  for(i = 0; i < nBui * nOut; i++){
+    snprintf(modelicaNameBuilding, sizeof(modelicaNameBuilding), "benchmark.bui%lu", (unsigned long)(i / nOut + 1));
+    snprintf(modelicaName, sizeof(modelicaName), "%s.out%lu", modelicaNameBuilding, (unsigned long)(i % nOut + 1));
+    snprintf(key, sizeof(key), "Zone %lu", (unsigned long)(i % nOut % nZon + 1));
+    snprintf(name, sizeof(name), "Zone Mean Air Temperature %lu", (unsigned long)(i % nOut + 1));
+    outputs[i] = EnergyPlusOutputVariableAllocate(modelicaNameBuilding, modelicaName, idfName, weaName, name, key,
+      0, "", "", logLevel, 0, spawnMessage, spawnError, spawnFormatMessage, spawnFormatError);
+  }
+  for(i = 0; i < nBui * nZon; i++)
+    EnergyPlusZoneInstantiate(zones[i], 0, &(AFlo[i]), &V, &mSenFac);
+  for(i = 0; i < nBui * nInp; i++)
+    EnergyPlusInputVariableInstantiate(inputs[i], 0);
+  for(i = 0; i < nBui * nOut; i++)
+    EnergyPlusOutputVariableInstantiate(outputs[i], 0);
+  printf("Instantiated %lu buildings in %.3f s.\n", (unsigned long)nBui, getTime() - tStart);
+
+  /* Simulate */
+  tStart = getTime();
+  t = 0;
+  nSteps = 0;
+  while (t <= tEnd){
+    tNextMin = t + h;
+    T = 293.15 + 2 * sin(2 * 3.14159265358979 * t / 86400);
+    for(iEva = 0; iEva < nEva; iEva++){
+      /* The first evaluation at the start time is the initial call */
+      const int initialCall = (nSteps == 0 && iEva == 0);
+      for(i = 0; i < nBui * nInp; i++){
+        startCall(phaseInput, &tCall);
+        EnergyPlusInputVariableExchange(inputs[i], initialCall, 0.5 + 0.1 * (double)iEva, t, &y);
+        endCall(tCall);
+      }
+      for(i = 0; i < nBui * nZon; i++){
+        startCall(phaseZone, &tCall);
+        /* Perturb the temperature at each evaluation as a Newton solver would do */
+        EnergyPlusZoneExchange(zones[i], initialCall, T + 1E-3 * (double)iEva, 0.008, 0.1, T, 10, AFlo[i], t,
+          &TRad, &QConSen_flow, &dQConSen_flow, &QLat_flow, &QPeo_flow, &tNext);
+        endCall(tCall);
+        if (tNext > t + 1E-6 && tNext < tNextMin)
+          tNextMin = tNext;
+      }
+      for(i = 0; i < nBui * nOut; i++){
+        startCall(phaseOutput, &tCall);
+        EnergyPlusOutputVariableExchange(outputs[i], initialCall, 0, t, &y, &tNext);
+        endCall(tCall);
+        if (tNext > t + 1E-6 && tNext < tNextMin)
+          tNextMin = tNext;
+      }
+    }
+    t = tNextMin;
+    nSteps++;
+  }
+  printf("Simulated %lu steps from 0 to %.0f s in %.3f s.\n\n", (unsigned long)nSteps, tEnd, getTime() - tStart);
+
+  Benchmark_Phase = phaseFree;
+  for(i = 0; i < nBui * nOut; i++)
+    EnergyPlusOutputVariableFree(outputs[i]);
+  for(i = 0; i < nBui * nInp; i++)
+    EnergyPlusInputVariableFree(inputs[i]);
+  for(i = 0; i < nBui * nZon; i++)
+    EnergyPlusZoneFree(zones[i]);
+
+  printStatistics();
+
+  free(zones);
+  free(inputs);
+  free(outputs);
+  free(AFlo);
+  return 0;
+}
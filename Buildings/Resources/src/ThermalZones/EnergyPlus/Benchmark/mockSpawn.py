@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+#######################################################
+# Script that replaces spawn to generate an FMU with
+# the mock of EnergyPlus, for benchmarks of the
+# Spawn exchange layer.
+#
+# The script takes the same arguments as spawn, i.e.,
+#   mockSpawn.py [--no-compress] --output-path FMU --create JSON
+# and writes an FMU with the variables that are
+# requested in the json file. The FMU contains the
+# library MockEnergyPlus.so, which is searched in
+# the environment variable MOCK_ENERGYPLUS_LIBRARY
+# and then in the directory of this script.
+#
+# To use it, set
+#   export MODELICA_BUILDINGS_SPAWN_EXECUTABLE=/abs/path/mockSpawn.py
+#
+# agent                                 10/19/2026
+#######################################################
+import argparse
+import hashlib
+import json
+import os
+import sys
+import zipfile
+from xml.sax.saxutils import quoteattr
+
+MODEL_IDENTIFIER = "MockEnergyPlus"
+
+# Units of the zone variables, as used by EnergyPlus
+ZONE_PARAMETERS = [("V", "m3"), ("AFlo", "m2"), ("mSenFac", "1")]
+ZONE_INPUTS = [("T", "degC"), ("X", "1"), ("mInlets_flow", "kg/s"),
+               ("TAveInlet", "degC"), ("QGaiRad_flow", "W")]
+ZONE_OUTPUTS = [("TRad", "degC"), ("QConSen_flow", "W"),
+                ("QLat_flow", "W"), ("QPeo_flow", "W")]
+
+# Base units, factor and offset of the units that the mock declares.
+# Other units are declared without base unit.
+UNITS = {
+    "1": ({}, 1, 0),
+    "K": ({"K": 1}, 1, 0),
+    "degC": ({"K": 1}, 1, 273.15),
+    "W": ({"kg": 1, "m": 2, "s": -3}, 1, 0),
+    "W/m2": ({"kg": 1, "s": -3}, 1, 0),
+    "kg/s": ({"kg": 1, "s": -1}, 1, 0),
+    "m2": ({"m": 2}, 1, 0),
+    "m3": ({"m": 3}, 1, 0),
+    "m3/s": ({"m": 3, "s": -1}, 1, 0),
+    "Pa": ({"kg": 1, "m": -1, "s": -2}, 1, 0),
+}
+
+
+def get_library():
+    lib = os.environ.get("MOCK_ENERGYPLUS_LIBRARY")
+    if lib is None:
+        lib = os.path.join(os.path.dirname(os.path.realpath(__file__)), MODEL_IDENTIFIER + ".so")
+    if not os.path.isfile(lib):
+        raise IOError("Library '{}' does not exist. Run make in {}.".format(
+            lib, os.path.dirname(os.path.realpath(__file__))))
+    return lib
+
+
+def get_variables(model):
+    """ Return the list of variables as tuples (name, causality, unit, role, index),
+        in the order of their value references, and the number of zones, inputs and outputs.
+    """
+    var = []
+    zones = model.get("zones", [])
+    for iZon, zon in enumerate(zones):
+        for nam, uni in ZONE_PARAMETERS:
+            var.append(("{}_{}".format(zon["name"], nam), "calculatedParameter", uni, nam, iZon))
+        for nam, uni in ZONE_INPUTS:
+            var.append(("{}_{}".format(zon["name"], nam), "input", uni, nam, iZon))
+        for nam, uni in ZONE_OUTPUTS:
+            var.append(("{}_{}".format(zon["name"], nam), "output", uni, nam, iZon))
+
+    inputs = model.get("schedules", []) + model.get("emsActuators", [])
+    for iInp, inp in enumerate(inputs):
+        var.append((inp["fmiName"], "input", inp.get("unit", "1"), "input", iInp))
+
+    outputs = model.get("outputVariables", [])
+    for iOut, out in enumerate(outputs):
+        var.append((out["fmiName"], "output", "1", "output", iOut))
+    return var, len(zones), len(inputs), len(outputs)
+
+
+def get_unit_definitions(units):
+    lines = ["  <UnitDefinitions>"]
+    for uni in sorted(units):
+        lines.append("    <Unit name={}>".format(quoteattr(uni)))
+        if uni in UNITS:
+            bas, fac, off = UNITS[uni]
+            attrs = "".join(' {}="{}"'.format(k, v) for k, v in sorted(bas.items()))
+            lines.append('      <BaseUnit{} factor="{}" offset="{}"/>'.format(attrs, fac, off))
+        lines.append("    </Unit>")
+    lines.append("  </UnitDefinitions>")
+    return lines
+
+
+def get_model_description(var, guid):
+    lines = ['<?xml version="1.0" encoding="UTF-8"?>',
+             '<fmiModelDescription fmiVersion="2.0" modelName="{}" guid="{}"'.format(MODEL_IDENTIFIER, guid),
+             '  generationTool="mockSpawn.py" variableNamingConvention="flat" numberOfEventIndicators="0">',
+             '  <ModelExchange modelIdentifier="{}" providesDirectionalDerivative="true"'.format(MODEL_IDENTIFIER),
+             '    canGetAndSetFMUstate="false" canSerializeFMUstate="false"/>']
+    lines += get_unit_definitions(set(v[2] for v in var))
+    lines.append("  <ModelVariables>")
+    for valRef, (nam, cau, uni, _, _) in enumerate(var):
+        if cau == "input":
+            start = ' start="20"' if uni == "degC" else ' start="0"'
+            lines.append('    <ScalarVariable name={} valueReference="{}" causality="input" variability="continuous">'.format(
+                quoteattr(nam), valRef))
+        elif cau == "output":
+            start = ""
+            lines.append('    <ScalarVariable name={} valueReference="{}" causality="output" variability="continuous">'.format(
+                quoteattr(nam), valRef))
+        else:
+            start = ""
+            lines.append('    <ScalarVariable name={} valueReference="{}" causality="calculatedParameter" variability="fixed" initial="calculated">'.format(
+                quoteattr(nam), valRef))
+        lines.append('      <Real unit={}{}/>'.format(quoteattr(uni), start))
+        lines.append("    </ScalarVariable>")
+    lines.append("  </ModelVariables>")
+    lines.append("  <ModelStructure>")
+    outputs = [i + 1 for i, v in enumerate(var) if v[1] == "output"]
+    if len(outputs) > 0:
+        lines.append("    <Outputs>")
+        for idx in outputs:
+            lines.append('      <Unknown index="{}"/>'.format(idx))
+        lines.append("    </Outputs>")
+    lines.append("  </ModelStructure>")
+    lines.append("</fmiModelDescription>")
+    return "\n".join(lines) + "\n"
+
+
+def create_fmu(json_file, fmu_file, compress):
+    with open(json_file, "r") as f:
+        spec = json.load(f)
+    var, nZon, nInp, nOut = get_variables(spec.get("model", {}))
+
+    guid = hashlib.md5("\n".join("{} {}".format(v[0], v[1]) for v in var).encode("utf-8")).hexdigest()
+    table = ["{} {} {} {}".format(len(var), nZon, nInp, nOut)]
+    table += ["{} {} {}".format(valRef, v[3], v[4]) for valRef, v in enumerate(var)]
+
+    if os.path.dirname(fmu_file) != "":
+        os.makedirs(os.path.dirname(fmu_file), exist_ok=True)
+    mode = zipfile.ZIP_DEFLATED if compress else zipfile.ZIP_STORED
+    with zipfile.ZipFile(fmu_file, "w", mode) as z:
+        z.writestr("modelDescription.xml", get_model_description(var, guid))
+        z.writestr("resources/variables.txt", "\n".join(table) + "\n")
+        z.write(get_library(), "binaries/linux64/{}.so".format(MODEL_IDENTIFIER))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Generate an FMU with the mock of EnergyPlus.")
+    parser.add_argument("--no-compress", action="store_true", help="Do not compress the FMU.")
+    parser.add_argument("--output-path", required=True, help="Name of the FMU.")
+    parser.add_argument("--create", required=True, help="Json file with the model structure.")
+    args = parser.parse_args()
+    try:
+        create_fmu(args.create, args.output_path, not args.no_compress)
+    except Exception as e:
+        print("mockSpawn.py: {}".format(e), file=sys.stderr)
+        sys.exit(1)
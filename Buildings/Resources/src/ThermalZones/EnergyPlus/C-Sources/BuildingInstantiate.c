@@ -57,6 +57,31 @@ void closeJSONModelArrayBracket(
   }
 }
 
+/* Return the hash of the model structure json, and of the content of the idf and the weather file.
+   Hence, the hash changes if any of these files is edited, even if its name stays the same. */
+static char* getModelHash(const FMUBuilding* bui, const char* json){
+  FastHash ctx;
+  char idfHash[FAST_HASH_HEX_LENGTH+1];
+  char weaHash[FAST_HASH_HEX_LENGTH+1];
+  char* hash;
+
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  if (fastHashFileHex(bui->idfName, idfHash) != 0)
+    SpawnFormatError("%s: Failed to read '%s': %s.", bui->modelicaNameBuilding, bui->idfName, strerror(errno));
+  if (fastHashFileHex(bui->weather, weaHash) != 0)
+    SpawnFormatError("%s: Failed to read '%s': %s.", bui->modelicaNameBuilding, bui->weather, strerror(errno));
+
+  fastHashInit(&ctx);
+  fastHashUpdate(&ctx, json, strlen(json));
+  fastHashUpdate(&ctx, idfHash, FAST_HASH_HEX_LENGTH);
+  fastHashUpdate(&ctx, weaHash, FAST_HASH_HEX_LENGTH);
+
+  mallocString(FAST_HASH_HEX_LENGTH+1, "Failed to allocate memory for model hash.", &hash, SpawnFormatError);
+  fastHashFinal(&ctx, hash);
+  return hash;
+}
+
 void buildJSONModelStructureForEnergyPlus(
   const FMUBuilding* bui, char* *buffer, size_t* size, char** modelHash){
   size_t i;
@@ -175,7 +200,7 @@ void buildJSONModelStructureForEnergyPlus(
   /* Close json object for model */
   saveAppend(buffer, "  },\n", size, SpawnFormatError);
 
-  *modelHash = (char*)( cryptographicsHash(*buffer, bui->SpawnError) );
+  *modelHash = getModelHash(bui, *buffer);
 
     /* fmu */
   saveAppend(buffer, "  \"fmu\": {\n", size, SpawnFormatError);
@@ -228,56 +253,104 @@ void writeModelStructureForEnergyPlus(const FMUBuilding* bui, char** modelicaBui
   fclose(fp);
 }
 
+/* Load all variables of the FMU into a hash table that is indexed by the variable name.
+   The table uses open addressing and has at least twice as many slots as there are variables.
+*/
+void loadFMUVariableTable(FMUBuilding* bui, FMUVariableTable* tab){
+  fmi2_import_variable_list_t* vl;
+  const fmi2_value_reference_t* vrl;
+  size_t nv;
+  size_t iFMI;
+  size_t iSlo;
+  fmi2_import_variable_t* var;
+  fmi2_import_real_variable_t* varRea;
+  const char* name;
+
+  vl = fmi2_import_get_variable_list(bui->fmu, 0);
+  vrl = fmi2_import_get_value_referece_list(vl);
+  nv = fmi2_import_get_variable_list_size(vl);
+  tab->nSlots = 16;
+  while (tab->nSlots < 2*nv)
+    tab->nSlots *= 2;
+  tab->entries = (FMUVariableEntry*)calloc(tab->nSlots, sizeof(FMUVariableEntry));
+  if (tab->entries == NULL)
+    bui->SpawnFormatError("Failed to allocate memory for variable table of %s.", bui->fmuAbsPat);
+
+  for (iFMI = 0; iFMI < nv; iFMI++){
+    var = fmi2_import_get_variable(vl, iFMI);
+    name = fmi2_import_get_variable_name(var);
+    iSlo = hashString(name) & (tab->nSlots-1);
+    while (tab->entries[iSlo].name != NULL){
+      if (strcmp(tab->entries[iSlo].name, name) == 0)
+        break;
+      iSlo = (iSlo + 1) & (tab->nSlots-1);
+    }
+    if (tab->entries[iSlo].name != NULL)
+      continue; /* Keep the first variable with this name, as did the linear search */
+    varRea = fmi2_import_get_variable_as_real(var);
+    tab->entries[iSlo].name = name;
+    tab->entries[iSlo].valRef = vrl[iFMI];
+    /* If a unit is not specified in modelDescription.xml, then unit is NULL */
+    tab->entries[iSlo].unit = (varRea == NULL) ? NULL : fmi2_import_get_real_variable_unit(varRea);
+  }
+  /* The names are owned by the FMU, hence they remain valid after the list is freed */
+  fmi2_import_free_variable_list(vl);
+}
+
+/* Return the entry of the variable with name name, or NULL if the FMU has no such variable */
+const FMUVariableEntry* findFMUVariable(const FMUVariableTable* tab, const char* name){
+  size_t iSlo = hashString(name) & (tab->nSlots-1);
+  while (tab->entries[iSlo].name != NULL){
+    if (strcmp(tab->entries[iSlo].name, name) == 0)
+      return &(tab->entries[iSlo]);
+    iSlo = (iSlo + 1) & (tab->nSlots-1);
+  }
+  return NULL;
+}
+
+/* Set the value references, units and unit conversions of ptrSpawnReals.
+   The names of all variables that are not found are appended to missing.
+*/
 void setAttributesReal(
   FMUBuilding* bui,
-  fmi2_import_variable_list_t* varLis,
-  const fmi2_value_reference_t varValRef[],
-  const size_t nVar,
-  const spawnReals* ptrSpawnReals){
+  const FMUVariableTable* tab,
+  spawnReals* ptrSpawnReals,
+  char** missing,
+  size_t* missingLen){
 
   const char* fmuNam = bui->fmuAbsPat;
-  size_t iFMI;
-  fmi2_import_variable_t* var;
-  bool found;
+  const FMUVariableEntry* ent;
   size_t i;
 
   void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
   void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
 
   for(i = 0; i < ptrSpawnReals->n; i++){
-    found = false;
     if (bui->logLevel >= TIMESTEP)
-        SpawnFormatMessage("---- %s: Setting variable reference for %s.\n", bui->modelicaNameBuilding, bui->time, ptrSpawnReals->fmiNames[i]);
-
-    for (iFMI = 0; iFMI < nVar; iFMI++){
-      var = fmi2_import_get_variable(varLis, iFMI);
-      if (strcmp(ptrSpawnReals->fmiNames[i], fmi2_import_get_variable_name(var)) == 0){
-        /* Found the variable */
-        fmi2_import_real_variable_t* varRea = fmi2_import_get_variable_as_real(var);
-        ptrSpawnReals->units[i] = fmi2_import_get_real_variable_unit(varRea);
-        /* If a unit is not specified in modelDescription.xml, then unit is NULL */
-
-        if (ptrSpawnReals->units[i] == NULL){
-          SpawnFormatMessage("---- %s: Warning: Variable %s does not specify units in %s. It will not be converted to SI units.\n",
-            bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], fmuNam);
-        }
-
-        if (bui->logLevel >= MEDIUM){
-          if (ptrSpawnReals->units[i] == NULL)
-            SpawnFormatMessage("----f %s: Variable with name %s has no units and valRef= %d.\n", bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], varValRef[iFMI]);
-          else{
-            const char* unitName = fmi2_import_get_unit_name(ptrSpawnReals->units[i]); /* This is 'W', 'm2', etc. */
-            SpawnFormatMessage("---- %s: Variable with name %s has unit = %s and valRef= %d.\n", bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], unitName, varValRef[iFMI]);
-          }
-        }
-        ptrSpawnReals->valRefs[i] = varValRef[iFMI];
-        found = true;
-        break;
+        SpawnFormatMessage("---- %s: Setting variable reference for %s.\n", bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i]);
+
+    ent = findFMUVariable(tab, ptrSpawnReals->fmiNames[i]);
+    if (ent == NULL){
+      saveAppend(missing, "\n  ", missingLen, SpawnFormatError);
+      saveAppend(missing, ptrSpawnReals->fmiNames[i], missingLen, SpawnFormatError);
+      continue;
+    }
+    setUnitConversion(ptrSpawnReals, i, ent->unit);
+
+    if (ptrSpawnReals->units[i] == NULL){
+      SpawnFormatMessage("---- %s: Warning: Variable %s does not specify units in %s. It will not be converted to SI units.\n",
+        bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], fmuNam);
+    }
+
+    if (bui->logLevel >= MEDIUM){
+      if (ptrSpawnReals->units[i] == NULL)
+        SpawnFormatMessage("----f %s: Variable with name %s has no units and valRef= %d.\n", bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], ent->valRef);
+      else{
+        const char* unitName = fmi2_import_get_unit_name(ptrSpawnReals->units[i]); /* This is 'W', 'm2', etc. */
+        SpawnFormatMessage("---- %s: Variable with name %s has unit = %s and valRef= %d.\n", bui->modelicaNameBuilding, ptrSpawnReals->fmiNames[i], unitName, ent->valRef);
       }
     }
-    if (!found)
-      SpawnFormatError("%s: Failed to find variable %s in %s.", bui->modelicaNameBuilding,
-        ptrSpawnReals->fmiNames[i], fmuNam);
+    ptrSpawnReals->valRefs[i] = ent->valRef;
   }
 }
 
@@ -286,12 +359,16 @@ void setValueReferences(FMUBuilding* bui){
   FMUZone* zone;
   FMUInputVariable* inpVar;
   FMUOutputVariable* outVar;
-
-  fmi2_import_variable_list_t* vl = fmi2_import_get_variable_list(bui->fmu, 0);
-  const fmi2_value_reference_t* vrl = fmi2_import_get_value_referece_list(vl);
-  size_t nv = fmi2_import_get_variable_list_size(vl);
+  FMUVariableTable tab;
+  char* missing;
+  size_t missingLen = 1024;
 
   void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  loadFMUVariableTable(bui, &tab);
+  mallocString(missingLen, "Failed to allocate memory in setValueReferences().", &missing, SpawnFormatError);
+  memset(missing, '\0', missingLen);
 
   /* Set value references for the zones by assigning the values obtained from the FMU */
   if (bui->logLevel >= MEDIUM)
@@ -299,9 +376,9 @@ void setValueReferences(FMUBuilding* bui){
 
   for(i = 0; i < bui->nZon; i++){
     zone = (FMUZone*) bui->zones[i];
-    setAttributesReal(bui, vl, vrl, nv, zone->parameters);
-    setAttributesReal(bui, vl, vrl, nv, zone->inputs);
-    setAttributesReal(bui, vl, vrl, nv, zone->outputs);
+    setAttributesReal(bui, &tab, zone->parameters, &missing, &missingLen);
+    setAttributesReal(bui, &tab, zone->inputs, &missing, &missingLen);
+    setAttributesReal(bui, &tab, zone->outputs, &missing, &missingLen);
   }
 
   /* Set value references for the input variables by assigning the values obtained from the FMU */
@@ -310,7 +387,7 @@ void setValueReferences(FMUBuilding* bui){
 
   for(i = 0; i < bui->nInputVariables; i++){
     inpVar = (FMUInputVariable*) bui->inputVariables[i];
-    setAttributesReal(bui, vl, vrl, nv, inpVar->inputs);
+    setAttributesReal(bui, &tab, inpVar->inputs, &missing, &missingLen);
     inpVar->valueReferenceIsSet = true;
   }
 
@@ -320,35 +397,36 @@ void setValueReferences(FMUBuilding* bui){
 
   for(i = 0; i < bui->nOutputVariables; i++){
     outVar = (FMUOutputVariable*) bui->outputVariables[i];
-    setAttributesReal(bui, vl, vrl, nv, outVar->outputs);
+    setAttributesReal(bui, &tab, outVar->outputs, &missing, &missingLen);
     outVar->valueReferenceIsSet = true;
   }
 
-  /* Free the variable list */
-  fmi2_import_free_variable_list(vl);
+  free(tab.entries);
+
+  /* Report all variables that are not in the FMU at once */
+  if (strlen(missing) > 0)
+    SpawnFormatError("%s: Failed to find the following variables in %s:%s", bui->modelicaNameBuilding,
+      bui->fmuAbsPat, missing);
+  free(missing);
 
   return;
 }
 
-void generateFMU(FMUBuilding* bui, const char* modelicaBuildingsJsonFile){
-  /* Generate the FMU */
+/* Return the absolute name of the spawn executable, which needs to be freed by the caller */
+char* getSpawnExecutable(const FMUBuilding* bui){
   char* cmd;
-  char* optionFlags;
-  char* outputFlag;
-  char* createFlag;
-  char* fulCmd;
+  char* spawnExe;
   size_t len;
-  int retVal;
-
-  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
-  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+  const char* exe = getenv(SPAWN_EXECUTABLE);
 
-  if (bui->logLevel >= MEDIUM)
-    SpawnFormatMessage("---- %s: Entered generateFMU with FMUPath = %s.\n", bui->modelicaNameBuilding, bui->fmuAbsPat);
-
-  if( access(modelicaBuildingsJsonFile, F_OK ) == -1 ) {
-    SpawnFormatError("Requested to use json file '%s' which does not exist.", modelicaBuildingsJsonFile);
+  if (exe != NULL && strlen(exe) > 0){
+    if (bui->logLevel >= MEDIUM)
+      bui->SpawnFormatMessage("---- %s: Using executable %s set by %s.\n", bui->modelicaNameBuilding, exe, SPAWN_EXECUTABLE);
+    mallocString(strlen(exe)+1, "Failed to allocate memory in getSpawnExecutable().", &spawnExe, bui->SpawnFormatError);
+    strcpy(spawnExe, exe);
+    return spawnExe;
   }
+
 #ifdef _WIN32 /* Win32 or Win64 */
   cmd = "/Resources/bin/spawn-win64/bin/spawn.exe";
 #elif __APPLE__
@@ -356,58 +434,15 @@ void generateFMU(FMUBuilding* bui, const char* modelicaBuildingsJsonFile){
 #else
   cmd = "/Resources/bin/spawn-linux64/bin/spawn";
 #endif
-  optionFlags = " --no-compress "; /* Flag for command */
-  outputFlag = " --output-path "; /* Flag for command */
-  createFlag = " --create "; /* Flag for command */
-  len = strlen(bui->buildingsLibraryRoot) + strlen(cmd) + strlen(optionFlags)
-    + strlen(outputFlag) + strlen("\"") + strlen(bui->fmuAbsPat) + strlen("\"")
-    + strlen(createFlag) + strlen("\"") + strlen(modelicaBuildingsJsonFile) + strlen("\"")
-    + 1;
-
-  mallocString(len, "Failed to allocate memory in generateFMU().", &fulCmd, SpawnFormatError);
-  memset(fulCmd, '\0', len);
-  strcpy(fulCmd, bui->buildingsLibraryRoot); /* This is for example /mtn/shared/Buildings */
-  strcat(fulCmd, cmd);
-  /* Check if the executable exists
-     Linux return 0, and Windows returns 2 if file does not exist */
-  if( access(fulCmd, F_OK ) != 0 ) {
-    SpawnFormatError("Executable '%s' does not exist: '%s'.", fulCmd, strerror(errno));
-  }
-  /* Make sure the file is executable */
-  /* Windows has no mode X_OK = 1, see https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/access-waccess?view=vs-2019 */
-#ifndef _WIN32
-  if( access(fulCmd, X_OK ) != 0 ) {
-    SpawnFormatError("File '%s' exists, but fails to have executable flag set: '%s.", fulCmd, strerror(errno));
-  }
-#endif
-  /* Continue building the command line */
-  strcat(fulCmd, optionFlags);
-  strcat(fulCmd, outputFlag);
-  strcat(fulCmd, "\"");
-  strcat(fulCmd, bui->fmuAbsPat);
-  strcat(fulCmd, "\"");
-  strcat(fulCmd, createFlag);
-  strcat(fulCmd, "\"");
-  strcat(fulCmd, modelicaBuildingsJsonFile);
-  strcat(fulCmd, "\"");
-
-  /* Generate the FMU */
-  if (bui->logLevel >= MEDIUM)
-    SpawnFormatMessage("---- %s: Executing %s\n", bui->modelicaNameBuilding, fulCmd);
+  len = strlen(bui->buildingsLibraryRoot) + strlen(cmd) + 1;
 
-  retVal = system(fulCmd);
-  /* Check if generated FMU indeed exists */
-  if( access( bui->fmuAbsPat, F_OK ) != 0 ) {
-    SpawnFormatError("Executing '%s' failed to generate fmu '%s'.", fulCmd, bui->fmuAbsPat);
-  }
-  if (retVal != 0){
-    fprintf(stdout, "*** Warning: Generating FMU returned value %d, but FMU exists.\n", retVal);
-/*    SpawnFormatError("Generating FMU failed using command '%s', return value %d.", fulCmd, retVal);*/
-  }
-  free(fulCmd);
+  mallocString(len, "Failed to allocate memory in getSpawnExecutable().", &spawnExe, bui->SpawnFormatError);
+  memset(spawnExe, '\0', len);
+  strcpy(spawnExe, bui->buildingsLibraryRoot); /* This is for example /mtn/shared/Buildings */
+  strcat(spawnExe, cmd);
+  return spawnExe;
 }
 
-
 /* Set the categories to be logged.
    Note that EnergyPlus has the following levels:
       std::map<EnergyPlus::Error, fmi2Status> logLevelMap = {
@@ -535,9 +570,19 @@ void importEnergyPlusFMU(FMUBuilding* bui){
     SpawnFormatMessage("---- %s: Calling fmi_import_allocate_context(callbacks = %p)\n", bui->modelicaNameBuilding, callbacks);
   bui->context = fmi_import_allocate_context(callbacks);
 
-  if (bui->logLevel >= MEDIUM)
-    SpawnFormatMessage("---- %s: Getting fmi version, FMUPath = %s, tmpPath = %s.\n", bui->modelicaNameBuilding, FMUPath, tmpPath);
-  version = fmi_import_get_fmi_version(bui->context, FMUPath, tmpPath);
+  /* Skip the unzip if tmpPath contains the files of a byte-identical FMU */
+  if (isFMUUnpacked(bui)){
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Using FMU that is already unpacked in %s.\n", bui->modelicaNameBuilding, tmpPath);
+    /* The version has been checked when the FMU was unpacked */
+    version = fmi_version_2_0_enu;
+  }
+  else{
+    setFMUUnpacked(bui, false);
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Getting fmi version, FMUPath = %s, tmpPath = %s.\n", bui->modelicaNameBuilding, FMUPath, tmpPath);
+    version = fmi_import_get_fmi_version(bui->context, FMUPath, tmpPath);
+  }
 
   if (version != fmi_version_2_0_enu){
     SpawnFormatError("Wrong FMU version for %s, require FMI 2.0 for Model Exchange, received %s.",
@@ -558,6 +603,7 @@ void importEnergyPlusFMU(FMUBuilding* bui){
   if(fmukind != fmi2_fmu_kind_me){
     SpawnFormatError("Unxepected FMU kind for %s, require ME.", FMUPath);
   }
+  setFMUUnpacked(bui, true);
 
   /* Get model statistics
   fmi2_import_collect_model_counts(bui->fmu, &mc);
@@ -602,26 +648,6 @@ void importEnergyPlusFMU(FMUBuilding* bui){
   setFMUDebugLevel(bui);
 }
 
-void setReusableFMU(FMUBuilding* bui){
-  size_t iBui;
-  FMUBuilding* ptrBui;
-
-  for(iBui = 0; iBui < getBuildings_nFMU(); iBui++){
-    ptrBui = (FMUBuilding*)(getBuildingsFMU(iBui));
-    if ((iBui != bui->iFMU) && (ptrBui->modelHash != NULL)){
-      if (strcmp(bui->modelHash, ptrBui->modelHash) == 0 ){
-        /* Check if the FMU indeed was generated */
-        if( access( ptrBui->fmuAbsPat, F_OK ) != -1 ) {
-          /* We can use the same FMU as will be used for building iBui */
-          bui->usePrecompiledFMU = true;
-          bui->precompiledFMUAbsPat = ptrBui->fmuAbsPat;
-        }
-      }
-    }
-  }
-}
-
-
 int deleteFile(const char* fileName){
   /* Remove file if it exists */
   if (access(fileName, F_OK) == 0) {
@@ -674,40 +700,145 @@ void copyBinaryFile(
   }
 
 
-void generateAndInstantiateBuilding(FMUBuilding* bui){
-  /* This is the first call for this idf file.
-     Allocate memory and load the fmu.
-  */
+/* Write the model structure of the building, and copy its FMU or add a job to generate it.
+   Buildings with the same model hash share one job, which is run by runSpawnJobs().
+*/
+void prepareFMU(FMUBuilding* bui){
   char* modelicaBuildingsJsonFile;
+  const char* cacheDir;
+  char* cacheKey = NULL;
+  char* spawnExe;
+  SpawnJob* job;
 
   void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
   void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
 
-  if (bui->logLevel >= MEDIUM)
-    SpawnFormatMessage("---- %s: Entered EnergyPlusZoneAllocateAndInstantiateBuilding.\n", bui->modelicaNameBuilding);
-
-  if (bui->usePrecompiledFMU)
-    SpawnFormatMessage("---- %s: Using pre-compiled FMU %s\n", bui->modelicaNameBuilding, bui->precompiledFMUAbsPat);
-
   /* Write the model structure to the FMU Resources folder so that EnergyPlus can
      read it and set up the data structure.
   */
   writeModelStructureForEnergyPlus(bui, &modelicaBuildingsJsonFile, &(bui->modelHash));
 
-  setReusableFMU(bui);
-
   if ( deleteFile(bui->fmuAbsPat) != 0 )
     SpawnFormatError("Failed to remove old FMU '%s': '%s'.", bui->fmuAbsPat, strerror(errno));
 
   if (bui->usePrecompiledFMU){
     if (bui->logLevel >= MEDIUM)
-      SpawnFormatMessage("---- %s: Copying FMU %s to %s as buildings are identical.\n", bui->modelicaNameBuilding, bui->precompiledFMUAbsPat, bui->fmuAbsPat);
+      SpawnFormatMessage("---- %s: Copying FMU %s to %s.\n", bui->modelicaNameBuilding, bui->precompiledFMUAbsPat, bui->fmuAbsPat);
     copyBinaryFile(bui->precompiledFMUAbsPat, bui->fmuAbsPat, SpawnFormatError);
+    free(modelicaBuildingsJsonFile);
+    return;
+  }
+
+  /* Reuse the job of a building with the same model structure */
+  bui->spawnJob = findSpawnJob(bui->modelHash);
+  if (bui->spawnJob != NULL){
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Using FMU of %s as buildings are identical.\n",
+        bui->modelicaNameBuilding, ((SpawnJob*)bui->spawnJob)->bui->modelicaNameBuilding);
+    free(modelicaBuildingsJsonFile);
+    return;
+  }
+
+  spawnExe = getSpawnExecutable(bui);
+  /* Use the FMU from the persistent cache if it has been generated by an earlier simulation */
+  cacheDir = getFMUCacheDirectory();
+  if (cacheDir != NULL){
+    cacheKey = getFMUCacheKey(bui, spawnExe);
+    if (cacheKey != NULL && getFMUFromCache(bui, cacheDir, cacheKey)){
+      free(cacheKey);
+      free(spawnExe);
+      free(modelicaBuildingsJsonFile);
+      return;
+    }
   }
-  else
-    generateFMU(bui, modelicaBuildingsJsonFile);
 
+  if (bui->logLevel >= MEDIUM)
+    SpawnFormatMessage("---- %s: Adding job to generate FMU %s.\n", bui->modelicaNameBuilding, bui->fmuAbsPat);
+
+  if( access(modelicaBuildingsJsonFile, F_OK ) == -1 ) {
+    SpawnFormatError("Requested to use json file '%s' which does not exist.", modelicaBuildingsJsonFile);
+  }
+  /* Check if the executable exists
+     Linux return 0, and Windows returns 2 if file does not exist */
+  if( access(spawnExe, F_OK ) != 0 ) {
+    SpawnFormatError("Executable '%s' does not exist: '%s'.", spawnExe, strerror(errno));
+  }
+  /* Make sure the file is executable */
+  /* Windows has no mode X_OK = 1, see https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/access-waccess?view=vs-2019 */
+#ifndef _WIN32
+  if( access(spawnExe, X_OK ) != 0 ) {
+    SpawnFormatError("File '%s' exists, but fails to have executable flag set: '%s.", spawnExe, strerror(errno));
+  }
+#endif
+  /* The job takes ownership of cacheKey */
+  job = addSpawnJob(bui, spawnExe, modelicaBuildingsJsonFile, cacheKey);
+  bui->spawnJob = job;
+
+  free(spawnExe);
   free(modelicaBuildingsJsonFile);
+}
+
+/* Wait for the FMU of the building to be generated, and copy it if it has been generated for another building */
+void waitForFMU(FMUBuilding* bui){
+  SpawnJob* job = (SpawnJob*)bui->spawnJob;
+
+  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  if (bui->logLevel >= MEDIUM)
+    SpawnFormatMessage("---- %s: Waiting for FMU %s.\n", bui->modelicaNameBuilding, job->fmuAbsPat);
+
+  waitForSpawnJob(job, SpawnFormatError);
+
+  /* Check if generated FMU indeed exists */
+  if( access( job->fmuAbsPat, F_OK ) != 0 ) {
+    SpawnFormatError("Executing '%s' failed to generate fmu '%s', return value %d.", job->argv[0], job->fmuAbsPat, job->retVal);
+  }
+  if (job->retVal != 0){
+    SpawnFormatMessage("---- %s: Warning: Generating FMU returned value %d, but FMU exists.\n", bui->modelicaNameBuilding, job->retVal);
+  }
+  if (job->cacheKey != NULL){
+    addFMUToCache(job->bui, getFMUCacheDirectory(), job->cacheKey);
+    free(job->cacheKey);
+    job->cacheKey = NULL;
+  }
+  if (job->bui != bui){
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Copying FMU %s to %s as buildings are identical.\n", bui->modelicaNameBuilding, job->fmuAbsPat, bui->fmuAbsPat);
+    copyBinaryFile(job->fmuAbsPat, bui->fmuAbsPat, SpawnFormatError);
+  }
+  bui->spawnJob = NULL;
+}
+
+void generateAndInstantiateBuilding(FMUBuilding* bui){
+  /* This is the first call for this idf file.
+     Allocate memory and load the fmu.
+  */
+  size_t iBui;
+  FMUBuilding* ptrBui;
+
+  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  if (bui->logLevel >= MEDIUM)
+    SpawnFormatMessage("---- %s: Entered EnergyPlusZoneAllocateAndInstantiateBuilding.\n", bui->modelicaNameBuilding);
+
+  if (bui->usePrecompiledFMU)
+    SpawnFormatMessage("---- %s: Using pre-compiled FMU %s\n", bui->modelicaNameBuilding, bui->precompiledFMUAbsPat);
+
+  /* All buildings have been constructed when the first of them is instantiated.
+     Prepare the FMUs of all buildings that have not yet been prepared, so that
+     the spawn jobs of all buildings run concurrently.
+  */
+  for(iBui = 0; iBui < getBuildings_nFMU(); iBui++){
+    ptrBui = (FMUBuilding*)(getBuildingsFMU(iBui));
+    if (ptrBui->modelHash == NULL)
+      prepareFMU(ptrBui);
+  }
+  runSpawnJobs(SpawnFormatError);
+
+  if (bui->spawnJob != NULL)
+    waitForFMU(bui);
 
   if( access( bui->fmuAbsPat, F_OK ) == -1 ) {
     SpawnFormatError("Requested to load fmu '%s' which does not exist.", bui->fmuAbsPat);
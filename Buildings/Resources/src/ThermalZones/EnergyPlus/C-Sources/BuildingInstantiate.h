@@ -9,7 +9,9 @@
 #include "EnergyPlusTypes.h"
 #include "EnergyPlusFMU.h"
 #include "EnergyPlusUtil.h"
-#include "cryptographicsHash.h"
+#include "fastHash.h"
+#include "FMUCache.h"
+#include "SpawnJobs.h"
 
 #include <stdio.h>
 #ifdef _MSC_VER
@@ -22,10 +24,33 @@
 #include "fmilib.h"
 #include "JM/jm_portability.h"
 
+/* Environment variable with the absolute name of an executable that is used instead of spawn,
+   such as the mock of EnergyPlus in Resources/src/ThermalZones/EnergyPlus/Benchmark */
+#define SPAWN_EXECUTABLE "MODELICA_BUILDINGS_SPAWN_EXECUTABLE"
+
 void buildJSONKeyValue(
     char* *buffer, size_t level, const char* key, const char* value, bool addComma, size_t* size,
     void (*SpawnFormatError)(const char *string, ...));
 
+/* Entry of the table with all variables of the FMU */
+typedef struct FMUVariableEntry{
+  const char* name; /* Name of the variable, or NULL if the slot is empty */
+  fmi2_value_reference_t valRef; /* Value reference */
+  fmi2_import_unit_t* unit; /* Unit, or NULL if not specified */
+} FMUVariableEntry;
+
+/* Hash table with all variables of the FMU, indexed by their name */
+typedef struct FMUVariableTable{
+  size_t nSlots; /* Number of slots, which is a power of 2 */
+  FMUVariableEntry* entries; /* Slots of the table */
+} FMUVariableTable;
+
+void loadFMUVariableTable(FMUBuilding* bui, FMUVariableTable* tab);
+
+const FMUVariableEntry* findFMUVariable(const FMUVariableTable* tab, const char* name);
+
+char* getSpawnExecutable(const FMUBuilding* bui);
+
 void generateAndInstantiateBuilding(FMUBuilding* bui);
 
 #endif
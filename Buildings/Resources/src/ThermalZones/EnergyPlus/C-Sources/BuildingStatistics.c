@@ -0,0 +1,357 @@
+/*
+ * Counters of the data exchange with the EnergyPlus FMU of a building.
+ *
+ * If MODELICA_BUILDINGS_SPAWN_STATISTICS is set to a directory, each building counts
+ * the calls of the FMU functions, the values that are set and got, the event iterations,
+ * the time advances, and the calls of the exchange functions of its zones, input variables
+ * and output variables, together with the wall clock time spent in them.
+ * When the building is freed, the statistics are written to the file
+ * <modelicaNameBuilding>.json in this directory. If MODELICA_BUILDINGS_SPAWN_STATISTICS_INTERVAL
+ * is set, the statistics are in addition appended to <modelicaNameBuilding>.jsonl, with
+ * one line per interval of simulated time.
+ * The wall clock time of the exchange functions that is not spent in the FMU is reported
+ * as the time of the exchange layer.
+ *
+ * If the environment variable is not set, the counters are not allocated and each
+ * counting function only tests for a null pointer.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "BuildingStatistics.h"
+#include "EnergyPlusUtil.h"
+
+#ifndef Buildings_BuildingStatistics_c
+#define Buildings_BuildingStatistics_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+
+static const char* StatisticsFunctionNames[] = {
+  "fmi2SetReal",
+  "fmi2GetReal",
+  "fmi2GetDirectionalDerivative",
+  "fmi2NewDiscreteStates",
+  "fmi2EnterContinuousTimeMode",
+  "fmi2SetTime",
+  "fmi2CompletedIntegratorStep",
+  "fmi2EnterEventMode",
+  "fmi2EnterInitializationMode",
+  "fmi2ExitInitializationMode"};
+
+static const char* StatisticsExchangeNames[] = {
+  "zone",
+  "inputVariable",
+  "outputVariable"};
+
+typedef struct BuildingStatistics{
+  size_t nFMUCalls[statisticsNFunctions];    /* Number of calls of each FMU function */
+  size_t nFMUValues[statisticsNFunctions];   /* Number of values that are set or got by each FMU function */
+  double timeFMU[statisticsNFunctions];      /* Wall clock time spent in each FMU function */
+  double timeFMUInExchange;                  /* Wall clock time spent in FMU functions during completed calls of exchange functions */
+  double timeFMUInRunningExchange;           /* Wall clock time spent in FMU functions during the running exchange function */
+
+  size_t nExchanges[statisticsNExchanges];   /* Number of calls of each exchange function */
+  double timeExchanges[statisticsNExchanges];/* Wall clock time spent in each exchange function */
+  bool inExchange;                           /* Flag, true while an exchange function runs */
+
+  size_t nEventIterations;                   /* Number of event iterations */
+  size_t nEventIterationsReused;             /* Number of event iterations whose result has been reused */
+  size_t nEventIterationLoops;               /* Number of loops of all event iterations */
+  size_t nTimeAdvances;                      /* Number of time advances */
+
+  size_t nZon;                               /* Number of zones, or 0 before the first zone exchange */
+  char** zoneNames;                          /* Modelica instance names of the zones */
+  size_t* nZoneExchanges;                    /* Number of exchanges of each zone */
+  double* timeZoneExchanges;                 /* Wall clock time spent in the exchanges of each zone */
+
+  char* directory;                           /* Directory to which the statistics are written */
+  double sampleInterval;                     /* Interval of simulated time between samples, or 0 if not sampled */
+  double tSample;                            /* Time of the next sample */
+  FILE* samples;                             /* File to which the samples are written, or NULL */
+  bool sampleFailed;                         /* Flag, true if the samples cannot be written */
+} BuildingStatistics;
+
+static double getWallClockTime(){
+#ifdef _WIN32
+  LARGE_INTEGER cou;
+  LARGE_INTEGER fre;
+  QueryPerformanceCounter(&cou);
+  QueryPerformanceFrequency(&fre);
+  return (double)cou.QuadPart/(double)fre.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1E-9*(double)ts.tv_nsec;
+#endif
+}
+
+/* Allocate the statistics of the building if they are requested */
+void allocateStatistics(FMUBuilding* bui){
+  const char* dir = getenv(SPAWN_STATISTICS);
+  const char* str = getenv(SPAWN_STATISTICS_INTERVAL);
+  BuildingStatistics* sta;
+  char* endptr;
+
+  bui->statistics = NULL;
+  if (dir == NULL || strlen(dir) == 0)
+    return;
+
+  sta = (BuildingStatistics*)calloc(1, sizeof(BuildingStatistics));
+  if (sta == NULL)
+    bui->SpawnFormatError("Failed to allocate memory for statistics of %s.", bui->modelicaNameBuilding);
+  mallocString(strlen(dir)+1, "Failed to allocate memory for statistics directory.", &(sta->directory), bui->SpawnFormatError);
+  strcpy(sta->directory, dir);
+
+  if (str != NULL && strlen(str) > 0){
+    sta->sampleInterval = strtod(str, &endptr);
+    if (*endptr != '\0' || !(sta->sampleInterval > 0))
+      bui->SpawnFormatError("Environment variable %s must be a positive number, received '%s'.", SPAWN_STATISTICS_INTERVAL, str);
+  }
+  sta->tSample = 0;
+  bui->statistics = sta;
+}
+
+/* Return the wall clock time if statistics are collected, or 0 otherwise */
+double startStatistics(const FMUBuilding* bui){
+  return (bui->statistics == NULL) ? 0 : getWallClockTime();
+}
+
+/* Start the statistics of a call of an exchange function */
+double startExchangeStatistics(FMUBuilding* bui){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+  if (sta == NULL)
+    return 0;
+  sta->inExchange = true;
+  sta->timeFMUInRunningExchange = 0;
+  return getWallClockTime();
+}
+
+/* Add a call of the FMU function fun that set or got nValues values and started at tStart */
+void addFMUCallStatistics(FMUBuilding* bui, StatisticsFunction fun, size_t nValues, double tStart){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+  double dt;
+
+  if (sta == NULL)
+    return;
+  dt = getWallClockTime() - tStart;
+  sta->nFMUCalls[fun]++;
+  sta->nFMUValues[fun] += nValues;
+  sta->timeFMU[fun] += dt;
+  if (sta->inExchange)
+    sta->timeFMUInRunningExchange += dt;
+}
+
+/* Add an event iteration, which either reused the previous result or ran nLoops loops */
+void addEventIterationStatistics(FMUBuilding* bui, bool reused, size_t nLoops){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+
+  if (sta == NULL)
+    return;
+  if (reused)
+    sta->nEventIterationsReused++;
+  else{
+    sta->nEventIterations++;
+    sta->nEventIterationLoops += nLoops;
+  }
+}
+
+/* Write the string str with the characters that need to be escaped in json */
+static void writeJSONString(FILE* fp, const char* str){
+  const char* p;
+
+  fputc('"', fp);
+  for(p = str; *p != '\0'; p++){
+    if (*p == '"' || *p == '\\')
+      fprintf(fp, "\\%c", *p);
+    else if ((unsigned char)*p < 0x20)
+      fprintf(fp, "\\u%04x", (unsigned int)(unsigned char)*p);
+    else
+      fputc(*p, fp);
+  }
+  fputc('"', fp);
+}
+
+/* Write the statistics as a json object. If compact is true, it is written on one line */
+static void writeStatistics(FILE* fp, const FMUBuilding* bui, const BuildingStatistics* sta, bool compact){
+  const char* nl = compact ? "" : "\n";
+  const char* in1 = compact ? "" : "  ";
+  const char* in2 = compact ? "" : "    ";
+  double timeFMU = 0;
+  double timeExchanges = 0;
+  size_t i;
+
+  for(i = 0; i < statisticsNFunctions; i++)
+    timeFMU += sta->timeFMU[i];
+  for(i = 0; i < statisticsNExchanges; i++)
+    timeExchanges += sta->timeExchanges[i];
+
+  fprintf(fp, "{%s%s\"building\": ", nl, in1);
+  writeJSONString(fp, bui->modelicaNameBuilding);
+  fprintf(fp, ",%s%s\"time\": %.17g,%s", nl, in1, bui->time, nl);
+
+  fprintf(fp, "%s\"wallTime\": {%s", in1, nl);
+  fprintf(fp, "%s\"exchanges\": %.9g,%s", in2, timeExchanges, nl);
+  fprintf(fp, "%s\"fmu\": %.9g,%s", in2, timeFMU, nl);
+  fprintf(fp, "%s\"fmuInExchanges\": %.9g,%s", in2, sta->timeFMUInExchange, nl);
+  fprintf(fp, "%s\"exchangeLayer\": %.9g%s", in2, timeExchanges - sta->timeFMUInExchange, nl);
+  fprintf(fp, "%s},%s", in1, nl);
+
+  fprintf(fp, "%s\"exchanges\": {%s", in1, nl);
+  for(i = 0; i < statisticsNExchanges; i++)
+    fprintf(fp, "%s\"%s\": {\"calls\": %lu, \"wallTime\": %.9g}%s%s", in2, StatisticsExchangeNames[i],
+      (unsigned long)sta->nExchanges[i], sta->timeExchanges[i], (i+1 < statisticsNExchanges) ? "," : "", nl);
+  fprintf(fp, "%s},%s", in1, nl);
+
+  fprintf(fp, "%s\"fmuCalls\": {%s", in1, nl);
+  for(i = 0; i < statisticsNFunctions; i++)
+    fprintf(fp, "%s\"%s\": {\"calls\": %lu, \"values\": %lu, \"wallTime\": %.9g}%s%s", in2, StatisticsFunctionNames[i],
+      (unsigned long)sta->nFMUCalls[i], (unsigned long)sta->nFMUValues[i], sta->timeFMU[i],
+      (i+1 < statisticsNFunctions) ? "," : "", nl);
+  fprintf(fp, "%s},%s", in1, nl);
+
+  fprintf(fp, "%s\"eventIterations\": {\"calls\": %lu, \"reused\": %lu, \"loops\": %lu},%s", in1,
+    (unsigned long)sta->nEventIterations, (unsigned long)sta->nEventIterationsReused, (unsigned long)sta->nEventIterationLoops, nl);
+  fprintf(fp, "%s\"timeAdvances\": %lu,%s", in1, (unsigned long)sta->nTimeAdvances, nl);
+
+  fprintf(fp, "%s\"zones\": [%s", in1, nl);
+  for(i = 0; i < sta->nZon; i++){
+    fprintf(fp, "%s{\"name\": ", in2);
+    writeJSONString(fp, sta->zoneNames[i]);
+    fprintf(fp, ", \"calls\": %lu, \"wallTime\": %.9g}%s%s",
+      (unsigned long)sta->nZoneExchanges[i], sta->timeZoneExchanges[i], (i+1 < sta->nZon) ? "," : "", nl);
+  }
+  fprintf(fp, "%s]%s}", in1, nl);
+}
+
+/* Return the name of the file with the extension ext, which needs to be freed by the caller */
+static char* getStatisticsFileName(const FMUBuilding* bui, const BuildingStatistics* sta, const char* ext){
+  char* fileName;
+
+  createDirectory(sta->directory, bui->SpawnFormatError);
+  mallocString(strlen(sta->directory) + strlen(SEPARATOR) + strlen(bui->modelicaNameBuilding) + strlen(ext) + 1,
+    "Failed to allocate memory for name of statistics file.", &fileName, bui->SpawnFormatError);
+  sprintf(fileName, "%s%s%s%s", sta->directory, SEPARATOR, bui->modelicaNameBuilding, ext);
+  return fileName;
+}
+
+/* Add a time advance, and write a sample if the sample interval elapsed */
+void addTimeAdvanceStatistics(FMUBuilding* bui){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+  char* fileName;
+
+  if (sta == NULL)
+    return;
+  sta->nTimeAdvances++;
+  if (sta->sampleInterval <= 0 || sta->sampleFailed || bui->time < sta->tSample)
+    return;
+
+  if (sta->samples == NULL){
+    fileName = getStatisticsFileName(bui, sta, ".jsonl");
+    sta->samples = fopen(fileName, "w");
+    if (sta->samples == NULL){
+      bui->SpawnFormatMessage("---- %s: Warning: Failed to open %s, statistics are not sampled: %s.\n",
+        bui->modelicaNameBuilding, fileName, strerror(errno));
+      sta->sampleFailed = true;
+      free(fileName);
+      return;
+    }
+    free(fileName);
+  }
+  writeStatistics(sta->samples, bui, sta, true);
+  fputc('\n', sta->samples);
+  fflush(sta->samples);
+  while (sta->tSample <= bui->time)
+    sta->tSample += sta->sampleInterval;
+}
+
+/* Add a call of an exchange function that started at tStart */
+void addExchangeStatistics(FMUBuilding* bui, StatisticsExchange exc, double tStart){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+
+  if (sta == NULL)
+    return;
+  sta->nExchanges[exc]++;
+  sta->timeExchanges[exc] += getWallClockTime() - tStart;
+  sta->timeFMUInExchange += sta->timeFMUInRunningExchange;
+  sta->inExchange = false;
+}
+
+/* Add a call of the exchange function of the zone that started at tStart */
+void addZoneExchangeStatistics(FMUZone* zone, double tStart){
+  FMUBuilding* bui = zone->bui;
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+  size_t i;
+  const double dt = (sta == NULL) ? 0 : getWallClockTime() - tStart;
+
+  if (sta == NULL)
+    return;
+
+  /* The zones are known once the exchange cache has been allocated in the first exchange */
+  if (sta->nZon == 0 && bui->nZon > 0){
+    sta->zoneNames = (char**)calloc(bui->nZon, sizeof(char*));
+    sta->nZoneExchanges = (size_t*)calloc(bui->nZon, sizeof(size_t));
+    sta->timeZoneExchanges = (double*)calloc(bui->nZon, sizeof(double));
+    if (sta->zoneNames == NULL || sta->nZoneExchanges == NULL || sta->timeZoneExchanges == NULL)
+      bui->SpawnFormatError("Failed to allocate memory for zone statistics of %s.", bui->modelicaNameBuilding);
+    sta->nZon = bui->nZon;
+    for(i = 0; i < sta->nZon; i++){
+      const char* nam = ((FMUZone*)bui->zones[i])->modelicaNameThermalZone;
+      mallocString(strlen(nam)+1, "Failed to allocate memory for zone statistics.", &(sta->zoneNames[i]), bui->SpawnFormatError);
+      strcpy(sta->zoneNames[i], nam);
+    }
+  }
+  if (zone->iExc < sta->nZon){
+    sta->nZoneExchanges[zone->iExc]++;
+    sta->timeZoneExchanges[zone->iExc] += dt;
+  }
+  sta->nExchanges[statisticsZoneExchange]++;
+  sta->timeExchanges[statisticsZoneExchange] += dt;
+  sta->timeFMUInExchange += sta->timeFMUInRunningExchange;
+  sta->inExchange = false;
+}
+
+/* Write the statistics of the building to <modelicaNameBuilding>.json, and free them */
+void writeAndFreeStatistics(FMUBuilding* bui){
+  BuildingStatistics* sta = (BuildingStatistics*)bui->statistics;
+  char* fileName;
+  FILE* fp;
+  size_t i;
+  int ret;
+
+  if (sta == NULL)
+    return;
+
+  fileName = getStatisticsFileName(bui, sta, ".json");
+  fp = fopen(fileName, "w");
+  if (fp == NULL){
+    bui->SpawnFormatMessage("---- %s: Warning: Failed to open %s to write statistics: %s.\n",
+      bui->modelicaNameBuilding, fileName, strerror(errno));
+  }
+  else{
+    writeStatistics(fp, bui, sta, false);
+    fputc('\n', fp);
+    ret = ferror(fp);
+    if (fclose(fp) != 0 || ret != 0)
+      bui->SpawnFormatMessage("---- %s: Warning: Failed to write statistics to %s.\n", bui->modelicaNameBuilding, fileName);
+    else if (bui->logLevel >= MEDIUM)
+      bui->SpawnFormatMessage("---- %s: Wrote statistics to %s.\n", bui->modelicaNameBuilding, fileName);
+  }
+  free(fileName);
+
+  if (sta->samples != NULL)
+    fclose(sta->samples);
+  for(i = 0; i < sta->nZon; i++)
+    free(sta->zoneNames[i]);
+  free(sta->zoneNames);
+  free(sta->nZoneExchanges);
+  free(sta->timeZoneExchanges);
+  free(sta->directory);
+  free(sta);
+  bui->statistics = NULL;
+}
+
+#endif
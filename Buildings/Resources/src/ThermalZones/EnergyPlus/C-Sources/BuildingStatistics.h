@@ -0,0 +1,62 @@
+/*
+ * Counters of the data exchange with the EnergyPlus FMU of a building.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_BuildingStatistics_h
+#define Buildings_BuildingStatistics_h
+
+#include "EnergyPlusTypes.h"
+
+#include <stddef.h>  /* stddef defines size_t */
+
+/* Environment variable with the directory to which the statistics of each building
+   are written as <modelicaNameBuilding>.json. If not set, no statistics are collected. */
+#define SPAWN_STATISTICS "MODELICA_BUILDINGS_SPAWN_STATISTICS"
+
+/* Environment variable with the interval in seconds of simulated time at which the statistics
+   are appended to <modelicaNameBuilding>.jsonl. If not set, no samples are written. */
+#define SPAWN_STATISTICS_INTERVAL "MODELICA_BUILDINGS_SPAWN_STATISTICS_INTERVAL"
+
+/* FMU functions for which calls are counted */
+typedef enum {
+  statisticsSetReal,
+  statisticsGetReal,
+  statisticsGetDirectionalDerivative,
+  statisticsNewDiscreteStates,
+  statisticsEnterContinuousTimeMode,
+  statisticsSetTime,
+  statisticsCompletedIntegratorStep,
+  statisticsEnterEventMode,
+  statisticsEnterInitializationMode,
+  statisticsExitInitializationMode,
+  statisticsNFunctions
+} StatisticsFunction;
+
+/* Exchange functions for which calls are counted */
+typedef enum {
+  statisticsZoneExchange,
+  statisticsInputVariableExchange,
+  statisticsOutputVariableExchange,
+  statisticsNExchanges
+} StatisticsExchange;
+
+void allocateStatistics(FMUBuilding* bui);
+
+double startStatistics(const FMUBuilding* bui);
+
+double startExchangeStatistics(FMUBuilding* bui);
+
+void addFMUCallStatistics(FMUBuilding* bui, StatisticsFunction fun, size_t nValues, double tStart);
+
+void addEventIterationStatistics(FMUBuilding* bui, bool reused, size_t nLoops);
+
+void addTimeAdvanceStatistics(FMUBuilding* bui);
+
+void addExchangeStatistics(FMUBuilding* bui, StatisticsExchange exc, double tStart);
+
+void addZoneExchangeStatistics(FMUZone* zone, double tStart);
+
+void writeAndFreeStatistics(FMUBuilding* bui);
+
+#endif
@@ -0,0 +1,374 @@
+/*
+ * Worker threads that advance the time of the buildings.
+ *
+ * If MODELICA_BUILDINGS_SPAWN_THREADS is set, each building owns a worker thread
+ * with a queue of commands. When the exchange function of one building advances
+ * the time, the time advance of all other buildings whose next event is due at this
+ * time is posted to their workers. As the simulator calls these buildings at the
+ * same time instant, their EnergyPlus time steps then run in parallel to the time
+ * step of the first building, rather than one after another.
+ * The event iteration stays on the thread of the simulator, as it depends on the
+ * inputs that are set in the exchange functions.
+ *
+ * A building is only accessed by one thread at a time: every exchange function
+ * calls waitForBuildingWorker() before it accesses its building, and commands are
+ * only posted to workers that are idle.
+ * The functions that report messages and errors to the simulator must not be
+ * called from a worker. Hence, before its worker is started, the message and error
+ * functions of the building are replaced by functions that store the messages and
+ * the error in the worker if they are called on the worker thread, and that call
+ * the functions of the simulator otherwise. These functions are not changed while
+ * the worker runs, and waitForBuildingWorker() reports the stored messages on the
+ * thread of the simulator.
+ *
+ * On Windows, no worker threads are used.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "BuildingWorker.h"
+#include "EnergyPlusFMU.h"
+#include "EnergyPlusUtil.h"
+
+#ifndef Buildings_BuildingWorker_c
+#define Buildings_BuildingWorker_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+
+#ifdef _WIN32
+
+void advanceOtherBuildings(const FMUBuilding* bui, double time){
+  (void)bui;
+  (void)time;
+}
+
+void waitForBuildingWorker(FMUBuilding* bui){
+  (void)bui;
+}
+
+void freeBuildingWorker(FMUBuilding* bui){
+  (void)bui;
+}
+
+#else
+
+#include <pthread.h>
+#include <setjmp.h>
+
+typedef enum {workerAdvanceTime, workerStop} BuildingWorkerCommandType;
+
+typedef struct BuildingWorkerCommand{
+  BuildingWorkerCommandType type; /* Type of the command */
+  double time;                    /* Time to which the building is advanced */
+} BuildingWorkerCommand;
+
+typedef struct BuildingWorker{
+  FMUBuilding* bui;               /* Building of this worker */
+  pthread_t thread;               /* Worker thread */
+  pthread_mutex_t mutex;          /* Mutex for the queue */
+  pthread_cond_t cond;            /* Signaled when a command is posted or completed */
+  BuildingWorkerCommand commands[BUILDING_WORKER_QUEUE_LENGTH]; /* Queue of commands */
+  size_t iFirst;                  /* Index of the first command in the queue */
+  size_t nCommands;               /* Number of commands in the queue, including the command that is executed */
+
+  void (*SpawnFormatMessage)(const char *string, ...); /* Message function of the building */
+  void (*SpawnFormatError)(const char *string, ...);   /* Error function of the building */
+  char* messages;                 /* Messages of the commands that have not yet been reported */
+  size_t lenMessages;             /* Length of messages */
+  size_t sizeMessages;            /* Allocated size of messages */
+  bool hasError;                  /* Flag, true if a command failed */
+  bool errorIsReported;           /* Flag, true if the error has been reported */
+  char error[SPAWN_LOGGER_BUFFER_LENGTH]; /* Error message of the failed command */
+  jmp_buf jmpBuf;                 /* Return point if a command fails */
+} BuildingWorker;
+
+static pthread_key_t Buildings_WorkerKey; /* Worker of the current thread */
+static pthread_once_t Buildings_WorkerKeyOnce = PTHREAD_ONCE_INIT;
+
+/* Message and error functions of the simulator, which are the same for all buildings that have a worker */
+static void (*Buildings_SimulatorFormatMessage)(const char *string, ...) = NULL;
+static void (*Buildings_SimulatorFormatError)(const char *string, ...) = NULL;
+
+static void createWorkerKey(){
+  pthread_key_create(&Buildings_WorkerKey, NULL);
+}
+
+/* Return true if the worker threads are enabled */
+static bool useBuildingWorkers(){
+  static int use = -1;
+  const char* str;
+
+  if (use == -1){
+    str = getenv(SPAWN_THREADS);
+    use = (str != NULL && strlen(str) > 0 && strcmp(str, "0") != 0) ? 1 : 0;
+  }
+  return use == 1;
+}
+
+/* Store the message in the worker */
+static void storeWorkerMessage(BuildingWorker* worker, const char *string, va_list args){
+  va_list argsCopy;
+  int len;
+  char* tmp;
+
+  va_copy(argsCopy, args);
+  len = vsnprintf(NULL, 0, string, args);
+  if (len > 0){
+    if (worker->lenMessages + (size_t)len + 1 > worker->sizeMessages){
+      tmp = (char*)realloc(worker->messages, 2 * (worker->lenMessages + (size_t)len + 1));
+      if (tmp != NULL){
+        worker->messages = tmp;
+        worker->sizeMessages = 2 * (worker->lenMessages + (size_t)len + 1);
+      }
+    }
+    /* Drop the message if no memory is available */
+    if (worker->lenMessages + (size_t)len + 1 <= worker->sizeMessages){
+      vsnprintf(worker->messages + worker->lenMessages, (size_t)len + 1, string, argsCopy);
+      worker->lenMessages += (size_t)len;
+    }
+  }
+  va_end(argsCopy);
+}
+
+/* Message function of a building that has a worker.
+   On the worker thread, the message is stored in the worker, otherwise it is reported to the simulator */
+static void buildingFormatMessage(const char *string, ...){
+  BuildingWorker* worker = (BuildingWorker*)pthread_getspecific(Buildings_WorkerKey);
+  va_list args;
+  va_list argsCopy;
+  int len;
+  char* msg;
+
+  va_start(args, string);
+  if (worker != NULL)
+    storeWorkerMessage(worker, string, args);
+  else{
+    va_copy(argsCopy, args);
+    len = vsnprintf(NULL, 0, string, args);
+    msg = (len >= 0) ? (char*)malloc((size_t)len + 1) : NULL;
+    if (msg != NULL){
+      vsnprintf(msg, (size_t)len + 1, string, argsCopy);
+      Buildings_SimulatorFormatMessage("%s", msg);
+      free(msg);
+    }
+    va_end(argsCopy);
+  }
+  va_end(args);
+}
+
+/* Error function of a building that has a worker.
+   On the worker thread, the error is stored in the worker and the command is aborted,
+   otherwise it is reported to the simulator */
+static void buildingFormatError(const char *string, ...){
+  BuildingWorker* worker = (BuildingWorker*)pthread_getspecific(Buildings_WorkerKey);
+  char msg[SPAWN_LOGGER_BUFFER_LENGTH];
+  va_list args;
+
+  va_start(args, string);
+  vsnprintf(worker != NULL ? worker->error : msg, SPAWN_LOGGER_BUFFER_LENGTH, string, args);
+  va_end(args);
+  if (worker != NULL)
+    longjmp(worker->jmpBuf, 1);
+  Buildings_SimulatorFormatError("%s", msg);
+}
+
+static void executeCommand(BuildingWorker* worker, const BuildingWorkerCommand* cmd){
+  FMUBuilding* bui = worker->bui;
+
+  /* The state of the FMU is unknown after a failed command */
+  if (worker->hasError)
+    return;
+
+  if (setjmp(worker->jmpBuf) == 0){
+    if (bui->logLevel >= TIMESTEP)
+      bui->SpawnFormatMessage("%.3f %s: Advancing time to %.3f on worker thread.\n", bui->time, bui->modelicaNameBuilding, cmd->time);
+    advanceTime_completeIntegratorStep_enterEventMode(bui, bui->modelicaNameBuilding, cmd->time);
+  }
+  else{
+    worker->hasError = true;
+  }
+}
+
+static void* runBuildingWorker(void* arg){
+  BuildingWorker* worker = (BuildingWorker*)arg;
+  BuildingWorkerCommand cmd;
+
+  pthread_setspecific(Buildings_WorkerKey, worker);
+  pthread_mutex_lock(&worker->mutex);
+  for(;;){
+    while (worker->nCommands == 0)
+      pthread_cond_wait(&worker->cond, &worker->mutex);
+    cmd = worker->commands[worker->iFirst];
+    if (cmd.type == workerStop)
+      break;
+    pthread_mutex_unlock(&worker->mutex);
+
+    executeCommand(worker, &cmd);
+
+    pthread_mutex_lock(&worker->mutex);
+    /* The command is removed only now, so that the building is not accessed while it runs */
+    worker->iFirst = (worker->iFirst + 1) % BUILDING_WORKER_QUEUE_LENGTH;
+    worker->nCommands--;
+    pthread_cond_broadcast(&worker->cond);
+  }
+  pthread_mutex_unlock(&worker->mutex);
+  return NULL;
+}
+
+/* Return the worker of the building, and start it if needed.
+   Return NULL if the building has no worker. */
+static BuildingWorker* getBuildingWorker(FMUBuilding* bui){
+  BuildingWorker* worker = (BuildingWorker*)bui->worker;
+
+  if (worker != NULL || !useBuildingWorkers())
+    return worker;
+
+  /* The replaced functions of the building call those of the simulator, which hence must be the same for all buildings */
+  if (Buildings_SimulatorFormatMessage == NULL){
+    Buildings_SimulatorFormatMessage = bui->SpawnFormatMessage;
+    Buildings_SimulatorFormatError = bui->SpawnFormatError;
+  }
+  else if (bui->SpawnFormatMessage != Buildings_SimulatorFormatMessage || bui->SpawnFormatError != Buildings_SimulatorFormatError){
+    bui->SpawnFormatMessage("---- %s: Warning: Building uses other message functions than the buildings with a worker thread, time is advanced without it.\n",
+      bui->modelicaNameBuilding);
+    return NULL;
+  }
+
+  pthread_once(&Buildings_WorkerKeyOnce, createWorkerKey);
+  worker = (BuildingWorker*)calloc(1, sizeof(BuildingWorker));
+  if (worker == NULL)
+    bui->SpawnFormatError("Failed to allocate memory for worker of %s.", bui->modelicaNameBuilding);
+  worker->bui = bui;
+  worker->SpawnFormatMessage = bui->SpawnFormatMessage;
+  worker->SpawnFormatError = bui->SpawnFormatError;
+  pthread_mutex_init(&worker->mutex, NULL);
+  pthread_cond_init(&worker->cond, NULL);
+  /* Replace the functions before the worker is started, as they must not change while it runs */
+  bui->SpawnFormatMessage = buildingFormatMessage;
+  bui->SpawnFormatError = buildingFormatError;
+  if (pthread_create(&worker->thread, NULL, runBuildingWorker, worker) != 0){
+    /* Advance the building on the thread of the simulator */
+    bui->SpawnFormatMessage = worker->SpawnFormatMessage;
+    bui->SpawnFormatError = worker->SpawnFormatError;
+    bui->SpawnFormatMessage("---- %s: Warning: Failed to start worker thread, time is advanced without it.\n", bui->modelicaNameBuilding);
+    pthread_cond_destroy(&worker->cond);
+    pthread_mutex_destroy(&worker->mutex);
+    free(worker);
+    return NULL;
+  }
+  if (bui->logLevel >= MEDIUM)
+    bui->SpawnFormatMessage("---- %s: Started worker thread.\n", bui->modelicaNameBuilding);
+  bui->worker = worker;
+  return worker;
+}
+
+/* Add the command to the queue of the worker. The caller must hold the mutex. */
+static void pushCommand(BuildingWorker* worker, BuildingWorkerCommandType type, double time){
+  BuildingWorkerCommand* cmd;
+
+  while (worker->nCommands == BUILDING_WORKER_QUEUE_LENGTH)
+    pthread_cond_wait(&worker->cond, &worker->mutex);
+  cmd = &(worker->commands[(worker->iFirst + worker->nCommands) % BUILDING_WORKER_QUEUE_LENGTH]);
+  cmd->type = type;
+  cmd->time = time;
+  worker->nCommands++;
+  pthread_cond_broadcast(&worker->cond);
+}
+
+/* Wait until the worker executed all commands, and report their messages.
+   If reportError is true, report the error of a failed command */
+static void drainBuildingWorker(BuildingWorker* worker, bool reportError){
+  pthread_mutex_lock(&worker->mutex);
+  while (worker->nCommands > 0)
+    pthread_cond_wait(&worker->cond, &worker->mutex);
+  pthread_mutex_unlock(&worker->mutex);
+
+  if (worker->lenMessages > 0){
+    worker->SpawnFormatMessage("%s", worker->messages);
+    worker->lenMessages = 0;
+  }
+  if (worker->hasError && !worker->errorIsReported){
+    worker->errorIsReported = true;
+    if (reportError)
+      worker->SpawnFormatError("%s", worker->error);
+    else
+      worker->SpawnFormatMessage("%s\n", worker->error);
+  }
+}
+
+/* Start the time advance of all buildings other than bui whose next event is due at time.
+   The simulator calls these buildings at the same time instant, at which
+   their exchange function waits for the time advance to complete. */
+void advanceOtherBuildings(const FMUBuilding* bui, double time){
+  const size_t nFMU = getBuildings_nFMU();
+  size_t i;
+  FMUBuilding* oth;
+  BuildingWorker* worker;
+
+  if (!useBuildingWorkers())
+    return;
+
+  for(i = 0; i < nFMU; i++){
+    oth = getBuildingsFMU(i);
+    if (oth == bui)
+      continue;
+    worker = (BuildingWorker*)oth->worker;
+    if (worker != NULL){
+      pthread_mutex_lock(&worker->mutex);
+      /* Skip buildings that are already advancing their time */
+      if (worker->nCommands > 0){
+        pthread_mutex_unlock(&worker->mutex);
+        continue;
+      }
+    }
+    /* The building is idle, hence its data can be read */
+    if (oth->mode == eventMode && (time - oth->time) > 0.001 && time >= oth->eventIterationTNext - 0.001){
+      if (worker == NULL){
+        worker = getBuildingWorker(oth);
+        if (worker == NULL)
+          continue;
+        pthread_mutex_lock(&worker->mutex);
+      }
+      pushCommand(worker, workerAdvanceTime, time);
+    }
+    if (worker != NULL)
+      pthread_mutex_unlock(&worker->mutex);
+  }
+}
+
+/* Wait until the worker of the building completed all commands.
+   This must be called before the building is accessed. */
+void waitForBuildingWorker(FMUBuilding* bui){
+  if (bui->worker != NULL)
+    drainBuildingWorker((BuildingWorker*)bui->worker, true);
+}
+
+/* Stop the worker of the building, if it has one */
+void freeBuildingWorker(FMUBuilding* bui){
+  BuildingWorker* worker = (BuildingWorker*)bui->worker;
+
+  if (worker == NULL)
+    return;
+  drainBuildingWorker(worker, false);
+  pthread_mutex_lock(&worker->mutex);
+  pushCommand(worker, workerStop, 0);
+  pthread_mutex_unlock(&worker->mutex);
+  pthread_join(worker->thread, NULL);
+  bui->SpawnFormatMessage = worker->SpawnFormatMessage;
+  bui->SpawnFormatError = worker->SpawnFormatError;
+
+  pthread_cond_destroy(&worker->cond);
+  pthread_mutex_destroy(&worker->mutex);
+  if (worker->messages != NULL)
+    free(worker->messages);
+  free(worker);
+  bui->worker = NULL;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * Worker threads that advance the time of the buildings.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_BuildingWorker_h
+#define Buildings_BuildingWorker_h
+
+#include "EnergyPlusTypes.h"
+
+/* Environment variable that enables the worker threads if it is set to a value other than 0.
+   By default, all buildings are advanced by the thread of the simulator. */
+#define SPAWN_THREADS "MODELICA_BUILDINGS_SPAWN_THREADS"
+
+/* Number of commands that can be queued for a worker */
+#define BUILDING_WORKER_QUEUE_LENGTH 8
+
+void advanceOtherBuildings(const FMUBuilding* bui, double time);
+
+void waitForBuildingWorker(FMUBuilding* bui);
+
+void freeBuildingWorker(FMUBuilding* bui);
+
+#endif
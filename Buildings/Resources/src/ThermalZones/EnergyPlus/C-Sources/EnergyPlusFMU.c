@@ -131,6 +131,14 @@ size_t AllocateBuildingDataStructure(
 
   /* Set the model hash to null */
   Buildings_FMUS[nFMU]->modelHash = NULL;
+  Buildings_FMUS[nFMU]->fmuHash = NULL;
+  Buildings_FMUS[nFMU]->spawnJob = NULL;
+  Buildings_FMUS[nFMU]->exchangeCache = NULL;
+  Buildings_FMUS[nFMU]->inputVersion = 0;
+  Buildings_FMUS[nFMU]->eventIterationIsValid = false;
+  Buildings_FMUS[nFMU]->eventIterationTNext = INFINITY;
+  Buildings_FMUS[nFMU]->worker = NULL;
+  allocateStatistics(Buildings_FMUS[nFMU]);
   /* Set the number of this FMU */
   Buildings_FMUS[nFMU]->iFMU = nFMU;
 
@@ -209,6 +217,9 @@ void AddZoneToBuilding(FMUZone* zone, const int logLevel){
   /* Increment the count of zones to this building. */
   bui->nZon++;
 
+  registerObject(registryZone, NULL, zone->modelicaNameThermalZone, zone, bui->SpawnFormatError);
+  registerObject(registryZoneName, bui, zone->name, zone, bui->SpawnFormatError);
+
   checkAndSetVerbosity(bui, logLevel);
 
   if (bui->logLevel >= MEDIUM)
@@ -249,6 +260,9 @@ void AddInputVariableToBuilding(FMUInputVariable* ptrVar, const int logLevel){
   /* Increment the count of input variables of this building. */
   bui->nInputVariables++;
 
+  registerObject(registryInputVariable, NULL, ptrVar->modelicaNameInputVariable, ptrVar, bui->SpawnFormatError);
+  registerObject(registryInputVariableFMIName, bui, ptrVar->inputs->fmiNames[0], ptrVar, bui->SpawnFormatError);
+
   checkAndSetVerbosity(bui, logLevel);
 
   if (bui->logLevel >= MEDIUM)
@@ -288,6 +302,9 @@ void AddOutputVariableToBuilding(FMUOutputVariable* ptrVar, const int logLevel){
   /* Increment the count of output variables of this building. */
   bui->nOutputVariables++;
 
+  registerObject(registryOutputVariable, NULL, ptrVar->modelicaNameOutputVariable, ptrVar, bui->SpawnFormatError);
+  registerObject(registryOutputVariableFMIName, bui, ptrVar->outputs->fmiNames[0], ptrVar, bui->SpawnFormatError);
+
   checkAndSetVerbosity(bui, logLevel);
 
   if (bui->logLevel >= MEDIUM)
@@ -334,6 +351,10 @@ void FMUBuildingFree(FMUBuilding* bui){
       return;
     }
 
+    /* Wait for and stop the worker before the FMU is terminated */
+    freeBuildingWorker(bui);
+    writeAndFreeStatistics(bui);
+
     /* The call to fmi2_import_terminate causes a seg fault if
        fmi2_import_create_dllfmu was not successful */
     if (bui->dllfmu_created){
@@ -374,10 +395,15 @@ void FMUBuildingFree(FMUBuilding* bui){
       free(bui->tmpDir);
     if (bui->modelHash != NULL)
       free(bui->modelHash);
+    if (bui->fmuHash != NULL)
+      free(bui->fmuHash);
+    freeExchangeCache(bui);
     free(bui);
   }
   decrementBuildings_nFMU();
   if (getBuildings_nFMU() == 0){
+    freeSpawnJobs();
+    freeNameRegistry();
     free(Buildings_FMUS);
   }
 }
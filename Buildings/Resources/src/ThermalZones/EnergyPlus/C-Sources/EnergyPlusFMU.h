@@ -7,6 +7,7 @@
 
 #include "EnergyPlusTypes.h"
 #include "EnergyPlusUtil.h"
+#include "NameRegistry.h"
 
 #include <stdlib.h>
 #include <stddef.h>  /* stddef defines size_t */
@@ -87,10 +87,20 @@ typedef struct FMUBuilding
   char* fmuAbsPat; /* Absolute name of the fmu */
   bool usePrecompiledFMU; /* if true, a pre-compiled FMU will be used (for debugging) */
   char* precompiledFMUAbsPat; /* Name of pre-compiled FMU (if usePrecompiledFMU = true, otherwise set the NULL) */
-  char* modelHash; /* Hash code of the model definition used to create the FMU (except the FMU path) */
+  char* modelHash; /* Hash code of the model definition, and of the idf and weather file, used to create the FMU (except the FMU path) */
+  char* fmuHash; /* Hash of the content of the FMU, or NULL if not yet computed */
+  void* spawnJob; /* Spawn job that generates the FMU, or NULL if the FMU is not generated or has been waited for. Type is SpawnJob* */
+  void* exchangeCache; /* Cache of the inputs and outputs of all zones, or NULL if not yet allocated. Type is ExchangeCache* */
+  void* statistics; /* Counters of the data exchange, or NULL if they are not collected. Type is BuildingStatistics* */
+  void* worker; /* Worker thread that advances the time of this building, or NULL if not started. Type is BuildingWorker* */
   fmi2Boolean dllfmu_created; /* Flag to indicate if dll fmu functions were successfully created */
   fmi2Real time; /* Time that is set in the building fmu */
   FMUMode mode; /* Mode that the FMU is in */
+  size_t inputVersion; /* Counter that is incremented whenever an input variable of the FMU changes. Zone inputs are tracked by the exchange cache */
+  bool eventIterationIsValid; /* Flag, true if the stored result of the last event iteration can be reused */
+  double eventIterationTime; /* Time of the last event iteration */
+  size_t eventIterationInputVersion; /* Value of inputVersion at the last event iteration */
+  double eventIterationTNext; /* Next event time returned by the last event iteration */
   size_t iFMU; /* Number of this FMU */
 
   int logLevel; /* Log level */
@@ -107,6 +117,8 @@ typedef struct spawnReals{
   fmi2Real* valsEP; /* Values as used by EnergyPlus */
   fmi2Real* valsSI; /* vals in SI units as used by Modelica */
   fmi2_import_unit_t** units; /* Unit type, or NULL if not specified */
+  fmi2Real* factors; /* Factors of the unit conversion valsSI = factors*valsEP + offsets */
+  fmi2Real* offsets; /* Offsets of the unit conversion valsSI = factors*valsEP + offsets */
   fmi2ValueReference* valRefs; /* Value references */
   fmi2Byte** fmiNames; /* Full names, as listed in modelDescripton.xml file */
 } spawnReals;
@@ -125,6 +137,7 @@ typedef struct FMUZone
   spawnReals* parameters; /* Parameters */
   spawnReals* inputs;     /* Inputs */
   spawnReals* outputs;    /* Outputs */
+  size_t iExc;            /* Index of this zone in the exchange cache of the building */
 
   fmi2Boolean isInstantiated; /* Flag set to true when the zone has been completely instantiated */
   fmi2Boolean isInitialized;  /* Flag set to true after the zone has executed all get/set calls in the initializion mode
@@ -29,32 +29,82 @@ void mallocSpawnReals(const size_t n, spawnReals** r, void (*SpawnFormatError)(c
   (*r)->valsEP = NULL;
   (*r)->valsSI = NULL;
   (*r)->units = NULL;
+  (*r)->factors = NULL;
+  (*r)->offsets = NULL;
   (*r)->valRefs = NULL;
   (*r)->fmiNames = NULL;
-  for(i = 0; i < n; i++){
-    (*r)->valsEP = (fmi2Real*)malloc(n * sizeof(fmi2Real));
-    if ((*r)->valsEP == NULL)
-      SpawnFormatError("%s", "Failed to allocate memory for (*r)->valsEP in EnergyPlus.c");
 
-    (*r)->valsSI = (fmi2Real*)malloc(n * sizeof(fmi2Real));
-    if ((*r)->valsSI == NULL)
-      SpawnFormatError("%s", "Failed to allocate memory for (*r)->valsSI in EnergyPlus.c");
+  (*r)->valsEP = (fmi2Real*)malloc(n * sizeof(fmi2Real));
+  if ((*r)->valsEP == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->valsEP in EnergyPlus.c");
+
+  (*r)->valsSI = (fmi2Real*)malloc(n * sizeof(fmi2Real));
+  if ((*r)->valsSI == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->valsSI in EnergyPlus.c");
+
+  (*r)->units = (fmi2_import_unit_t**)malloc(n * sizeof(fmi2_import_unit_t*));
+  if ((*r)->units == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->units in EnergyPlus.c");
+
+  (*r)->factors = (fmi2Real*)malloc(n * sizeof(fmi2Real));
+  if ((*r)->factors == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->factors in EnergyPlus.c");
 
-    (*r)->units = (fmi2_import_unit_t**)malloc(n * sizeof(fmi2_import_unit_t*));
-    if ((*r)->units == NULL)
-      SpawnFormatError("%s", "Failed to allocate memory for (*r)->units in EnergyPlus.c");
+  (*r)->offsets = (fmi2Real*)malloc(n * sizeof(fmi2Real));
+  if ((*r)->offsets == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->offsets in EnergyPlus.c");
 
-    (*r)->valRefs = (fmi2ValueReference*)malloc(n * sizeof(fmi2ValueReference));
-    if ((*r)->valRefs == NULL)
-      SpawnFormatError("%s", "Failed to allocate memory for (*r)->valRefs in EnergyPlus.c");
+  (*r)->valRefs = (fmi2ValueReference*)malloc(n * sizeof(fmi2ValueReference));
+  if ((*r)->valRefs == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->valRefs in EnergyPlus.c");
 
-    (*r)->fmiNames = (fmi2Byte**)malloc(n * sizeof(fmi2Byte*));
-    if ((*r)->fmiNames == NULL)
-      SpawnFormatError("%s", "Failed to allocate memory for (*r)->fmiNames in EnergyPlus.c");
+  (*r)->fmiNames = (fmi2Byte**)malloc(n * sizeof(fmi2Byte*));
+  if ((*r)->fmiNames == NULL)
+    SpawnFormatError("%s", "Failed to allocate memory for (*r)->fmiNames in EnergyPlus.c");
+
+  for(i = 0; i < n; i++){
+    /* Set the values to NaN so that the first call of setVariables() detects them as changed */
+    (*r)->valsEP[i] = NAN;
+    /* Identity conversion until the units are known */
+    (*r)->units[i] = NULL;
+    (*r)->factors[i] = 1;
+    (*r)->offsets[i] = 0;
   }
   (*r)->n = n;
 }
 
+/* Set the unit of the element i of ptrReals, and the affine conversion between its unit and
+   the SI base unit. This is the same conversion as in fmi2_import_convert_to_SI_base_unit
+   and fmi2_import_convert_from_SI_base_unit, but avoids these calls for each value. */
+void setUnitConversion(spawnReals* ptrReals, size_t i, fmi2_import_unit_t* unit){
+  ptrReals->units[i] = unit;
+  if (unit){ /* Units are defined */
+    ptrReals->factors[i] = fmi2_import_get_SI_unit_factor(unit);
+    ptrReals->offsets[i] = fmi2_import_get_SI_unit_offset(unit);
+  }
+  else{
+    ptrReals->factors[i] = 1;
+    ptrReals->offsets[i] = 0;
+  }
+}
+
+/* Convert ptrReals->valsEP to ptrReals->valsSI, and return true if any value is NaN */
+bool convertToSI(spawnReals* ptrReals){
+  const size_t n = ptrReals->n;
+  const fmi2Real* valsEP = ptrReals->valsEP;
+  const fmi2Real* factors = ptrReals->factors;
+  const fmi2Real* offsets = ptrReals->offsets;
+  fmi2Real* valsSI = ptrReals->valsSI;
+  size_t i;
+  int hasNaN = 0;
+
+  for(i = 0; i < n; i++){
+    valsSI[i] = valsEP[i]*factors[i] + offsets[i];
+    hasNaN |= isnan(valsSI[i]);
+  }
+  return hasNaN != 0;
+}
+
 char* fmuModeToString(FMUMode mode){
   if (mode == instantiationMode)
     return "instantiation";
@@ -74,17 +124,31 @@ void setVariables(
   {
   size_t i;
   fmi2_status_t status;
+  double tStart;
+  fmi2Real valEP;
+  bool changed = false;
 
   for(i = 0; i < ptrReals->n; i++){
-    if (ptrReals->units[i]) /* Units are defined */
-      ptrReals->valsEP[i] = fmi2_import_convert_from_SI_base_unit(ptrReals->valsSI[i], ptrReals->units[i]);
-    else
-      ptrReals->valsEP[i] = ptrReals->valsSI[i];
+    valEP = (ptrReals->valsSI[i] - ptrReals->offsets[i])/ptrReals->factors[i];
+    /* valsEP is NaN before the first call, hence the comparison fails */
+    if (!(valEP == ptrReals->valsEP[i])){
+      ptrReals->valsEP[i] = valEP;
+      changed = true;
+    }
   }
+  /* The FMU keeps the values that were last set */
+  if (!changed)
+    return;
+
+  tStart = startStatistics(bui);
   status = fmi2_import_set_real(bui->fmu, ptrReals->valRefs, ptrReals->n, ptrReals->valsEP);
+  addFMUCallStatistics(bui, statisticsSetReal, ptrReals->n, tStart);
   if (status != (fmi2_status_t)fmi2OK) {
     bui->SpawnFormatError("Failed to set variables for %s in FMU.\n",  modelicaInstanceName);
   }
+  /* The variables may affect the outputs and derivatives of any zone, and the event iteration */
+  bui->inputVersion++;
+  invalidateExchangeCache(bui, true);
 }
 
 void stopIfResultsAreNaN(FMUBuilding* bui, const char* modelicaInstanceName, spawnReals* ptrReals){
@@ -119,29 +183,33 @@ void stopIfResultsAreNaN(FMUBuilding* bui, const char* modelicaInstanceName, spa
 
 void getVariables(FMUBuilding* bui, const char* modelicaInstanceName, spawnReals* ptrReals)
 {
-  size_t i;
   fmi2_status_t status;
+  double tStart;
 /* fixme
   if (bui->logLevel >= TIMESTEP)
     bui->SpawnFormatMessage("%.3f %s: Getting real variables from EnergyPlus, mode = %s.\n", bui->time, modelicaInstanceName, fmuModeToString(bui->mode));
 */
+  /* Send the staged zone inputs as the variables may depend on them */
+  flushExchangeCache(bui);
+  tStart = startStatistics(bui);
   status = fmi2_import_get_real(bui->fmu, ptrReals->valRefs, ptrReals->n, ptrReals->valsEP);
+  addFMUCallStatistics(bui, statisticsGetReal, ptrReals->n, tStart);
   if (status != (fmi2_status_t)fmi2OK) {
     bui->SpawnFormatError("Failed to get variables for %s\n",
     modelicaInstanceName);
   }
-  /* Set SI unit value */
-  for(i = 0; i < ptrReals->n; i++){
-    if (ptrReals->units[i]) /* Units are defined */
-      ptrReals->valsSI[i] = fmi2_import_convert_to_SI_base_unit(ptrReals->valsEP[i], ptrReals->units[i]);
-    else
-      ptrReals->valsSI[i] = ptrReals->valsEP[i];
-  }
-  stopIfResultsAreNaN(bui, modelicaInstanceName, ptrReals);
+  /* Set SI unit value, and only search for the NaN if there is one */
+  if (convertToSI(ptrReals))
+    stopIfResultsAreNaN(bui, modelicaInstanceName, ptrReals);
 }
 
 
-/* Do the event iteration
+/* Do the event iteration.
+   The result is stored in the building, and reused by all later calls at the same time
+   as long as no input of the building changed and the FMU mode did not change.
+   Hence, it is reused by output variables and by repeated calls with the same inputs.
+   For a building with several zones, each zone exchange sets new inputs of its zone,
+   and therefore still does its own event iteration.
    */
 double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName){
   fmi2_event_info_t eventInfo = {
@@ -152,12 +220,26 @@ double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName){
   const size_t nMax = 50;
   fmi2Status status = fmi2OK;
   double tNext;
+  double tStart;
 
   void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
   void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
 
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: Entered do_event_iteration, mode = %s\n", bui->time, modelicaInstanceName, fmuModeToString(bui->mode));
+
+  /* Send the staged zone inputs, and reuse the last event iteration if no input changed since */
+  flushExchangeCache(bui);
+  if (bui->eventIterationIsValid
+      && bui->eventIterationTime == bui->time
+      && bui->eventIterationInputVersion == bui->inputVersion
+      && !zoneInputsChangedSinceEventIteration(bui)){
+    if (bui->logLevel >= TIMESTEP)
+      SpawnFormatMessage("%.3f %s: Reusing event iteration with tNext = %.2f\n", bui->time, modelicaInstanceName, bui->eventIterationTNext);
+    addEventIterationStatistics(bui, true, 0);
+    return bui->eventIterationTNext;
+  }
+
   /* Enter event mode if the FMU is in Continuous time mode
      because fmi2NewDiscreteStates can only be called in event mode */
   if (bui->mode == continuousTimeMode){
@@ -176,8 +258,12 @@ double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName){
     if (bui->logLevel >= TIMESTEP)
       SpawnFormatMessage("%.3f %s: Calling fmi2_import_new_discrete_states with event iteration counter i = %lu\n", bui->time, modelicaInstanceName,
         i);
+    tStart = startStatistics(bui);
     status = fmi2_import_new_discrete_states(bui->fmu, &eventInfo);
+    addFMUCallStatistics(bui, statisticsNewDiscreteStates, 0, tStart);
   }
+  invalidateExchangeCache(bui, false);
+  addEventIterationStatistics(bui, false, i);
   if (eventInfo.terminateSimulation){
     SpawnFormatError("%.3f %s: FMU requested to terminate the simulation.", bui->time, modelicaInstanceName);
   }
@@ -210,6 +296,12 @@ double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName){
   }
 
 
+  bui->eventIterationIsValid = true;
+  bui->eventIterationTime = bui->time;
+  bui->eventIterationInputVersion = bui->inputVersion;
+  storeEventIterationZoneInputs(bui);
+  bui->eventIterationTNext = tNext;
+
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: Exiting do_event_iteration, mode = %s\n", bui->time, modelicaInstanceName, fmuModeToString(bui->mode));
   return tNext;
@@ -219,6 +311,7 @@ double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName){
 */
 void advanceTime_completeIntegratorStep_enterEventMode(FMUBuilding* bui, const char* modelicaInstanceName, double time){
   fmi2Status status;
+  double tStart;
   fmi2Boolean enterEventMode;
   fmi2Boolean terminateSimulation;
 
@@ -227,7 +320,10 @@ void advanceTime_completeIntegratorStep_enterEventMode(FMUBuilding* bui, const c
 
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: fmi2_import_enter_continuous_time_mode: Setting EnergyPlus to continuous time mode with time = %.2f\n", bui->time, modelicaInstanceName, time);
+  flushExchangeCache(bui);
+  tStart = startStatistics(bui);
   status = fmi2_import_enter_continuous_time_mode(bui->fmu);
+  addFMUCallStatistics(bui, statisticsEnterContinuousTimeMode, 0, tStart);
   if ( status != fmi2OK ) {
     SpawnFormatError("%.3f %s: Failed to set time in building FMU, returned status is %s.", bui->time, modelicaInstanceName,
       fmi2_status_to_string(status));
@@ -239,7 +335,9 @@ void advanceTime_completeIntegratorStep_enterEventMode(FMUBuilding* bui, const c
     time);
 
   bui->time = time;
+  tStart = startStatistics(bui);
   status = fmi2_import_set_time(bui->fmu, time);
+  addFMUCallStatistics(bui, statisticsSetTime, 0, tStart);
   if ( status != fmi2OK ) {
     SpawnFormatError("%.3f %s: Failed to set time in building FMU, returned status is %s.", bui->time, modelicaInstanceName,
       fmi2_status_to_string(status));
@@ -247,7 +345,9 @@ void advanceTime_completeIntegratorStep_enterEventMode(FMUBuilding* bui, const c
 
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: fmi2_import_completed_integrator_step: Calling completed integrator step\n", bui->time, modelicaInstanceName);
+  tStart = startStatistics(bui);
   status = fmi2_import_completed_integrator_step(bui->fmu, fmi2_true, &enterEventMode, &terminateSimulation);
+  addFMUCallStatistics(bui, statisticsCompletedIntegratorStep, 0, tStart);
   if ( status != fmi2OK ) {
     SpawnFormatError("%.3f %s: Failed to complete integrator step in building FMU, returned status is %s.", bui->time, modelicaInstanceName,
     fmi2_status_to_string(status));
@@ -266,12 +366,15 @@ void advanceTime_completeIntegratorStep_enterEventMode(FMUBuilding* bui, const c
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: Calling fmi2_import_enter_event_mode: Enter event mode for FMU %s.\n", bui->time, modelicaInstanceName,
       bui->modelicaNameBuilding);
+  tStart = startStatistics(bui);
   status = fmi2_import_enter_event_mode(bui->fmu);
+  addFMUCallStatistics(bui, statisticsEnterEventMode, 0, tStart);
   if (status != (fmi2Status)fmi2_status_ok){
     SpawnFormatError("%.3f %s: Failed to enter event mode in EnergyPlusUtil.c, returned status is %s.", bui->time, modelicaInstanceName,
       fmi2_status_to_string(status));
   }
   setFMUMode(bui, eventMode);
+  addTimeAdvanceStatistics(bui);
 
   return;
 }
@@ -283,6 +386,8 @@ void setFMUMode(FMUBuilding* bui, FMUMode mode){
       bui->SpawnFormatMessage("%.3f %s: Switching to mode %s\n", bui->time, bui->modelicaNameBuilding, fmuModeToString(mode));
   }
   bui->mode = mode;
+  bui->eventIterationIsValid = false;
+  invalidateExchangeCache(bui, false);
 }
 /*
  Appends a character array to another character array.
@@ -608,6 +713,7 @@ void createDirectory(const char* dirName, void (*SpawnFormatError)(const char *s
 
 void loadFMU_setupExperiment_enterInitializationMode(FMUBuilding* bui, double startTime){
   fmi2_status_t status;
+  double tStart;
 
   void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
   void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
@@ -658,7 +764,9 @@ void loadFMU_setupExperiment_enterInitializationMode(FMUBuilding* bui, double st
       bui->time,
       modelicaInstanceName,
       bui->fmuAbsPat);
+  tStart = startStatistics(bui);
   status = fmi2_import_enter_initialization_mode(bui->fmu);
+  addFMUCallStatistics(bui, statisticsEnterInitializationMode, 0, tStart);
   if( status != fmi2_status_ok ){
     SpawnFormatError("%.3f %s: Failed to enter initialization mode for FMU with name %s.", bui->time, modelicaInstanceName,
       bui->fmuAbsPat);
@@ -8,6 +8,9 @@
 
 #include "EnergyPlusTypes.h"
 #include "BuildingInstantiate.h"
+#include "ExchangeCache.h"
+#include "BuildingWorker.h"
+#include "BuildingStatistics.h"
 
 #include <stdio.h>
 #ifdef _MSC_VER
@@ -38,6 +41,10 @@
 
 void mallocSpawnReals(const size_t n, spawnReals** r, void (*SpawnFormatError)(const char *string, ...));
 
+void setUnitConversion(spawnReals* ptrReals, size_t i, fmi2_import_unit_t* unit);
+
+bool convertToSI(spawnReals* ptrReals);
+
 void mallocString(
   size_t nChar,
   const char *error_message, char** str,
@@ -52,6 +59,8 @@ void setVariables(
 
 void getVariables(FMUBuilding* bui, const char* modelicaInstanceName, spawnReals* ptrReals);
 
+void stopIfResultsAreNaN(FMUBuilding* bui, const char* modelicaInstanceName, spawnReals* ptrReals);
+
 double do_event_iteration(FMUBuilding* bui, const char* modelicaInstanceName);
 
 void saveAppend(char* *buffer, const char *toAdd, size_t *bufLen, void (*SpawnFormatError)(const char *string, ...));
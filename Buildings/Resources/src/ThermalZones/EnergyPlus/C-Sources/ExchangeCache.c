@@ -0,0 +1,467 @@
+/*
+ * Building-level cache of the inputs and outputs of all zones.
+ *
+ * The inputs of the zones are staged in one array and sent to the FMU with a single
+ * call to fmi2_import_set_real when an output is requested. Inputs that did not change
+ * since they were last sent are not sent again. The outputs of all zones whose cached
+ * values are out of date are obtained with a single call to fmi2_import_get_real.
+ *
+ * A zone's inputs only invalidate the cached outputs of that zone, as the outputs of
+ * a zone only depend on its own inputs. This is the same dependency that the Modelica
+ * model declares for EnergyPlusZoneExchange. Any other call that can change the
+ * state of the FMU, such as setting an input variable, an event iteration or
+ * a change of the FMU mode, invalidates the outputs of all zones.
+ *
+ * The cache also stores the zone inputs that had been sent when the last event iteration
+ * was done, so that the event iteration is only done again if an input differs from these values.
+ * Inputs that are perturbed to compute a derivative and then restored hence do not require
+ * a new event iteration. The inputs of different zones are sent by their own exchange,
+ * and each exchange that changes them requires a new event iteration.
+ *
+ * The cache also computes dQConSen_flow/dT of the zones, using the method set
+ * by MODELICA_BUILDINGS_SPAWN_DERIVATIVE, and stores the derivatives so that
+ * they can be reused while the zone temperature and time change little.
+ * Event iterations and mode changes do not invalidate the derivatives, as they are
+ * used as the linearization of the heat flow rate at the current time.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "ExchangeCache.h"
+#include "EnergyPlusUtil.h"
+
+#ifndef Buildings_ExchangeCache_c
+#define Buildings_ExchangeCache_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static void* mallocCache(size_t n, size_t size, FMUBuilding* bui){
+  void* ptr = calloc(n > 0 ? n : 1, size);
+  if (ptr == NULL)
+    bui->SpawnFormatError("Failed to allocate memory for exchange cache of %s.", bui->modelicaNameBuilding);
+  return ptr;
+}
+
+/* Return a non-negative number from the environment variable name, or def if it is not set */
+static double getEnvironmentDouble(FMUBuilding* bui, const char* name, double def){
+  const char* str = getenv(name);
+  char* end;
+  double val;
+
+  if (str == NULL || strlen(str) == 0)
+    return def;
+  val = strtod(str, &end);
+  if (end == str || val < 0)
+    bui->SpawnFormatError("Environment variable %s must be a non-negative number, received '%s'.", name, str);
+  return val;
+}
+
+static void setDerivativeMethod(FMUBuilding* bui, ExchangeCache* exc){
+  const char* str = getenv(SPAWN_DERIVATIVE);
+  const bool providesDirectionalDerivative =
+    fmi2_import_get_capability(bui->fmu, fmi2_me_providesDirectionalDerivatives) != 0;
+
+  /* The default is the forward difference for each zone, so that the results only change
+     if another method is requested */
+  if (str == NULL || strlen(str) == 0 || strcmp(str, "difference") == 0)
+    exc->derMethod = derivativeDifference;
+  else if (strcmp(str, "auto") == 0)
+    exc->derMethod = derivativeAuto;
+  else if (strcmp(str, "batched") == 0)
+    exc->derMethod = derivativeBatched;
+  else if (strcmp(str, "directional") == 0)
+    exc->derMethod = derivativeDirectional;
+  else
+    bui->SpawnFormatError("Environment variable %s must be auto, difference, batched or directional, received '%s'.",
+      SPAWN_DERIVATIVE, str);
+
+  if (exc->derMethod == derivativeAuto)
+    exc->derMethod = providesDirectionalDerivative ? derivativeDirectional : derivativeDifference;
+  else if (exc->derMethod == derivativeDirectional && !providesDirectionalDerivative){
+    bui->SpawnFormatMessage("---- %s: Warning: FMU does not provide directional derivatives. Using batched differences for dQConSen_flow.\n",
+      bui->modelicaNameBuilding);
+    exc->derMethod = derivativeBatched;
+  }
+
+  /* By default, only reuse derivatives that were computed for the same inputs at the same time,
+     and without any other change of the state of the FMU */
+  exc->derIsApproximate = getenv(SPAWN_DERIVATIVE_DT) != NULL || getenv(SPAWN_DERIVATIVE_TIME) != NULL;
+  exc->derDTMax = getEnvironmentDouble(bui, SPAWN_DERIVATIVE_DT, 0);
+  exc->derTimeMax = getEnvironmentDouble(bui, SPAWN_DERIVATIVE_TIME, getenv(SPAWN_DERIVATIVE_DT) == NULL ? 0 : HUGE_VAL);
+}
+
+/* Allocate the cache for all zones of the building.
+   This must be called after the value references have been set. */
+static ExchangeCache* getExchangeCache(FMUBuilding* bui){
+  ExchangeCache* exc;
+  FMUZone* zone;
+  size_t iZon;
+  size_t nBuf;
+
+  if (bui->exchangeCache != NULL)
+    return (ExchangeCache*)bui->exchangeCache;
+
+  exc = (ExchangeCache*)mallocCache(1, sizeof(ExchangeCache), bui);
+  exc->nZon = bui->nZon;
+  exc->nInpZon = (bui->nZon > 0) ? ((FMUZone*)bui->zones[0])->inputs->n : 0;
+  exc->nOutZon = (bui->nZon > 0) ? ((FMUZone*)bui->zones[0])->outputs->n : 0;
+
+  exc->inpValRefs = (fmi2ValueReference*)mallocCache(exc->nZon*exc->nInpZon, sizeof(fmi2ValueReference), bui);
+  exc->inpVals = (fmi2Real*)mallocCache(exc->nZon*exc->nInpZon, sizeof(fmi2Real), bui);
+  exc->inpIsSet = (bool*)mallocCache(exc->nZon*exc->nInpZon, sizeof(bool), bui);
+  exc->inpIsDirty = (bool*)mallocCache(exc->nZon*exc->nInpZon, sizeof(bool), bui);
+  exc->nDirty = 0;
+  exc->evtInpVals = (fmi2Real*)mallocCache(exc->nZon*exc->nInpZon, sizeof(fmi2Real), bui);
+  exc->evtInpIsSet = (bool*)mallocCache(exc->nZon*exc->nInpZon, sizeof(bool), bui);
+
+  exc->outValRefs = (fmi2ValueReference*)mallocCache(exc->nZon*exc->nOutZon, sizeof(fmi2ValueReference), bui);
+  exc->outVals = (fmi2Real*)mallocCache(exc->nZon*exc->nOutZon, sizeof(fmi2Real), bui);
+  exc->outIsValid = (bool*)mallocCache(exc->nZon, sizeof(bool), bui);
+
+  nBuf = exc->nZon * (exc->nInpZon > exc->nOutZon ? exc->nInpZon : exc->nOutZon);
+  exc->bufValRefs = (fmi2ValueReference*)mallocCache(nBuf, sizeof(fmi2ValueReference), bui);
+  exc->bufVals = (fmi2Real*)mallocCache(nBuf, sizeof(fmi2Real), bui);
+  exc->bufSeed = (fmi2Real*)mallocCache(exc->nZon, sizeof(fmi2Real), bui);
+
+  setDerivativeMethod(bui, exc);
+  exc->dQdT = (double*)mallocCache(exc->nZon, sizeof(double), bui);
+  exc->derT = (double*)mallocCache(exc->nZon, sizeof(double), bui);
+  exc->derTime = (double*)mallocCache(exc->nZon, sizeof(double), bui);
+  exc->derIsValid = (bool*)mallocCache(exc->nZon, sizeof(bool), bui);
+
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    zone = (FMUZone*)bui->zones[iZon];
+    zone->iExc = iZon;
+    memcpy(&(exc->inpValRefs[iZon*exc->nInpZon]), zone->inputs->valRefs, exc->nInpZon*sizeof(fmi2ValueReference));
+    memcpy(&(exc->outValRefs[iZon*exc->nOutZon]), zone->outputs->valRefs, exc->nOutZon*sizeof(fmi2ValueReference));
+  }
+
+  if (bui->logLevel >= MEDIUM)
+    bui->SpawnFormatMessage("%.3f %s: Allocated exchange cache for %lu zones, dQConSen_flow method = %d.\n", bui->time, bui->modelicaNameBuilding,
+      (unsigned long)exc->nZon, exc->derMethod);
+
+  bui->exchangeCache = exc;
+  return exc;
+}
+
+/* Stage the inputs zone->inputs->valsSI of the zone */
+void setZoneInputs(FMUZone* zone){
+  FMUBuilding* bui = zone->bui;
+  ExchangeCache* exc = getExchangeCache(bui);
+  const spawnReals* inp = zone->inputs;
+  const size_t iSta = zone->iExc*exc->nInpZon;
+  size_t i;
+
+  for(i = 0; i < inp->n; i++){
+    inp->valsEP[i] = (inp->valsSI[i] - inp->offsets[i])/inp->factors[i];
+
+    if (!exc->inpIsSet[iSta+i] || exc->inpVals[iSta+i] != inp->valsEP[i]){
+      exc->inpVals[iSta+i] = inp->valsEP[i];
+      if (!exc->inpIsDirty[iSta+i]){
+        exc->inpIsDirty[iSta+i] = true;
+        exc->nDirty++;
+      }
+      exc->outIsValid[zone->iExc] = false;
+      /* The derivative also depends on the other inputs, such as the mass flow rate */
+      if (i != ZONE_INPUT_T && !exc->derIsApproximate)
+        exc->derIsValid[zone->iExc] = false;
+    }
+  }
+}
+
+/* Send all staged inputs to the FMU */
+void flushExchangeCache(FMUBuilding* bui){
+  ExchangeCache* exc = (ExchangeCache*)bui->exchangeCache;
+  size_t i;
+  size_t n = 0;
+  fmi2_status_t status;
+  double tStart;
+
+  if (exc == NULL || exc->nDirty == 0)
+    return;
+
+  for(i = 0; i < exc->nZon*exc->nInpZon; i++){
+    if (exc->inpIsDirty[i]){
+      exc->bufValRefs[n] = exc->inpValRefs[i];
+      exc->bufVals[n] = exc->inpVals[i];
+      exc->inpIsDirty[i] = false;
+      exc->inpIsSet[i] = true;
+      n++;
+    }
+  }
+  exc->nDirty = 0;
+
+  if (bui->logLevel >= TIMESTEP)
+    bui->SpawnFormatMessage("%.3f %s: Setting %lu zone inputs in EnergyPlus.\n", bui->time, bui->modelicaNameBuilding, (unsigned long)n);
+
+  tStart = startStatistics(bui);
+  status = fmi2_import_set_real(bui->fmu, exc->bufValRefs, n, exc->bufVals);
+  addFMUCallStatistics(bui, statisticsSetReal, n, tStart);
+  if (status != (fmi2_status_t)fmi2OK) {
+    bui->SpawnFormatError("Failed to set zone inputs for %s in FMU.\n", bui->modelicaNameBuilding);
+  }
+}
+
+/* Store the zone inputs that have been sent to the FMU, as used by the event iteration */
+void storeEventIterationZoneInputs(FMUBuilding* bui){
+  ExchangeCache* exc = (ExchangeCache*)bui->exchangeCache;
+  if (exc == NULL)
+    return;
+  memcpy(exc->evtInpVals, exc->inpVals, exc->nZon*exc->nInpZon*sizeof(fmi2Real));
+  memcpy(exc->evtInpIsSet, exc->inpIsSet, exc->nZon*exc->nInpZon*sizeof(bool));
+}
+
+/* Return true if a zone input that has been sent to the FMU differs from the value
+   stored by storeEventIterationZoneInputs. The staged inputs need to be flushed before. */
+bool zoneInputsChangedSinceEventIteration(FMUBuilding* bui){
+  const ExchangeCache* exc = (ExchangeCache*)bui->exchangeCache;
+  size_t i;
+  if (exc == NULL)
+    return false;
+  for(i = 0; i < exc->nZon*exc->nInpZon; i++){
+    if (exc->inpIsSet[i] != exc->evtInpIsSet[i] || (exc->inpIsSet[i] && exc->inpVals[i] != exc->evtInpVals[i]))
+      return true;
+  }
+  return false;
+}
+
+/* Get the outputs of all zones whose cached outputs are out of date */
+static void updateZoneOutputs(FMUBuilding* bui, ExchangeCache* exc){
+  size_t iZon;
+  size_t n = 0;
+  fmi2_status_t status;
+  double tStart;
+
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (!exc->outIsValid[iZon]){
+      memcpy(&(exc->bufValRefs[n]), &(exc->outValRefs[iZon*exc->nOutZon]), exc->nOutZon*sizeof(fmi2ValueReference));
+      n += exc->nOutZon;
+    }
+  }
+
+  if (bui->logLevel >= TIMESTEP)
+    bui->SpawnFormatMessage("%.3f %s: Getting %lu zone outputs from EnergyPlus.\n", bui->time, bui->modelicaNameBuilding, (unsigned long)n);
+
+  tStart = startStatistics(bui);
+  status = fmi2_import_get_real(bui->fmu, exc->bufValRefs, n, exc->bufVals);
+  addFMUCallStatistics(bui, statisticsGetReal, n, tStart);
+  if (status != (fmi2_status_t)fmi2OK) {
+    bui->SpawnFormatError("Failed to get zone outputs for %s\n", bui->modelicaNameBuilding);
+  }
+
+  n = 0;
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (!exc->outIsValid[iZon]){
+      memcpy(&(exc->outVals[iZon*exc->nOutZon]), &(exc->bufVals[n]), exc->nOutZon*sizeof(fmi2Real));
+      exc->outIsValid[iZon] = true;
+      n += exc->nOutZon;
+    }
+  }
+}
+
+/* Assign the outputs of the zone to zone->outputs */
+void getZoneOutputs(FMUZone* zone){
+  FMUBuilding* bui = zone->bui;
+  ExchangeCache* exc = getExchangeCache(bui);
+  spawnReals* out = zone->outputs;
+
+  flushExchangeCache(bui);
+  if (!exc->outIsValid[zone->iExc])
+    updateZoneOutputs(bui, exc);
+
+  memcpy(out->valsEP, &(exc->outVals[zone->iExc*exc->nOutZon]), out->n*sizeof(fmi2Real));
+  /* Set SI unit value, and only search for the NaN if there is one */
+  if (convertToSI(out))
+    stopIfResultsAreNaN(bui, zone->modelicaNameThermalZone, out);
+}
+
+/* Return the value in SI units of the value valEP in EnergyPlus units of element i of r */
+static double toSI(double valEP, const spawnReals* r, size_t i){
+  return valEP*r->factors[i] + r->offsets[i];
+}
+
+/* Return the value in EnergyPlus units of the value valSI in SI units of element i of r */
+static double fromSI(double valSI, const spawnReals* r, size_t i){
+  return (valSI - r->offsets[i])/r->factors[i];
+}
+
+/* Return true if the zone has sent or staged its temperature */
+static bool hasTemperature(const ExchangeCache* exc, size_t iZon){
+  const size_t iInp = iZon*exc->nInpZon + ZONE_INPUT_T;
+  return exc->inpIsSet[iInp] || exc->inpIsDirty[iInp];
+}
+
+/* Return the temperature of the zone in SI units */
+static double getTemperature(const ExchangeCache* exc, const FMUZone* zone){
+  return toSI(exc->inpVals[zone->iExc*exc->nInpZon + ZONE_INPUT_T], zone->inputs, ZONE_INPUT_T);
+}
+
+/* Stage the temperature TEP, in EnergyPlus units, of the zone with index iZon */
+static void stageTemperature(ExchangeCache* exc, size_t iZon, double TEP){
+  const size_t iInp = iZon*exc->nInpZon + ZONE_INPUT_T;
+  exc->inpVals[iInp] = TEP;
+  if (!exc->inpIsDirty[iInp]){
+    exc->inpIsDirty[iInp] = true;
+    exc->nDirty++;
+  }
+  exc->outIsValid[iZon] = false;
+}
+
+static void storeDerivative(FMUBuilding* bui, ExchangeCache* exc, const FMUZone* zone, double dQdT){
+  exc->dQdT[zone->iExc] = dQdT;
+  exc->derT[zone->iExc] = getTemperature(exc, zone);
+  exc->derTime[zone->iExc] = bui->time;
+  exc->derIsValid[zone->iExc] = true;
+}
+
+/* Forward difference for all zones of the building, with one set and get call for the
+   perturbed temperatures, and one for the original temperatures */
+static void computeBatchedDifferences(FMUBuilding* bui, ExchangeCache* exc, double dT){
+  size_t iZon;
+  FMUZone* zon;
+
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (hasTemperature(exc, iZon)){
+      zon = (FMUZone*)bui->zones[iZon];
+      exc->bufSeed[iZon] = exc->inpVals[iZon*exc->nInpZon + ZONE_INPUT_T];
+      stageTemperature(exc, iZon, fromSI(getTemperature(exc, zon) + dT, zon->inputs, ZONE_INPUT_T));
+    }
+  }
+  flushExchangeCache(bui);
+  updateZoneOutputs(bui, exc);
+  /* Store the perturbed heat flow rate, and restore the temperature */
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (hasTemperature(exc, iZon)){
+      zon = (FMUZone*)bui->zones[iZon];
+      exc->dQdT[iZon] = toSI(exc->outVals[iZon*exc->nOutZon + ZONE_OUTPUT_QCONSEN_FLOW], zon->outputs, ZONE_OUTPUT_QCONSEN_FLOW);
+      stageTemperature(exc, iZon, exc->bufSeed[iZon]);
+    }
+  }
+  flushExchangeCache(bui);
+  updateZoneOutputs(bui, exc);
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (hasTemperature(exc, iZon)){
+      zon = (FMUZone*)bui->zones[iZon];
+      storeDerivative(bui, exc, zon,
+        (exc->dQdT[iZon] - toSI(exc->outVals[iZon*exc->nOutZon + ZONE_OUTPUT_QCONSEN_FLOW], zon->outputs, ZONE_OUTPUT_QCONSEN_FLOW))/dT);
+    }
+  }
+}
+
+/* Directional derivatives for all zones of the building with one call.
+   As the heat flow rate of a zone only depends on the temperature of that zone,
+   seeding all temperatures at once yields the derivative of each zone. */
+static void computeDirectionalDerivatives(FMUBuilding* bui, ExchangeCache* exc){
+  size_t iZon;
+  size_t n = 0;
+  FMUZone* zon;
+  fmi2_status_t status;
+  double tStart;
+
+  flushExchangeCache(bui);
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (hasTemperature(exc, iZon)){
+      exc->bufValRefs[n] = exc->inpValRefs[iZon*exc->nInpZon + ZONE_INPUT_T];
+      exc->bufValRefs[exc->nZon + n] = exc->outValRefs[iZon*exc->nOutZon + ZONE_OUTPUT_QCONSEN_FLOW];
+      exc->bufSeed[n] = 1;
+      n++;
+    }
+  }
+  tStart = startStatistics(bui);
+  status = fmi2_import_get_directional_derivative(bui->fmu,
+    exc->bufValRefs, n, &(exc->bufValRefs[exc->nZon]), n, exc->bufSeed, exc->bufVals);
+  addFMUCallStatistics(bui, statisticsGetDirectionalDerivative, n, tStart);
+  if (status != (fmi2_status_t)fmi2OK) {
+    bui->SpawnFormatError("Failed to get directional derivatives of the zone heat flow rates for %s\n", bui->modelicaNameBuilding);
+  }
+  n = 0;
+  for(iZon = 0; iZon < exc->nZon; iZon++){
+    if (hasTemperature(exc, iZon)){
+      zon = (FMUZone*)bui->zones[iZon];
+      /* Scale the derivative from EnergyPlus to SI units */
+      storeDerivative(bui, exc, zon,
+        exc->bufVals[n] * zon->outputs->factors[ZONE_OUTPUT_QCONSEN_FLOW] / zon->inputs->factors[ZONE_INPUT_T]);
+      n++;
+    }
+  }
+}
+
+/* Return dQConSen_flow/dT of the zone in SI units for the inputs zone->inputs->valsSI.
+   The inputs of the zone are staged, and the cached outputs are for these inputs
+   when this function returns. dT is the temperature increment used for differences. */
+double getZoneHeatFlowDerivative(FMUZone* zone, double dT){
+  FMUBuilding* bui = zone->bui;
+  ExchangeCache* exc = getExchangeCache(bui);
+  const size_t iZon = zone->iExc;
+  const double T = zone->inputs->valsSI[ZONE_INPUT_T];
+  double QConSenPer_flow;
+
+  setZoneInputs(zone);
+  if (exc->derIsValid[iZon]
+      && fabs(T - exc->derT[iZon]) <= exc->derDTMax
+      && fabs(bui->time - exc->derTime[iZon]) <= exc->derTimeMax){
+    if (bui->logLevel >= TIMESTEP)
+      bui->SpawnFormatMessage("%.3f %s: Reusing dQConSen_flow computed at T = %.4f K and time = %.3f.\n",
+        bui->time, zone->modelicaNameThermalZone, exc->derT[iZon], exc->derTime[iZon]);
+    return exc->dQdT[iZon];
+  }
+
+  switch (exc->derMethod){
+  case derivativeDirectional:
+    computeDirectionalDerivatives(bui, exc);
+    break;
+  case derivativeBatched:
+    computeBatchedDifferences(bui, exc, dT);
+    break;
+  default:
+    /* Forward difference for this zone only */
+    zone->inputs->valsSI[ZONE_INPUT_T] = T + dT;
+    setZoneInputs(zone);
+    getZoneOutputs(zone);
+    QConSenPer_flow = zone->outputs->valsSI[ZONE_OUTPUT_QCONSEN_FLOW];
+    zone->inputs->valsSI[ZONE_INPUT_T] = T;
+    setZoneInputs(zone);
+    getZoneOutputs(zone);
+    storeDerivative(bui, exc, zone, (QConSenPer_flow - zone->outputs->valsSI[ZONE_OUTPUT_QCONSEN_FLOW])/dT);
+  }
+  return exc->dQdT[iZon];
+}
+
+/* Mark the cached outputs of all zones as out of date.
+   If derivatives is true, and approximate reuse is not enabled, also mark the derivatives as out of date. */
+void invalidateExchangeCache(FMUBuilding* bui, bool derivatives){
+  ExchangeCache* exc = (ExchangeCache*)bui->exchangeCache;
+  if (exc != NULL){
+    memset(exc->outIsValid, 0, exc->nZon*sizeof(bool));
+    if (derivatives && !exc->derIsApproximate)
+      memset(exc->derIsValid, 0, exc->nZon*sizeof(bool));
+  }
+}
+
+void freeExchangeCache(FMUBuilding* bui){
+  ExchangeCache* exc = (ExchangeCache*)bui->exchangeCache;
+  if (exc == NULL)
+    return;
+  free(exc->inpValRefs);
+  free(exc->inpVals);
+  free(exc->inpIsSet);
+  free(exc->inpIsDirty);
+  free(exc->evtInpVals);
+  free(exc->evtInpIsSet);
+  free(exc->outValRefs);
+  free(exc->outVals);
+  free(exc->outIsValid);
+  free(exc->bufValRefs);
+  free(exc->bufVals);
+  free(exc->bufSeed);
+  free(exc->dQdT);
+  free(exc->derT);
+  free(exc->derTime);
+  free(exc->derIsValid);
+  free(exc);
+  bui->exchangeCache = NULL;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Building-level cache of the inputs and outputs of all zones.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_ExchangeCache_h
+#define Buildings_ExchangeCache_h
+
+#include "EnergyPlusTypes.h"
+
+#include <stdbool.h>
+
+/* Environment variable with the method used to compute dQConSen_flow/dT of the zones.
+   It can be set to
+     difference  - forward difference for each zone, using two set and get calls per zone,
+     batched     - forward difference for all zones of the building, using two set and get calls in total,
+     directional - fmi2GetDirectionalDerivative for all zones of the building, using one call in total,
+     auto        - directional if the FMU provides directional derivatives, otherwise difference.
+   The default is difference. The methods batched and directional assume that the heat flow rate
+   of a zone only depends on the temperature of this zone, and they change the numerical values
+   of dQConSen_flow. */
+#define SPAWN_DERIVATIVE "MODELICA_BUILDINGS_SPAWN_DERIVATIVE"
+/* Environment variable with the maximum change of the zone temperature in K for which
+   a previously computed derivative is reused. If neither this nor SPAWN_DERIVATIVE_TIME is set,
+   derivatives are only reused for the same inputs of the zone at the same time, and until an
+   input variable is set. */
+#define SPAWN_DERIVATIVE_DT "MODELICA_BUILDINGS_SPAWN_DERIVATIVE_DT"
+/* Environment variable with the maximum time in s since the derivative was computed
+   for which it is reused. If it is not set, there is no limit. */
+#define SPAWN_DERIVATIVE_TIME "MODELICA_BUILDINGS_SPAWN_DERIVATIVE_TIME"
+
+/* Index of the zone air temperature in the zone inputs, and of the convective sensible heat flow rate in the zone outputs */
+#define ZONE_INPUT_T 0
+#define ZONE_OUTPUT_QCONSEN_FLOW 1
+
+typedef enum {derivativeAuto, derivativeDifference, derivativeBatched, derivativeDirectional} DerivativeMethod;
+
+typedef struct ExchangeCache
+{
+  size_t nZon;                   /* Number of zones in the cache */
+  size_t nInpZon;                /* Number of inputs per zone */
+  size_t nOutZon;                /* Number of outputs per zone */
+
+  fmi2ValueReference* inpValRefs; /* Value references of the inputs of all zones */
+  fmi2Real* inpVals;             /* Inputs of all zones in EnergyPlus units */
+  bool* inpIsSet;                /* Flag, true if the input has been sent to the FMU */
+  bool* inpIsDirty;              /* Flag, true if the input has been staged but not yet sent to the FMU */
+  size_t nDirty;                 /* Number of inputs that are staged but not yet sent to the FMU */
+  fmi2Real* evtInpVals;          /* Inputs of all zones that had been sent to the FMU at the last event iteration */
+  bool* evtInpIsSet;             /* Value of inpIsSet at the last event iteration */
+
+  fmi2ValueReference* outValRefs; /* Value references of the outputs of all zones */
+  fmi2Real* outVals;             /* Outputs of all zones in EnergyPlus units */
+  bool* outIsValid;              /* Flag for each zone, true if its outputs in outVals are up to date */
+
+  fmi2ValueReference* bufValRefs; /* Work array for the value references of one set or get call */
+  fmi2Real* bufVals;             /* Work array for the values of one set or get call */
+  fmi2Real* bufSeed;             /* Work array for the seed of the directional derivatives */
+
+  DerivativeMethod derMethod;    /* Method used to compute dQConSen_flow/dT */
+  double derDTMax;               /* Maximum temperature change for which a derivative is reused */
+  double derTimeMax;             /* Maximum time since its computation for which a derivative is reused */
+  double* dQdT;                  /* dQConSen_flow/dT of each zone in SI units */
+  double* derT;                  /* Temperature in K at which dQdT was computed */
+  double* derTime;               /* Time at which dQdT was computed */
+  bool* derIsValid;              /* Flag, true if dQdT has been computed for the zone and may be reused */
+  bool derIsApproximate;         /* Flag, true if derivatives are reused after the state of the FMU changed */
+} ExchangeCache;
+
+void setZoneInputs(FMUZone* zone);
+
+void getZoneOutputs(FMUZone* zone);
+
+double getZoneHeatFlowDerivative(FMUZone* zone, double dT);
+
+void flushExchangeCache(FMUBuilding* bui);
+
+void storeEventIterationZoneInputs(FMUBuilding* bui);
+
+bool zoneInputsChangedSinceEventIteration(FMUBuilding* bui);
+
+void invalidateExchangeCache(FMUBuilding* bui, bool derivatives);
+
+void freeExchangeCache(FMUBuilding* bui);
+
+#endif
@@ -0,0 +1,479 @@
+/*
+ * Persistent cache for the EnergyPlus FMUs generated by spawn.
+ *
+ * The cache directory contains the FMUs, stored as <key>.fmu, and an index
+ * file with the size and the time of last use of each FMU.
+ * The key is the hash of the model hash, which includes the content of the idf and the
+ * weather file, and of the size and modification time of the spawn executable.
+ * Hence, simulations of the same building with different controls, and
+ * subsequent runs of a parameter sweep, reuse the FMU rather than calling
+ * spawn again. If the cache grows larger than its maximum size,
+ * the least recently used FMUs are removed.
+ *
+ * The index is written to a temporary file that is then renamed, so that
+ * simulations that run in parallel never see a partially written index.
+ * If two simulations update the index at the same time, one update may be lost,
+ * which only affects the order of eviction.
+ *
+ * Independent of the cache directory, the temporary directory of each building
+ * records the hash of the FMU that is unpacked in it. If the FMU is byte-identical
+ * in the next simulation, the FMU is not unzipped again.
+ * The unpacked files are not shared between buildings, as each building must load
+ * its own copy of the EnergyPlus library.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "FMUCache.h"
+
+#ifndef Buildings_FMUCache_c
+#define Buildings_FMUCache_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _MSC_VER
+#include <windows.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#define FMU_CACHE_INDEX "index.txt"
+#define FMU_CACHE_KEY_LENGTH FAST_HASH_HEX_LENGTH
+/* Maximum length of a key in the index, which may have been written by an earlier version with longer keys */
+#define FMU_CACHE_MAX_KEY_LENGTH 64
+
+typedef struct FMUCacheEntry{
+  char key[FMU_CACHE_MAX_KEY_LENGTH+1]; /* Key of the FMU */
+  unsigned long size;               /* Size of the FMU in bytes */
+  long lastUsed;                    /* Time of last use in seconds since the epoch */
+} FMUCacheEntry;
+
+const char* getFMUCacheDirectory(){
+  const char* dir = getenv(FMU_CACHE_DIRECTORY);
+  if (dir == NULL || strlen(dir) == 0)
+    return NULL;
+  return dir;
+}
+
+/* Return the maximum size of the cache in bytes */
+static double getFMUCacheSize(){
+  const char* str = getenv(FMU_CACHE_SIZE);
+  char* end;
+  double size;
+
+  if (str != NULL){
+    size = strtod(str, &end);
+    if (end != str && size > 0)
+      return size * 1024 * 1024;
+  }
+  return (double)FMU_CACHE_SIZE_DEFAULT * 1024 * 1024;
+}
+
+/* Return the name cacheDir/name, which needs to be freed by the caller */
+static char* getCacheFileName(
+  const char* cacheDir,
+  const char* name,
+  void (*SpawnFormatError)(const char *string, ...)){
+  char* fileName;
+  const size_t len = strlen(cacheDir) + strlen(SEPARATOR) + strlen(name) + 1;
+
+  mallocString(len, "Failed to allocate memory for file name in FMUCache.c.", &fileName, SpawnFormatError);
+  strcpy(fileName, cacheDir);
+  strcat(fileName, SEPARATOR);
+  strcat(fileName, name);
+  return fileName;
+}
+
+/* Create the directory dirName and its parent directories.
+   Return 0 on success. */
+static int createDirectories(const char* dirName){
+  struct stat st;
+  char* dir;
+  char* p;
+  int ret = 0;
+
+  if (stat(dirName, &st) == 0)
+    return 0;
+
+  dir = malloc((strlen(dirName)+1) * sizeof(char));
+  if (dir == NULL)
+    return -1;
+  strcpy(dir, dirName);
+
+  for(p = dir + 1; *p != '\0' && ret == 0; p++){
+    if (*p == '/'){
+      *p = '\0';
+      if (stat(dir, &st) != 0 && mkdir(dir, 0700) != 0 && errno != EEXIST)
+        ret = -1;
+      *p = '/';
+    }
+  }
+  if (ret == 0 && mkdir(dir, 0700) != 0 && errno != EEXIST)
+    ret = -1;
+
+  free(dir);
+  return ret;
+}
+
+/* Copy the file src to des. Return 0 on success. */
+static int copyFile(const char* src, const char* des){
+  FILE* srcFil;
+  FILE* desFil;
+  size_t n;
+  unsigned char buff[16384];
+  int ret = 0;
+
+  srcFil = fopen(src, "rb");
+  if (srcFil == NULL)
+    return -1;
+  desFil = fopen(des, "wb");
+  if (desFil == NULL){
+    fclose(srcFil);
+    return -1;
+  }
+
+  while ((n = fread(buff, 1, sizeof(buff), srcFil)) > 0){
+    if (fwrite(buff, 1, n, desFil) != n){
+      ret = -1;
+      break;
+    }
+  }
+  if (ferror(srcFil))
+    ret = -1;
+  fclose(srcFil);
+  if (fclose(desFil) != 0)
+    ret = -1;
+  if (ret != 0)
+    remove(des);
+  return ret;
+}
+
+/* Create des as a hard link to src, or as a copy of src if the
+   file system does not support a link. Return 0 on success. */
+static int linkOrCopyFile(const char* src, const char* des){
+#ifndef _WIN32
+  if (link(src, des) == 0)
+    return 0;
+#endif
+  return copyFile(src, des);
+}
+
+/* Read the cache index. Return the entries, which need to be freed by the caller,
+   or NULL if the index does not exist. */
+static FMUCacheEntry* readIndex(const char* indexFile, size_t* n){
+  FILE* fp;
+  FMUCacheEntry ent;
+  FMUCacheEntry* entries = NULL;
+  FMUCacheEntry* tmp;
+  size_t nAll = 0;
+
+  *n = 0;
+  fp = fopen(indexFile, "r");
+  if (fp == NULL)
+    return NULL;
+
+  while (fscanf(fp, "%64s %lu %ld", ent.key, &ent.size, &ent.lastUsed) == 3){
+    if (*n == nAll){
+      nAll = (nAll == 0) ? 16 : 2*nAll;
+      tmp = realloc(entries, nAll * sizeof(FMUCacheEntry));
+      if (tmp == NULL){
+        free(entries);
+        fclose(fp);
+        *n = 0;
+        return NULL;
+      }
+      entries = tmp;
+    }
+    entries[*n] = ent;
+    (*n)++;
+  }
+  fclose(fp);
+  return entries;
+}
+
+/* Write the cache index. Return 0 on success. */
+static int writeIndex(
+  const char* indexFile,
+  const FMUCacheEntry* entries,
+  size_t n,
+  void (*SpawnFormatError)(const char *string, ...)){
+  FILE* fp;
+  char* tmpFile;
+  size_t i;
+  int ret = 0;
+
+  mallocString(strlen(indexFile) + 32, "Failed to allocate memory for index file name in FMUCache.c.", &tmpFile, SpawnFormatError);
+  sprintf(tmpFile, "%s.%ld.tmp", indexFile, (long)getpid());
+
+  fp = fopen(tmpFile, "w");
+  if (fp == NULL){
+    free(tmpFile);
+    return -1;
+  }
+  for(i = 0; i < n; i++){
+    if (fprintf(fp, "%s %lu %ld\n", entries[i].key, entries[i].size, entries[i].lastUsed) < 0)
+      ret = -1;
+  }
+  if (fclose(fp) != 0)
+    ret = -1;
+
+#ifdef _WIN32
+  /* rename fails on Windows if the target exists */
+  if (ret == 0)
+    remove(indexFile);
+#endif
+  if (ret == 0 && rename(tmpFile, indexFile) != 0)
+    ret = -1;
+  if (ret != 0)
+    remove(tmpFile);
+  free(tmpFile);
+  return ret;
+}
+
+/* Mark the FMU with the given key as used now, and remove the least
+   recently used FMUs until the cache is smaller than its maximum size. */
+static void updateIndex(const FMUBuilding* bui, const char* cacheDir, const char* key, unsigned long size){
+  char* indexFile;
+  char* fmuFile;
+  char fmuName[FMU_CACHE_MAX_KEY_LENGTH+5];
+  FMUCacheEntry* entries;
+  FMUCacheEntry* tmp;
+  struct stat st;
+  size_t n;
+  size_t i;
+  size_t iOld;
+  size_t nKeep;
+  bool found = false;
+  double total = 0;
+  const double maxSize = getFMUCacheSize();
+  const long now = (long)time(NULL);
+
+  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  indexFile = getCacheFileName(cacheDir, FMU_CACHE_INDEX, SpawnFormatError);
+  entries = readIndex(indexFile, &n);
+
+  /* Remove the entries of FMUs that have been deleted, and update the entry of this FMU.
+     FMUs whose key has a different length have been added by an earlier version
+     and can never be used, hence they are removed. */
+  nKeep = 0;
+  for(i = 0; i < n; i++){
+    sprintf(fmuName, "%s.fmu", entries[i].key);
+    fmuFile = getCacheFileName(cacheDir, fmuName, SpawnFormatError);
+    if (strlen(entries[i].key) != FMU_CACHE_KEY_LENGTH){
+      remove(fmuFile);
+    }
+    else if (stat(fmuFile, &st) == 0){
+      if (strcmp(entries[i].key, key) == 0){
+        entries[i].size = size;
+        entries[i].lastUsed = now;
+        found = true;
+      }
+      entries[nKeep] = entries[i];
+      nKeep++;
+    }
+    free(fmuFile);
+  }
+  n = nKeep;
+
+  if (!found){
+    tmp = realloc(entries, (n+1) * sizeof(FMUCacheEntry));
+    if (tmp == NULL){
+      free(entries);
+      free(indexFile);
+      SpawnFormatError("Failed to allocate memory for FMU cache index in FMUCache.c.");
+      return;
+    }
+    entries = tmp;
+    strcpy(entries[n].key, key);
+    entries[n].size = size;
+    entries[n].lastUsed = now;
+    n++;
+  }
+
+  /* Remove the least recently used FMUs, except the one that is used now */
+  for(i = 0; i < n; i++)
+    total += (double)entries[i].size;
+  while (total > maxSize && n > 1){
+    iOld = n;
+    for(i = 0; i < n; i++){
+      if (strcmp(entries[i].key, key) != 0 && (iOld == n || entries[i].lastUsed < entries[iOld].lastUsed))
+        iOld = i;
+    }
+    if (iOld == n)
+      break;
+    sprintf(fmuName, "%s.fmu", entries[iOld].key);
+    fmuFile = getCacheFileName(cacheDir, fmuName, SpawnFormatError);
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Removing least recently used FMU %s from cache.\n", bui->modelicaNameBuilding, fmuFile);
+    remove(fmuFile);
+    free(fmuFile);
+    total -= (double)entries[iOld].size;
+    entries[iOld] = entries[n-1];
+    n--;
+  }
+
+  if (writeIndex(indexFile, entries, n, SpawnFormatError) != 0)
+    SpawnFormatMessage("---- %s: Warning: Failed to write FMU cache index %s.\n", bui->modelicaNameBuilding, indexFile);
+
+  free(entries);
+  free(indexFile);
+}
+
+char* getFMUCacheKey(const FMUBuilding* bui, const char* spawnExe){
+  char spaSta[64];
+  char* key;
+  struct stat st;
+  FastHash ctx;
+
+  /* A new version of spawn may generate a different FMU.
+     The content of the idf and the weather file is part of the model hash. */
+  if (stat(spawnExe, &st) != 0)
+    return NULL;
+  sprintf(spaSta, "\n%lu %ld", (unsigned long)st.st_size, (long)st.st_mtime);
+
+  fastHashInit(&ctx);
+  fastHashUpdate(&ctx, bui->modelHash, strlen(bui->modelHash));
+  fastHashUpdate(&ctx, spaSta, strlen(spaSta));
+  mallocString(FMU_CACHE_KEY_LENGTH+1, "Failed to allocate memory for FMU cache key.", &key, bui->SpawnFormatError);
+  fastHashFinal(&ctx, key);
+  return key;
+}
+
+bool getFMUFromCache(const FMUBuilding* bui, const char* cacheDir, const char* key){
+  char fmuName[FMU_CACHE_MAX_KEY_LENGTH+5];
+  char* fmuFile;
+  struct stat st;
+  bool found = false;
+
+  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+
+  sprintf(fmuName, "%s.fmu", key);
+  fmuFile = getCacheFileName(cacheDir, fmuName, bui->SpawnFormatError);
+
+  /* The FMU may be removed by another simulation after stat, in which case it is generated */
+  if (stat(fmuFile, &st) == 0 && linkOrCopyFile(fmuFile, bui->fmuAbsPat) == 0){
+    if (bui->logLevel >= MEDIUM)
+      SpawnFormatMessage("---- %s: Using FMU %s from cache.\n", bui->modelicaNameBuilding, fmuFile);
+    updateIndex(bui, cacheDir, key, (unsigned long)st.st_size);
+    found = true;
+  }
+
+  free(fmuFile);
+  return found;
+}
+
+void addFMUToCache(const FMUBuilding* bui, const char* cacheDir, const char* key){
+  char fmuName[FMU_CACHE_MAX_KEY_LENGTH+5];
+  char* fmuFile;
+  char* tmpFile;
+  struct stat st;
+
+  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  if (createDirectories(cacheDir) != 0){
+    SpawnFormatMessage("---- %s: Warning: Failed to create FMU cache directory %s: %s.\n",
+      bui->modelicaNameBuilding, cacheDir, strerror(errno));
+    return;
+  }
+  if (stat(bui->fmuAbsPat, &st) != 0)
+    return;
+
+  sprintf(fmuName, "%s.fmu", key);
+  fmuFile = getCacheFileName(cacheDir, fmuName, SpawnFormatError);
+  mallocString(strlen(fmuFile) + 32, "Failed to allocate memory for file name in FMUCache.c.", &tmpFile, SpawnFormatError);
+  sprintf(tmpFile, "%s.%ld.tmp", fmuFile, (long)getpid());
+
+  /* Add the FMU under a temporary name and rename it, so that
+     other simulations never see a partially written FMU */
+  if (linkOrCopyFile(bui->fmuAbsPat, tmpFile) != 0){
+    SpawnFormatMessage("---- %s: Warning: Failed to add FMU to cache %s.\n", bui->modelicaNameBuilding, cacheDir);
+  }
+  else{
+#ifdef _WIN32
+    /* rename fails on Windows if another simulation added the FMU already */
+    if (access(fmuFile, F_OK) == 0)
+      remove(tmpFile);
+    else
+#endif
+    if (rename(tmpFile, fmuFile) != 0){
+      remove(tmpFile);
+      SpawnFormatMessage("---- %s: Warning: Failed to add FMU to cache %s.\n", bui->modelicaNameBuilding, cacheDir);
+    }
+    else{
+      if (bui->logLevel >= MEDIUM)
+        SpawnFormatMessage("---- %s: Added FMU %s to cache.\n", bui->modelicaNameBuilding, fmuFile);
+      updateIndex(bui, cacheDir, key, (unsigned long)st.st_size);
+    }
+  }
+
+  free(tmpFile);
+  free(fmuFile);
+}
+
+/* Return the hash of the content of the FMU, or NULL if the FMU cannot be read */
+static const char* getFMUHash(FMUBuilding* bui){
+  char hexDigest[FAST_HASH_HEX_LENGTH+1];
+
+  if (bui->fmuHash == NULL && fastHashFileHex(bui->fmuAbsPat, hexDigest) == 0){
+    mallocString(strlen(hexDigest)+1, "Failed to allocate memory for FMU hash.", &(bui->fmuHash), bui->SpawnFormatError);
+    strcpy(bui->fmuHash, hexDigest);
+  }
+  return bui->fmuHash;
+}
+
+/* Return true if the temporary directory of the building contains the unpacked files of an FMU
+   with the same content as bui->fmuAbsPat */
+bool isFMUUnpacked(FMUBuilding* bui){
+  char* hashFileName;
+  char hexDigest[FAST_HASH_HEX_LENGTH+1];
+  const char* fmuHash;
+  FILE* fp;
+  bool unpacked = false;
+
+  fmuHash = getFMUHash(bui);
+  if (fmuHash == NULL)
+    return false;
+
+  hashFileName = getCacheFileName(bui->tmpDir, FMU_UNPACKED_HASH, bui->SpawnFormatError);
+  fp = fopen(hashFileName, "r");
+  if (fp != NULL){
+    unpacked = (fscanf(fp, "%32s", hexDigest) == 1 && strcmp(hexDigest, fmuHash) == 0);
+    fclose(fp);
+  }
+  free(hashFileName);
+  return unpacked;
+}
+
+/* Record in the temporary directory of the building whether the FMU is completely unpacked in it.
+   This needs to be set to false before the FMU is unzipped, as the unzip may fail. */
+void setFMUUnpacked(const FMUBuilding* bui, bool unpacked){
+  char* hashFileName;
+  FILE* fp;
+  int ret;
+
+  hashFileName = getCacheFileName(bui->tmpDir, FMU_UNPACKED_HASH, bui->SpawnFormatError);
+  if (!unpacked || bui->fmuHash == NULL){
+    remove(hashFileName);
+  }
+  else{
+    fp = fopen(hashFileName, "w");
+    if (fp != NULL){
+      ret = fprintf(fp, "%s\n", bui->fmuHash);
+      /* Remove a partially written file so that the unzip is not skipped */
+      if (fclose(fp) != 0 || ret < 0)
+        remove(hashFileName);
+    }
+  }
+  free(hashFileName);
+}
+
+#endif
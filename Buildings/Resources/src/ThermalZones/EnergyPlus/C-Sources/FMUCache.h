@@ -0,0 +1,38 @@
+/*
+ * Persistent cache for the EnergyPlus FMUs generated by spawn.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_FMUCache_h
+#define Buildings_FMUCache_h
+
+#include "EnergyPlusTypes.h"
+#include "EnergyPlusUtil.h"
+#include "fastHash.h"
+
+#include <stdbool.h>
+
+/* Environment variable with the directory of the FMU cache.
+   If it is not set, or set to an empty string, no cache is used. */
+#define FMU_CACHE_DIRECTORY "MODELICA_BUILDINGS_FMU_CACHE"
+/* Environment variable with the maximum size of the FMU cache in MB */
+#define FMU_CACHE_SIZE "MODELICA_BUILDINGS_FMU_CACHE_SIZE"
+/* Default maximum size of the FMU cache in MB */
+#define FMU_CACHE_SIZE_DEFAULT 2048
+
+/* File in the temporary directory of the building with the hash of the FMU that is unpacked in this directory */
+#define FMU_UNPACKED_HASH "unpackedFMU.hash"
+
+const char* getFMUCacheDirectory();
+
+char* getFMUCacheKey(const FMUBuilding* bui, const char* spawnExe);
+
+bool getFMUFromCache(const FMUBuilding* bui, const char* cacheDir, const char* key);
+
+void addFMUToCache(const FMUBuilding* bui, const char* cacheDir, const char* key);
+
+bool isFMUUnpacked(FMUBuilding* bui);
+
+void setFMUUnpacked(const FMUBuilding* bui, bool unpacked);
+
+#endif
@@ -14,16 +14,13 @@
 FMUInputVariable* checkForDoubleInputVariableDeclaration(
   const struct FMUBuilding* bui,
   const char* fmiName){
-  size_t iComVar;
+  FMUInputVariable* ptrInpVar = (FMUInputVariable*)findRegisteredObject(registryInputVariableFMIName, bui, fmiName);
 
-  for(iComVar = 0; iComVar < bui->nInputVariables; iComVar++){
-    FMUInputVariable* ptrInpVar = (FMUInputVariable*)(bui->inputVariables[iComVar]);
-    if (!strcmp(fmiName, ptrInpVar->inputs->fmiNames[0])){
-      if (bui->logLevel >= MEDIUM){
-        bui->SpawnFormatMessage("---- %s: *** Searched for input variable %s and found it.\n", bui->modelicaNameBuilding, fmiName);
-      }
-      return ptrInpVar;
+  if (ptrInpVar != NULL){
+    if (bui->logLevel >= MEDIUM){
+      bui->SpawnFormatMessage("---- %s: *** Searched for input variable %s and found it.\n", bui->modelicaNameBuilding, fmiName);
     }
+    return ptrInpVar;
   }
   if (bui->logLevel >= MEDIUM){
      bui->SpawnFormatMessage("---- %s: *** Searched for input variable %s in building but did not find it.\n", bui->modelicaNameBuilding, fmiName);
@@ -32,21 +29,9 @@ FMUInputVariable* checkForDoubleInputVariableDeclaration(
 }
 
 void setInputVariablePointerIfAlreadyInstanciated(const char* modelicaNameInputVariable, FMUInputVariable** ptrFMUInputVariable){
-  size_t iBui;
-  size_t iCom;
-  FMUBuilding* ptrBui;
-  FMUInputVariable* ptrInpVar;
-
-  for(iBui = 0; iBui < getBuildings_nFMU(); iBui++){
-    ptrBui = getBuildingsFMU(iBui);
-    for(iCom = 0; iCom < ptrBui->nInputVariables; iCom++){
-      ptrInpVar = (FMUInputVariable*)(ptrBui->inputVariables[iCom]);
-      if (strcmp(modelicaNameInputVariable, ptrInpVar->modelicaNameInputVariable) == 0){
-        *ptrFMUInputVariable = ptrInpVar;
-        return;
-      }
-    }
-  }
+  FMUInputVariable* ptrInpVar = (FMUInputVariable*)findRegisteredObject(registryInputVariable, NULL, modelicaNameInputVariable);
+  if (ptrInpVar != NULL)
+    *ptrFMUInputVariable = ptrInpVar;
   return;
 }
 
@@ -25,9 +25,18 @@ void EnergyPlusInputVariableExchange(
   FMUBuilding* bui = inpVar->bui;
 
   fmi2Status status;
+  double tStart;
+  double tExchange;
 
-  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
-  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+  void (*SpawnFormatMessage)(const char *string, ...);
+  void (*SpawnFormatError)(const char *string, ...);
+
+  /* Wait until the worker of the building, if any, completed its time advance,
+     before the building is accessed */
+  waitForBuildingWorker(bui);
+  SpawnFormatMessage = bui->SpawnFormatMessage;
+  SpawnFormatError = bui->SpawnFormatError;
+  tExchange = startExchangeStatistics(bui);
 
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: Exchanging data with EnergyPlus: initialCall = %d, building ptr at %p.\n",
@@ -62,7 +71,9 @@ void EnergyPlusInputVariableExchange(
     if (bui->logLevel >= MEDIUM)
       SpawnFormatMessage("%.3f %s: fmi2_import_exit_initialization_mode: Enter exit initialization mode of FMU in EnergyPlusInputVariableExchange().\n",
         time, inpVar->modelicaNameInputVariable);
+    tStart = startStatistics(bui);
     status = fmi2_import_exit_initialization_mode(bui->fmu);
+    addFMUCallStatistics(bui, statisticsExitInitializationMode, 0, tStart);
     if( status != fmi2OK ){
       SpawnFormatError("Failed to exit initialization mode for FMU for building %s and input variable %s",
         bui->modelicaNameBuilding, inpVar->modelicaNameInputVariable);
@@ -72,7 +83,8 @@ void EnergyPlusInputVariableExchange(
   }
 
   if ( (time - bui->time) > 0.001 ) {
-    /* Real time advanced */
+    /* Real time advanced. Start the time advance of the other buildings that are due at this time */
+    advanceOtherBuildings(bui, time);
     advanceTime_completeIntegratorStep_enterEventMode(bui, inpVar->modelicaNameInputVariable, time);
   }
 
@@ -96,5 +108,7 @@ void EnergyPlusInputVariableExchange(
     SpawnFormatMessage("%.3f %s: Returning from EnergyPlusInputVariableExchange().\n",
       time, inpVar->modelicaNameInputVariable);
 
+  addExchangeStatistics(bui, statisticsInputVariableExchange, tExchange);
+
   return;
 }
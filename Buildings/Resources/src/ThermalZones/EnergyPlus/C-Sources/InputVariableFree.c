@@ -15,6 +15,8 @@ void EnergyPlusInputVariableFree(void* object){
 
     /* The building may not have been instanciated yet if there was an error during instantiation */
     if (com->bui != NULL){
+      unregisterObject(registryInputVariable, NULL, com->modelicaNameInputVariable, com);
+      unregisterObject(registryInputVariableFMIName, com->bui, com->inputs->fmiNames[0], com);
       com->bui->nInputVariables--;
       FMUBuildingFree(com->bui);
     }
@@ -0,0 +1,253 @@
+/*
+ * Process-wide registry of the zones, input variables and output variables,
+ * indexed by interned names.
+ *
+ * All names are stored once in a table of interned strings. Objects are
+ * stored in a hash map with the key (kind, scope, interned name), hence keys
+ * are compared by pointer once the name has been found in the string table.
+ * The registry replaces the loops over all buildings and all of their objects
+ * that were used to find objects that have already been allocated.
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "NameRegistry.h"
+
+#ifndef Buildings_NameRegistry_c
+#define Buildings_NameRegistry_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+typedef struct InternedName{
+  char* str;                   /* The name */
+  size_t hash;                 /* Hash of the name */
+  struct InternedName* next;   /* Next name in the same bucket */
+} InternedName;
+
+typedef struct RegistryEntry{
+  RegistryKind kind;           /* Kind of the object */
+  const void* scope;           /* Scope of the name, or NULL for global names */
+  const char* name;            /* Interned name */
+  size_t hash;                 /* Hash of the key */
+  void* object;                /* Registered object */
+  struct RegistryEntry* next;  /* Next entry in the same bucket */
+} RegistryEntry;
+
+static InternedName** Buildings_InternedNames = NULL; /* Buckets of the string table */
+static size_t Buildings_nInternedNameBuckets = 0;
+static size_t Buildings_nInternedNames = 0;
+
+static RegistryEntry** Buildings_RegistryEntries = NULL; /* Buckets of the object map */
+static size_t Buildings_nRegistryBuckets = 0;
+static size_t Buildings_nRegistryEntries = 0;
+
+/* Return the FNV-1a hash of the string str */
+size_t hashString(const char* str){
+  size_t h = 2166136261u;
+  while (*str != '\0'){
+    h ^= (unsigned char)(*str);
+    h *= 16777619u;
+    str++;
+  }
+  return h;
+}
+
+static size_t hashKey(RegistryKind kind, const void* scope, size_t nameHash){
+  size_t h = nameHash;
+  h ^= (size_t)kind * 2654435761u;
+  h ^= (size_t)((uintptr_t)scope >> 4) * 40503u;
+  return h;
+}
+
+/* Return the interned name equal to str, or NULL if str has not been interned */
+static const char* findInternedName(const char* str, size_t hash){
+  InternedName* ent;
+  if (Buildings_nInternedNameBuckets == 0)
+    return NULL;
+  for(ent = Buildings_InternedNames[hash & (Buildings_nInternedNameBuckets-1)]; ent != NULL; ent = ent->next){
+    if (ent->hash == hash && strcmp(ent->str, str) == 0)
+      return ent->str;
+  }
+  return NULL;
+}
+
+/* Resize the buckets of the string table to nNew buckets, which must be a power of 2 */
+static void resizeInternedNames(size_t nNew, void (*SpawnFormatError)(const char *string, ...)){
+  InternedName** buc;
+  InternedName* ent;
+  InternedName* next;
+  size_t i;
+
+  buc = (InternedName**)calloc(nNew, sizeof(InternedName*));
+  if (buc == NULL)
+    SpawnFormatError("Failed to allocate memory for %lu names in NameRegistry.c.", (unsigned long)nNew);
+  for(i = 0; i < Buildings_nInternedNameBuckets; i++){
+    for(ent = Buildings_InternedNames[i]; ent != NULL; ent = next){
+      next = ent->next;
+      ent->next = buc[ent->hash & (nNew-1)];
+      buc[ent->hash & (nNew-1)] = ent;
+    }
+  }
+  if (Buildings_InternedNames != NULL)
+    free(Buildings_InternedNames);
+  Buildings_InternedNames = buc;
+  Buildings_nInternedNameBuckets = nNew;
+}
+
+/* Resize the buckets of the object map to nNew buckets, which must be a power of 2 */
+static void resizeRegistryEntries(size_t nNew, void (*SpawnFormatError)(const char *string, ...)){
+  RegistryEntry** buc;
+  RegistryEntry* ent;
+  RegistryEntry* next;
+  size_t i;
+
+  buc = (RegistryEntry**)calloc(nNew, sizeof(RegistryEntry*));
+  if (buc == NULL)
+    SpawnFormatError("Failed to allocate memory for %lu objects in NameRegistry.c.", (unsigned long)nNew);
+  for(i = 0; i < Buildings_nRegistryBuckets; i++){
+    for(ent = Buildings_RegistryEntries[i]; ent != NULL; ent = next){
+      next = ent->next;
+      ent->next = buc[ent->hash & (nNew-1)];
+      buc[ent->hash & (nNew-1)] = ent;
+    }
+  }
+  if (Buildings_RegistryEntries != NULL)
+    free(Buildings_RegistryEntries);
+  Buildings_RegistryEntries = buc;
+  Buildings_nRegistryBuckets = nNew;
+}
+
+/* Return the interned copy of str, and add it to the string table if needed.
+   The returned pointer is valid until freeNameRegistry() is called. */
+const char* internName(const char* str, void (*SpawnFormatError)(const char *string, ...)){
+  const size_t hash = hashString(str);
+  const char* found = findInternedName(str, hash);
+  InternedName* ent;
+  size_t iBuc;
+
+  if (found != NULL)
+    return found;
+
+  if (Buildings_nInternedNames >= Buildings_nInternedNameBuckets)
+    resizeInternedNames(Buildings_nInternedNameBuckets == 0 ? 64 : 2*Buildings_nInternedNameBuckets, SpawnFormatError);
+
+  ent = (InternedName*)malloc(sizeof(InternedName));
+  if (ent == NULL)
+    SpawnFormatError("Failed to allocate memory for name %s in NameRegistry.c.", str);
+  ent->str = (char*)malloc(strlen(str)+1);
+  if (ent->str == NULL)
+    SpawnFormatError("Failed to allocate memory for name %s in NameRegistry.c.", str);
+  strcpy(ent->str, str);
+  ent->hash = hash;
+  iBuc = hash & (Buildings_nInternedNameBuckets-1);
+  ent->next = Buildings_InternedNames[iBuc];
+  Buildings_InternedNames[iBuc] = ent;
+  Buildings_nInternedNames++;
+  return ent->str;
+}
+
+static RegistryEntry** findRegistryEntry(RegistryKind kind, const void* scope, const char* name){
+  size_t hash;
+  const char* intNam;
+  RegistryEntry** ptrEnt;
+
+  if (Buildings_nRegistryBuckets == 0)
+    return NULL;
+  hash = hashString(name);
+  intNam = findInternedName(name, hash);
+  if (intNam == NULL)
+    return NULL;
+  hash = hashKey(kind, scope, hash);
+  for(ptrEnt = &(Buildings_RegistryEntries[hash & (Buildings_nRegistryBuckets-1)]); *ptrEnt != NULL; ptrEnt = &((*ptrEnt)->next)){
+    if ((*ptrEnt)->name == intNam && (*ptrEnt)->kind == kind && (*ptrEnt)->scope == scope)
+      return ptrEnt;
+  }
+  return NULL;
+}
+
+/* Register object with the key (kind, scope, name).
+   If an object is already registered with this key, the registry is not changed. */
+void registerObject(
+  RegistryKind kind,
+  const void* scope,
+  const char* name,
+  void* object,
+  void (*SpawnFormatError)(const char *string, ...)){
+  RegistryEntry* ent;
+  size_t iBuc;
+
+  if (findRegistryEntry(kind, scope, name) != NULL)
+    return;
+
+  if (Buildings_nRegistryEntries >= Buildings_nRegistryBuckets)
+    resizeRegistryEntries(Buildings_nRegistryBuckets == 0 ? 64 : 2*Buildings_nRegistryBuckets, SpawnFormatError);
+
+  ent = (RegistryEntry*)malloc(sizeof(RegistryEntry));
+  if (ent == NULL)
+    SpawnFormatError("Failed to allocate memory to register %s in NameRegistry.c.", name);
+  ent->kind = kind;
+  ent->scope = scope;
+  ent->name = internName(name, SpawnFormatError);
+  ent->hash = hashKey(kind, scope, hashString(name));
+  ent->object = object;
+  iBuc = ent->hash & (Buildings_nRegistryBuckets-1);
+  ent->next = Buildings_RegistryEntries[iBuc];
+  Buildings_RegistryEntries[iBuc] = ent;
+  Buildings_nRegistryEntries++;
+}
+
+/* Return the object registered with the key (kind, scope, name), or NULL if there is none */
+void* findRegisteredObject(RegistryKind kind, const void* scope, const char* name){
+  RegistryEntry** ptrEnt = findRegistryEntry(kind, scope, name);
+  return (ptrEnt == NULL) ? NULL : (*ptrEnt)->object;
+}
+
+/* Remove the key (kind, scope, name) from the registry if it is registered for object */
+void unregisterObject(RegistryKind kind, const void* scope, const char* name, const void* object){
+  RegistryEntry** ptrEnt = findRegistryEntry(kind, scope, name);
+  RegistryEntry* ent;
+
+  if (ptrEnt == NULL || (*ptrEnt)->object != object)
+    return;
+  ent = *ptrEnt;
+  *ptrEnt = ent->next;
+  free(ent);
+  Buildings_nRegistryEntries--;
+}
+
+/* Free the registry and all interned names */
+void freeNameRegistry(){
+  size_t i;
+  InternedName* nam;
+  InternedName* nextNam;
+  RegistryEntry* ent;
+  RegistryEntry* nextEnt;
+
+  for(i = 0; i < Buildings_nRegistryBuckets; i++){
+    for(ent = Buildings_RegistryEntries[i]; ent != NULL; ent = nextEnt){
+      nextEnt = ent->next;
+      free(ent);
+    }
+  }
+  for(i = 0; i < Buildings_nInternedNameBuckets; i++){
+    for(nam = Buildings_InternedNames[i]; nam != NULL; nam = nextNam){
+      nextNam = nam->next;
+      free(nam->str);
+      free(nam);
+    }
+  }
+  if (Buildings_RegistryEntries != NULL)
+    free(Buildings_RegistryEntries);
+  if (Buildings_InternedNames != NULL)
+    free(Buildings_InternedNames);
+  Buildings_RegistryEntries = NULL;
+  Buildings_nRegistryBuckets = 0;
+  Buildings_nRegistryEntries = 0;
+  Buildings_InternedNames = NULL;
+  Buildings_nInternedNameBuckets = 0;
+  Buildings_nInternedNames = 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Process-wide registry of the zones, input variables and output variables,
+ * indexed by interned names.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_NameRegistry_h
+#define Buildings_NameRegistry_h
+
+#include <stddef.h>  /* stddef defines size_t */
+
+/* Kind of the registered object. Objects of different kinds may have the same name. */
+typedef enum {
+  registryZone,                   /* FMUZone by Modelica instance name, scope NULL */
+  registryInputVariable,          /* FMUInputVariable by Modelica instance name, scope NULL */
+  registryOutputVariable,         /* FMUOutputVariable by Modelica instance name, scope NULL */
+  registryZoneName,               /* FMUZone by zone name in the idf file, scope is the building */
+  registryInputVariableFMIName,   /* FMUInputVariable by fmi name, scope is the building */
+  registryOutputVariableFMIName   /* FMUOutputVariable by fmi name, scope is the building */
+} RegistryKind;
+
+size_t hashString(const char* str);
+
+const char* internName(const char* str, void (*SpawnFormatError)(const char *string, ...));
+
+void registerObject(
+  RegistryKind kind,
+  const void* scope,
+  const char* name,
+  void* object,
+  void (*SpawnFormatError)(const char *string, ...));
+
+void* findRegisteredObject(RegistryKind kind, const void* scope, const char* name);
+
+void unregisterObject(RegistryKind kind, const void* scope, const char* name, const void* object);
+
+void freeNameRegistry();
+
+#endif
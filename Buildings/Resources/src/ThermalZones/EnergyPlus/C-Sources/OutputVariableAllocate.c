@@ -14,16 +14,13 @@
 FMUOutputVariable* checkForDoubleOutputVariableDeclaration(
   const struct FMUBuilding* bui,
   const char* fmiName){
-  size_t iComVar;
+  FMUOutputVariable* ptrOutVar = (FMUOutputVariable*)findRegisteredObject(registryOutputVariableFMIName, bui, fmiName);
 
-  for(iComVar = 0; iComVar < bui->nOutputVariables; iComVar++){
-    FMUOutputVariable* ptrOutVar = (FMUOutputVariable*)(bui->outputVariables[iComVar]);
-    if (!strcmp(fmiName, ptrOutVar->outputs->fmiNames[0])){
-      if (bui->logLevel >= MEDIUM){
-        bui->SpawnFormatMessage("---- %s: Searched for output variable %s in building and found it.\n", bui->modelicaNameBuilding, fmiName);
-      }
-      return ptrOutVar;
+  if (ptrOutVar != NULL){
+    if (bui->logLevel >= MEDIUM){
+      bui->SpawnFormatMessage("---- %s: Searched for output variable %s in building and found it.\n", bui->modelicaNameBuilding, fmiName);
     }
+    return ptrOutVar;
   }
   if (bui->logLevel >= MEDIUM){
      bui->SpawnFormatMessage("---- %s: Searched for output variable %s in building but did not find it.\n", bui->modelicaNameBuilding, fmiName);
@@ -32,21 +29,9 @@ FMUOutputVariable* checkForDoubleOutputVariableDeclaration(
 }
 
 void setOutputVariablePointerIfAlreadyInstantiated(const char* modelicaNameOutputVariable, FMUOutputVariable** ptrFMUOutputVariable){
-  size_t iBui;
-  size_t iCom;
-  FMUBuilding* ptrBui;
-  FMUOutputVariable* ptrOutVar;
-
-  for(iBui = 0; iBui < getBuildings_nFMU(); iBui++){
-    ptrBui = getBuildingsFMU(iBui);
-    for(iCom = 0; iCom < ptrBui->nOutputVariables; iCom++){
-      ptrOutVar = (FMUOutputVariable*)(ptrBui->outputVariables[iCom]);
-      if (strcmp(modelicaNameOutputVariable, ptrOutVar->modelicaNameOutputVariable) == 0){
-        *ptrFMUOutputVariable = ptrOutVar;
-        return;
-      }
-    }
-  }
+  FMUOutputVariable* ptrOutVar = (FMUOutputVariable*)findRegisteredObject(registryOutputVariable, NULL, modelicaNameOutputVariable);
+  if (ptrOutVar != NULL)
+    *ptrFMUOutputVariable = ptrOutVar;
   return;
 }
 
@@ -28,9 +28,18 @@ void EnergyPlusOutputVariableExchange(
   FMUBuilding* bui = outVar->bui;
 
   fmi2Status status;
+  double tStart;
+  double tExchange;
 
-  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
-  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+  void (*SpawnFormatMessage)(const char *string, ...);
+  void (*SpawnFormatError)(const char *string, ...);
+
+  /* Wait until the worker of the building, if any, completed its time advance,
+     before the building is accessed */
+  waitForBuildingWorker(bui);
+  SpawnFormatMessage = bui->SpawnFormatMessage;
+  SpawnFormatError = bui->SpawnFormatError;
+  tExchange = startExchangeStatistics(bui);
 
   if (bui->logLevel >= TIMESTEP)
     SpawnFormatMessage("%.3f %s: Exchanging data with EnergyPlus: initialCall = %d, mode = %s, directDependency = %2.f, valueReference = %lu.\n",
@@ -75,7 +84,9 @@ void EnergyPlusOutputVariableExchange(
     if (bui->logLevel >= MEDIUM)
       SpawnFormatMessage("%.3f %s: fmi2_import_exit_initialization_mode: Enter exit initialization mode of FMU in exchange() for output variable.\n",
         bui->time, outVar->modelicaNameOutputVariable);
+    tStart = startStatistics(bui);
     status = fmi2_import_exit_initialization_mode(bui->fmu);
+    addFMUCallStatistics(bui, statisticsExitInitializationMode, 0, tStart);
     if( status != fmi2OK ){
       SpawnFormatError("Failed to exit initialization mode for FMU for building %s and output variable %s",
         bui->modelicaNameBuilding, outVar->modelicaNameOutputVariable);
@@ -86,7 +97,8 @@ void EnergyPlusOutputVariableExchange(
 
 
   if ( (time - bui->time) > 0.001 ) {
-    /* Real time advanced */
+    /* Real time advanced. Start the time advance of the other buildings that are due at this time */
+    advanceOtherBuildings(bui, time);
     advanceTime_completeIntegratorStep_enterEventMode(bui, outVar->modelicaNameOutputVariable, time);
   }
 
@@ -115,5 +127,7 @@ void EnergyPlusOutputVariableExchange(
     bui->time, outVar->modelicaNameOutputVariable,
     *tNext, *y, fmuModeToString(bui->mode));
 
+  addExchangeStatistics(bui, statisticsOutputVariableExchange, tExchange);
+
   return;
 }
@@ -21,6 +21,8 @@ void EnergyPlusOutputVariableFree(void* object){
 
     /* The building may not have been instanciated yet if there was an error during instantiation */
     if (com->bui != NULL){
+      unregisterObject(registryOutputVariable, NULL, com->modelicaNameOutputVariable, com);
+      unregisterObject(registryOutputVariableFMIName, com->bui, com->outputs->fmiNames[0], com);
       com->bui->nOutputVariables--;
       FMUBuildingFree(com->bui);
     }
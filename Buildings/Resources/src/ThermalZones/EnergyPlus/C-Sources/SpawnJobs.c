@@ -0,0 +1,241 @@
+/*
+ * Pool of child processes that run spawn to generate the EnergyPlus FMUs.
+ *
+ * The jobs of all buildings are added before any of them is started, and
+ * buildings with the same model hash share one job. At most
+ * MODELICA_BUILDINGS_SPAWN_JOBS processes, or as many as there are processors,
+ * run at the same time. A building only waits for its own job, unless
+ * all processes of the pool are used by jobs that were started earlier.
+ *
+ * On Windows, the jobs are run one after another with system().
+ *
+ * agent                                 10/19/2026
+ */
+
+#include "SpawnJobs.h"
+
+#ifndef Buildings_SpawnJobs_c
+#define Buildings_SpawnJobs_c
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#ifndef _WIN32
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ;
+#endif
+
+#define SPAWN_N_ARGS 6
+
+static size_t Buildings_nSpawnJobs = 0;     /* Number of jobs */
+static SpawnJob** Buildings_SpawnJobs = NULL; /* Array with pointers to all jobs */
+
+static char* copyString(const char* str, void (*SpawnFormatError)(const char *string, ...)){
+  char* cpy;
+  mallocString(strlen(str)+1, "Failed to allocate memory in SpawnJobs.c.", &cpy, SpawnFormatError);
+  strcpy(cpy, str);
+  return cpy;
+}
+
+/* Return the maximum number of spawn processes that run at the same time */
+static size_t getMaxRunningJobs(){
+  const char* str = getenv(SPAWN_JOBS);
+  char* end;
+  long n;
+
+  if (str != NULL){
+    n = strtol(str, &end, 10);
+    if (end != str && n > 0)
+      return (size_t)n;
+  }
+#ifdef _WIN32
+  return 1;
+#else
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+SpawnJob* addSpawnJob(
+  FMUBuilding* bui,
+  const char* spawnExe,
+  const char* modelicaBuildingsJsonFile,
+  char* cacheKey){
+  SpawnJob* job;
+  size_t i;
+  const char* args[SPAWN_N_ARGS];
+
+  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+
+  job = (SpawnJob*)malloc(sizeof(SpawnJob));
+  if (job == NULL)
+    SpawnFormatError("Failed to allocate memory for spawn job of %s.", bui->modelicaNameBuilding);
+
+  job->bui = bui;
+  job->modelHash = copyString(bui->modelHash, SpawnFormatError);
+  job->fmuAbsPat = copyString(bui->fmuAbsPat, SpawnFormatError);
+  job->cacheKey = cacheKey;
+  job->status = jobPending;
+  job->retVal = 0;
+
+  args[0] = spawnExe;
+  args[1] = "--no-compress";
+  args[2] = "--output-path";
+  args[3] = bui->fmuAbsPat;
+  args[4] = "--create";
+  args[5] = modelicaBuildingsJsonFile;
+
+  job->argv = (char**)malloc((SPAWN_N_ARGS+1) * sizeof(char*));
+  if (job->argv == NULL)
+    SpawnFormatError("Failed to allocate memory for spawn job of %s.", bui->modelicaNameBuilding);
+  for(i = 0; i < SPAWN_N_ARGS; i++)
+    job->argv[i] = copyString(args[i], SpawnFormatError);
+  job->argv[SPAWN_N_ARGS] = NULL;
+
+  /* Add the job to the list of all jobs */
+  if (Buildings_nSpawnJobs == 0)
+    Buildings_SpawnJobs = malloc(sizeof(SpawnJob*));
+  else
+    Buildings_SpawnJobs = realloc(Buildings_SpawnJobs, (Buildings_nSpawnJobs+1) * sizeof(SpawnJob*));
+  if (Buildings_SpawnJobs == NULL)
+    SpawnFormatError("Failed to allocate memory for spawn jobs of %s.", bui->modelicaNameBuilding);
+  Buildings_SpawnJobs[Buildings_nSpawnJobs] = job;
+  Buildings_nSpawnJobs++;
+
+  return job;
+}
+
+SpawnJob* findSpawnJob(const char* modelHash){
+  size_t i;
+  for(i = 0; i < Buildings_nSpawnJobs; i++){
+    if (strcmp(Buildings_SpawnJobs[i]->modelHash, modelHash) == 0)
+      return Buildings_SpawnJobs[i];
+  }
+  return NULL;
+}
+
+static void startSpawnJob(SpawnJob* job, void (*SpawnFormatError)(const char *string, ...)){
+  FMUBuilding* bui = job->bui;
+#ifdef _WIN32
+  char* fulCmd;
+  size_t len;
+#else
+  int ret;
+#endif
+
+  if (bui->logLevel >= MEDIUM)
+    bui->SpawnFormatMessage("---- %s: Executing %s %s %s \"%s\" %s \"%s\"\n", bui->modelicaNameBuilding,
+      job->argv[0], job->argv[1], job->argv[2], job->argv[3], job->argv[4], job->argv[5]);
+
+#ifdef _WIN32
+  len = strlen(job->argv[0]) + strlen(job->argv[1]) + strlen(job->argv[2]) + strlen(job->argv[3])
+    + strlen(job->argv[4]) + strlen(job->argv[5]) + 16;
+  mallocString(len, "Failed to allocate memory in startSpawnJob().", &fulCmd, SpawnFormatError);
+  sprintf(fulCmd, "%s %s %s \"%s\" %s \"%s\"",
+    job->argv[0], job->argv[1], job->argv[2], job->argv[3], job->argv[4], job->argv[5]);
+  job->retVal = system(fulCmd);
+  job->status = jobDone;
+  free(fulCmd);
+#else
+  ret = posix_spawn(&job->pid, job->argv[0], NULL, NULL, job->argv, environ);
+  if (ret != 0)
+    SpawnFormatError("Failed to start '%s' for %s: %s.", job->argv[0], bui->modelicaNameBuilding, strerror(ret));
+  job->status = jobRunning;
+#endif
+}
+
+#ifndef _WIN32
+static void waitForProcess(SpawnJob* job, void (*SpawnFormatError)(const char *string, ...)){
+  int status;
+  pid_t ret;
+
+  do {
+    ret = waitpid(job->pid, &status, 0);
+  } while (ret == -1 && errno == EINTR);
+  if (ret == -1)
+    SpawnFormatError("Failed to wait for '%s' to generate '%s': %s.", job->argv[0], job->fmuAbsPat, strerror(errno));
+
+  job->retVal = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  job->status = jobDone;
+}
+#endif
+
+void runSpawnJobs(void (*SpawnFormatError)(const char *string, ...)){
+  size_t i;
+  size_t nRun = 0;
+  const size_t nMax = getMaxRunningJobs();
+
+  for(i = 0; i < Buildings_nSpawnJobs; i++){
+    if (Buildings_SpawnJobs[i]->status == jobRunning)
+      nRun++;
+  }
+  for(i = 0; i < Buildings_nSpawnJobs && nRun < nMax; i++){
+    if (Buildings_SpawnJobs[i]->status == jobPending){
+      startSpawnJob(Buildings_SpawnJobs[i], SpawnFormatError);
+      if (Buildings_SpawnJobs[i]->status == jobRunning)
+        nRun++;
+    }
+  }
+}
+
+void waitForSpawnJob(SpawnJob* job, void (*SpawnFormatError)(const char *string, ...)){
+#ifndef _WIN32
+  size_t i;
+  SpawnJob* runJob;
+#endif
+
+  while (job->status != jobDone){
+#ifdef _WIN32
+    startSpawnJob(job, SpawnFormatError);
+#else
+    if (job->status == jobRunning)
+      waitForProcess(job, SpawnFormatError);
+    else{
+      /* All processes of the pool are used. Wait for the job that was started first. */
+      runJob = NULL;
+      for(i = 0; i < Buildings_nSpawnJobs && runJob == NULL; i++){
+        if (Buildings_SpawnJobs[i]->status == jobRunning)
+          runJob = Buildings_SpawnJobs[i];
+      }
+      if (runJob != NULL)
+        waitForProcess(runJob, SpawnFormatError);
+    }
+    runSpawnJobs(SpawnFormatError);
+#endif
+  }
+}
+
+void freeSpawnJobs(){
+  size_t i;
+  size_t j;
+  SpawnJob* job;
+#ifndef _WIN32
+  int status;
+#endif
+
+  for(i = 0; i < Buildings_nSpawnJobs; i++){
+    job = Buildings_SpawnJobs[i];
+#ifndef _WIN32
+    /* Do not leave a zombie process if the simulation stopped during initialization */
+    if (job->status == jobRunning)
+      waitpid(job->pid, &status, 0);
+#endif
+    for(j = 0; j < SPAWN_N_ARGS; j++)
+      free(job->argv[j]);
+    free(job->argv);
+    free(job->modelHash);
+    free(job->fmuAbsPat);
+    if (job->cacheKey != NULL)
+      free(job->cacheKey);
+    free(job);
+  }
+  if (Buildings_SpawnJobs != NULL)
+    free(Buildings_SpawnJobs);
+  Buildings_SpawnJobs = NULL;
+  Buildings_nSpawnJobs = 0;
+}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Pool of child processes that run spawn to generate the EnergyPlus FMUs.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_SpawnJobs_h
+#define Buildings_SpawnJobs_h
+
+#include "EnergyPlusTypes.h"
+#include "EnergyPlusUtil.h"
+
+#include <sys/types.h>
+
+/* Environment variable with the maximum number of spawn processes that run at the same time.
+   If it is not set, the number of processors is used. */
+#define SPAWN_JOBS "MODELICA_BUILDINGS_SPAWN_JOBS"
+
+typedef enum {jobPending, jobRunning, jobDone} SpawnJobStatus;
+
+typedef struct SpawnJob
+{
+  FMUBuilding* bui;      /* Building for which the job was added */
+  char* modelHash;       /* Hash code of the model definition of the FMU */
+  char* fmuAbsPat;       /* Absolute name of the fmu that is generated */
+  char* cacheKey;        /* Key of the FMU in the FMU cache, or NULL if the cache is not used */
+  char** argv;           /* Command line arguments of spawn, terminated by NULL */
+  SpawnJobStatus status; /* Status of the job */
+  int retVal;            /* Exit code of spawn */
+#ifndef _WIN32
+  pid_t pid;             /* Process id of spawn */
+#endif
+} SpawnJob;
+
+SpawnJob* addSpawnJob(
+  FMUBuilding* bui,
+  const char* spawnExe,
+  const char* modelicaBuildingsJsonFile,
+  char* cacheKey);
+
+SpawnJob* findSpawnJob(const char* modelHash);
+
+void runSpawnJobs(void (*SpawnFormatError)(const char *string, ...));
+
+void waitForSpawnJob(SpawnJob* job, void (*SpawnFormatError)(const char *string, ...));
+
+void freeSpawnJobs();
+
+#endif
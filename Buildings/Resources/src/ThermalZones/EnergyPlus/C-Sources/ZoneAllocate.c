@@ -12,34 +12,14 @@
 #include <stdio.h>
 
 void checkForDoubleZoneDeclaration(const struct FMUBuilding* fmuBld, const char* zoneName, char** doubleSpec){
-  size_t iZ;
-  FMUZone** zones = (FMUZone**)(fmuBld->zones);
-  for(iZ = 0; iZ < fmuBld->nZon; iZ++){
-    if (!strcmp(zoneName, zones[iZ]->name)){
-      *doubleSpec = zones[iZ]->modelicaNameThermalZone;
-      break;
-    }
-  }
+  FMUZone* zone = (FMUZone*)findRegisteredObject(registryZoneName, fmuBld, zoneName);
+  if (zone != NULL)
+    *doubleSpec = zone->modelicaNameThermalZone;
   return;
 }
 
 void setZonePointerIfAlreadyInstanciated(const char* modelicaNameThermalZone, FMUZone** ptrFMUZone){
-  size_t iBui;
-  size_t iZon;
-  FMUBuilding* ptrBui;
-  FMUZone* zon;
-  *ptrFMUZone = NULL;
-
-  for(iBui = 0; iBui < getBuildings_nFMU(); iBui++){
-    ptrBui = getBuildingsFMU(iBui);
-    for(iZon = 0; iZon < ptrBui->nZon; iZon++){
-      zon = (FMUZone*)(ptrBui->zones[iZon]);
-      if (strcmp(modelicaNameThermalZone, zon->modelicaNameThermalZone) == 0){
-        *ptrFMUZone = zon;
-        return;
-      }
-    }
-  }
+  *ptrFMUZone = (FMUZone*)findRegisteredObject(registryZone, NULL, modelicaNameThermalZone);
   return;
 }
 
@@ -48,12 +48,20 @@ void EnergyPlusZoneExchange(
   FMUBuilding* bui = zone->bui;
 
   fmi2Status status;
+  double tStart;
+  double tExchange;
 
   const double dT = 0.01; /* Increment for derivative approximation */
-  double QConSenPer_flow;
 
-  void (*SpawnFormatMessage)(const char *string, ...) = bui->SpawnFormatMessage;
-  void (*SpawnFormatError)(const char *string, ...) = bui->SpawnFormatError;
+  void (*SpawnFormatMessage)(const char *string, ...);
+  void (*SpawnFormatError)(const char *string, ...);
+
+  /* Wait until the worker of the building, if any, completed its time advance,
+     before the building is accessed */
+  waitForBuildingWorker(bui);
+  SpawnFormatMessage = bui->SpawnFormatMessage;
+  SpawnFormatError = bui->SpawnFormatError;
+  tExchange = startExchangeStatistics(bui);
 
   /* Time need to be guarded against rounding error */
   /* *tNext = round((floor(time/3600.0)+1) * 3600.0); */
@@ -86,7 +94,9 @@ void EnergyPlusZoneExchange(
   if ((!initialCall) && bui->mode == initializationMode){
     if (bui->logLevel >= MEDIUM)
       SpawnFormatMessage("%.3f %s: Enter exit initialization mode of FMU in exchange().\n", bui->time, zone->modelicaNameThermalZone);
+    tStart = startStatistics(bui);
     status = fmi2_import_exit_initialization_mode(bui->fmu);
+    addFMUCallStatistics(bui, statisticsExitInitializationMode, 0, tStart);
     if( status != (fmi2Status)fmi2_status_ok ){
       SpawnFormatError("Failed to exit initialization mode for FMU for building %s and zone %s",
         bui->modelicaNameBuilding, zone->modelicaNameThermalZone);
@@ -97,7 +107,8 @@ void EnergyPlusZoneExchange(
 
 
   if ( (time - bui->time) > 0.001 ) {
-    /* Real time advanced */
+    /* Real time advanced. Start the time advance of the other buildings that are due at this time */
+    advanceOtherBuildings(bui, time);
     advanceTime_completeIntegratorStep_enterEventMode(bui, zone->modelicaNameThermalZone, time);
   }
 
@@ -110,8 +121,7 @@ void EnergyPlusZoneExchange(
   zone->inputs->valsSI[4] = QGaiRad_flow;
 
 
-  /* Forward difference for QConSen_flow */
-  zone->inputs->valsSI[0] = T + dT;
+  zone->inputs->valsSI[0] = T;
 
 /*
   SpawnFormatMessage("*** This is a test output %s", "\n");
@@ -132,14 +142,13 @@ void EnergyPlusZoneExchange(
       zone->inputs->valsSI[0],
       zone->inputs->valsSI[4]);
 
-  setVariables(bui, zone->modelicaNameThermalZone, zone->inputs);
-  getVariables(bui, zone->modelicaNameThermalZone, zone->outputs);
-  QConSenPer_flow = zone->outputs->valsSI[1];
-  zone->inputs->valsSI[0] = T;
-  setVariables(bui, zone->modelicaNameThermalZone, zone->inputs);
-  getVariables(bui, zone->modelicaNameThermalZone, zone->outputs);
+  /* The inputs are staged in the exchange cache of the building, and sent to EnergyPlus
+     together with the inputs of the other zones when outputs are requested.
+     The derivative is computed with the method set by MODELICA_BUILDINGS_SPAWN_DERIVATIVE,
+     which by default is a forward difference for this zone. */
+  *dQConSen_flow = getZoneHeatFlowDerivative(zone, dT);
+  getZoneOutputs(zone);
 
-  *dQConSen_flow = (QConSenPer_flow-zone->outputs->valsSI[1])/dT;
   /* Get next event time, unless FMU is in initialization mode */
   if (bui->mode == initializationMode){
     if (bui->logLevel >= MEDIUM)
@@ -155,7 +164,7 @@ void EnergyPlusZoneExchange(
        discrete output before the time event, and not after.
        To test, run SingleZone.mo in EnergyPlus/src
     */
-    getVariables(bui, zone->modelicaNameThermalZone, zone->outputs);
+    getZoneOutputs(zone);
   }
 
   /* Assign output values, which are of the order below
@@ -177,5 +186,7 @@ void EnergyPlusZoneExchange(
     SpawnFormatMessage("%.3f %s: Returning from EnergyPlusZoneExchange with nextEventTime = %.2f, TRad_degC = %.2f, mode = %s, nZon=%d \n",
       bui->time, zone->modelicaNameThermalZone, *tNext, zone->outputs->valsEP[0], fmuModeToString(bui->mode), bui->nZon);
 
+  addZoneExchangeStatistics(zone, tExchange);
+
   return;
 }
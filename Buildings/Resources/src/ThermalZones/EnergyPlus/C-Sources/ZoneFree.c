@@ -16,6 +16,8 @@ void EnergyPlusZoneFree(void* object){
 
     /* The building may not have been instanciated yet if there was an error during instantiation */
     if (zone->bui != NULL){
+      unregisterObject(registryZone, NULL, zone->modelicaNameThermalZone, zone);
+      unregisterObject(registryZoneName, zone->bui, zone->name, zone);
       zone->bui->nZon--;
       FMUBuildingFree(zone->bui);
     }
@@ -0,0 +1,181 @@
+/*
+ * Reader for the files of Buildings.Utilities.IO.Files.BinaryWriter.
+ *
+ * agent                                 10/19/2026
+ */
+#include "binaryReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Read size bytes. Return 0 on success and -1 if the file ends before */
+static int readData(BinaryReader* r, void* data, size_t size){
+  return (size == 0 || fread(data, size, 1, r->fp) == 1) ? 0 : -1;
+}
+
+/* Decode the n values of a column that starts at in[*k], and advance *k.
+   Return 0 on success and -1 if the data are corrupt. */
+static int decodeColumn(const unsigned char* in, size_t nIn, size_t* k, double* values, size_t n){
+  uint64_t prev = 0;
+  uint64_t x;
+  size_t i = 0;
+  int h;
+  int lead;
+  int trail;
+  int j;
+
+  while (i < n){
+    if (*k >= nIn)
+      return -1;
+    h = in[(*k)++];
+    if (h & 0x80){
+      /* Run of values that repeat the previous value */
+      if (i + (size_t)(h & 0x7F) + 1 > n)
+        return -1;
+      for (j = 0; j <= (h & 0x7F); j++)
+        memcpy(&values[i++], &prev, sizeof(prev));
+    }
+    else{
+      lead = h >> 3;
+      trail = h & 0x07;
+      if (lead + trail > 7 || *k + (size_t)(8 - lead - trail) > nIn)
+        return -1;
+      x = 0;
+      for (j = 7 - lead; j >= trail; j--)
+        x |= (uint64_t)in[(*k)++] << (8 * j);
+      prev ^= x;
+      memcpy(&values[i++], &prev, sizeof(prev));
+    }
+  }
+  return 0;
+}
+
+BinaryReader* binaryReaderOpen(const char* fileName){
+  BinaryReader* r;
+  char magic[8];
+  uint32_t byteOrder;
+  uint32_t version;
+  uint32_t type;
+  uint32_t len;
+  uint32_t i;
+
+  r = calloc(1, sizeof(BinaryReader));
+  if (r == NULL){
+    fprintf(stderr, "Not enough memory to read %s.\n", fileName);
+    return NULL;
+  }
+  r->fileName = malloc(strlen(fileName) + 1);
+  if (r->fileName == NULL){
+    fprintf(stderr, "Not enough memory to read %s.\n", fileName);
+    binaryReaderClose(r);
+    return NULL;
+  }
+  strcpy(r->fileName, fileName);
+  r->fp = fopen(fileName, "rb");
+  if (r->fp == NULL){
+    fprintf(stderr, "Failed to open %s.\n", fileName);
+    binaryReaderClose(r);
+    return NULL;
+  }
+  if (readData(r, magic, sizeof(magic)) != 0 || memcmp(magic, BINARYWRITER_MAGIC, sizeof(magic)) != 0
+    || readData(r, &byteOrder, sizeof(byteOrder)) != 0 || readData(r, &version, sizeof(version)) != 0){
+    fprintf(stderr, "%s is not a file of a binary writer.\n", fileName);
+    binaryReaderClose(r);
+    return NULL;
+  }
+  if (byteOrder != BINARYWRITER_BYTE_ORDER || version != BINARYWRITER_VERSION){
+    fprintf(stderr, "%s has version %u or was written on a computer with a different byte order.\n",
+      fileName, (unsigned int)version);
+    binaryReaderClose(r);
+    return NULL;
+  }
+  if (readData(r, &r->numColumns, sizeof(r->numColumns)) != 0
+    || readData(r, &r->chunkRows, sizeof(r->chunkRows)) != 0
+    || readData(r, &r->numRows, sizeof(r->numRows)) != 0
+    || r->numColumns == 0 || r->chunkRows == 0){
+    fprintf(stderr, "The header of %s is corrupt.\n", fileName);
+    binaryReaderClose(r);
+    return NULL;
+  }
+
+  r->columnNames = calloc(r->numColumns, sizeof(char*));
+  r->chunk = malloc((size_t)r->numColumns * r->chunkRows * sizeof(double));
+  r->encoded = malloc((size_t)r->numColumns * r->chunkRows * BINARYWRITER_MAX_ENCODED);
+  if (r->columnNames == NULL || r->chunk == NULL || r->encoded == NULL){
+    fprintf(stderr, "Not enough memory to read %s.\n", fileName);
+    binaryReaderClose(r);
+    return NULL;
+  }
+  for (i = 0; i < r->numColumns; i++){
+    if (readData(r, &type, sizeof(type)) != 0 || readData(r, &len, sizeof(len)) != 0
+      || type != BINARYWRITER_TYPE_DOUBLE
+      || (r->columnNames[i] = malloc((size_t)len + 1)) == NULL
+      || readData(r, r->columnNames[i], len) != 0){
+      fprintf(stderr, "The header of %s is corrupt.\n", fileName);
+      binaryReaderClose(r);
+      return NULL;
+    }
+    r->columnNames[i][len] = '\0';
+  }
+  return r;
+}
+
+int binaryReaderNextChunk(BinaryReader* r){
+  uint32_t n;
+  uint32_t codec;
+  uint64_t numBytes;
+  size_t k = 0;
+  uint32_t i;
+
+  r->numRowsChunk = 0;
+  if (readData(r, &n, sizeof(n)) != 0 || readData(r, &codec, sizeof(codec)) != 0
+    || readData(r, &numBytes, sizeof(numBytes)) != 0)
+    return 0;
+  if (n == 0 || n > r->chunkRows || numBytes > (uint64_t)r->numColumns * r->chunkRows * BINARYWRITER_MAX_ENCODED){
+    fprintf(stderr, "A chunk of %s is corrupt.\n", r->fileName);
+    return -1;
+  }
+  if (codec == BINARYWRITER_CODEC_NONE){
+    if (numBytes != (uint64_t)n * r->numColumns * sizeof(double)){
+      fprintf(stderr, "A chunk of %s is corrupt.\n", r->fileName);
+      return -1;
+    }
+    for (i = 0; i < r->numColumns; i++){
+      if (readData(r, r->chunk + (size_t)i * r->chunkRows, n * sizeof(double)) != 0)
+        return 0;
+    }
+  }
+  else if (codec == BINARYWRITER_CODEC_XOR){
+    if (readData(r, r->encoded, (size_t)numBytes) != 0)
+      return 0;
+    for (i = 0; i < r->numColumns; i++){
+      if (decodeColumn(r->encoded, (size_t)numBytes, &k, r->chunk + (size_t)i * r->chunkRows, n) != 0){
+        fprintf(stderr, "A chunk of %s is corrupt.\n", r->fileName);
+        return -1;
+      }
+    }
+  }
+  else{
+    fprintf(stderr, "A chunk of %s uses the unknown codec %u.\n", r->fileName, (unsigned int)codec);
+    return -1;
+  }
+  r->numRowsChunk = n;
+  return 1;
+}
+
+void binaryReaderClose(BinaryReader* r){
+  uint32_t i;
+  if (r == NULL)
+    return;
+  if (r->fp != NULL)
+    fclose(r->fp);
+  if (r->columnNames != NULL){
+    for (i = 0; i < r->numColumns; i++)
+      free(r->columnNames[i]);
+    free(r->columnNames);
+  }
+  free(r->chunk);
+  free(r->encoded);
+  free(r->fileName);
+  free(r);
+}
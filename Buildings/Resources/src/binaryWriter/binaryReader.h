@@ -0,0 +1,48 @@
+/*
+ * Reader for the files of Buildings.Utilities.IO.Files.BinaryWriter,
+ * whose layout is described in C-Sources/binaryWriterFormat.h.
+ *
+ * The file is read one chunk at a time, for example with
+ *
+ *   BinaryReader* r = binaryReaderOpen("binWri.bin");
+ *   while (binaryReaderNextChunk(r) == 1)
+ *     for (i = 0; i < r->numRowsChunk; i++)
+ *       use binaryReaderValue(r, i, iCol);
+ *   binaryReaderClose(r);
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef Buildings_binaryReader_h
+#define Buildings_binaryReader_h
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "binaryWriterFormat.h"
+
+typedef struct BinaryReader
+{
+  FILE* fp;
+  char* fileName;
+  uint32_t numColumns;      /* Number of columns, including the time */
+  uint32_t chunkRows;       /* Maximum number of rows of a chunk */
+  uint64_t numRows;         /* Number of rows, or 0 if the simulation did not terminate normally */
+  char** columnNames;       /* Names of the columns */
+  uint32_t numRowsChunk;    /* Number of rows of the current chunk */
+  double* chunk;            /* Values of the current chunk, in column-major order with chunkRows rows */
+  unsigned char* encoded;   /* Buffer for the encoded chunk */
+} BinaryReader;
+
+/* Open the file and read its header. Return NULL and print an error on failure. */
+BinaryReader* binaryReaderOpen(const char* fileName);
+
+/* Read the next chunk. Return 1 if a chunk was read, 0 at the end of the file, */
+/* and -1 on error, which is printed. A truncated last chunk is treated as the end of the file. */
+int binaryReaderNextChunk(BinaryReader* r);
+
+/* Return the value of row iRow of the current chunk in column iCol */
+#define binaryReaderValue(r, iRow, iCol) ((r)->chunk[(size_t)(iCol) * (r)->chunkRows + (iRow)])
+
+void binaryReaderClose(BinaryReader* r);
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Program that converts a file of Buildings.Utilities.IO.Files.BinaryWriter
+ * to a csv file with the same layout as Buildings.Utilities.IO.Files.CSVWriter.
+ *
+ * Usage: binaryToCsv [-d delimiter] input.bin [output.csv]
+ * If output.csv is not specified, the csv file is written to stdout.
+ *
+ * To compile, run
+ *   cc -O2 -I../../C-Sources binaryReader.c binaryToCsv.c -o binaryToCsv
+ *
+ * agent                                 10/19/2026
+ */
+#include "binaryReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char* argv[]){
+  BinaryReader* r;
+  FILE* fOut = stdout;
+  const char* delimiter = "\t";
+  const char* inName = NULL;
+  const char* outName = NULL;
+  uint64_t numRows = 0;
+  uint32_t i;
+  uint32_t j;
+  int iArg;
+  int ret;
+
+  for (iArg = 1; iArg < argc; iArg++){
+    if (strcmp(argv[iArg], "-d") == 0 && iArg + 1 < argc)
+      delimiter = argv[++iArg];
+    else if (inName == NULL)
+      inName = argv[iArg];
+    else if (outName == NULL)
+      outName = argv[iArg];
+    else{
+      inName = NULL;
+      break;
+    }
+  }
+  if (inName == NULL){
+    fprintf(stderr, "Usage: %s [-d delimiter] input.bin [output.csv]\n", argv[0]);
+    return 2;
+  }
+
+  r = binaryReaderOpen(inName);
+  if (r == NULL)
+    return 1;
+  if (outName != NULL){
+    fOut = fopen(outName, "w");
+    if (fOut == NULL){
+      fprintf(stderr, "Failed to create %s.\n", outName);
+      binaryReaderClose(r);
+      return 1;
+    }
+  }
+
+  for (j = 0; j < r->numColumns; j++)
+    fprintf(fOut, "%s%s", r->columnNames[j], (j + 1 < r->numColumns) ? delimiter : "\n");
+  while ((ret = binaryReaderNextChunk(r)) == 1){
+    for (i = 0; i < r->numRowsChunk; i++){
+      for (j = 0; j < r->numColumns; j++)
+        fprintf(fOut, "%.17g%s", binaryReaderValue(r, i, j), (j + 1 < r->numColumns) ? delimiter : "\n");
+    }
+    numRows += r->numRowsChunk;
+  }
+
+  if (ret == 0 && r->numRows != numRows)
+    fprintf(stderr, "Warning: %s has %lu rows, but its header declares %lu rows.\n"
+      "The simulation that wrote the file may not have terminated normally.\n",
+      inName, (unsigned long)numRows, (unsigned long)r->numRows);
+  binaryReaderClose(r);
+  if (fOut != stdout && fclose(fOut) == EOF){
+    fprintf(stderr, "Failed to write %s.\n", outName);
+    return 1;
+  }
+  return (ret < 0) ? 1 : 0;
+}
@@ -14,7 +14,7 @@ REM ######################################################################
 
 SET /A errno=0
 
-SET SRCS=pythonInterpreter.c
+SET SRCS=pythonInterpreter.c pythonWorker.c
 SET LIBS=pythonInterpreter.lib
 
 REM SET MOD_DLL=ModelicaBuildingsPython2.7.dll
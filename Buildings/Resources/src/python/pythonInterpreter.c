@@ -1,16 +1,24 @@
 #define _GNU_SOURCE
 #include <stdlib.h> /* for putenv */
+#include <string.h> /* for memcpy, strcmp and strchr */
+#include <stdarg.h> /* for va_list */
+#include <stdio.h> /* for vsnprintf */
 
 #include "pythonInterpreter.h"
+#include "pythonWorker.h"
 
 #if defined(_WIN32)     /* Win32 or Win64              */
 #define putenv(x) (_putenv(x))
 #endif
 
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define vsnprintf _vsnprintf
+#endif
+
 #if PY_MAJOR_VERSION >= 3
 #define PyInt_AsLong(x) (PyLong_AsLong((x)))
 #define PyString_FromString(x) (PyUnicode_FromString(x))
-#define PyString_AsString(x) (PyBytes_AsString(x))
+#define PyString_AsString(x) (PyUnicode_AsUTF8(x))
 #define PyInt_Check(x) (PySet_Check(x))
 #endif
 
@@ -52,6 +60,560 @@ static void saveAppendModelica(
 }
 
 
+#if PY_MAJOR_VERSION >= 3
+/*
+ Wraps an array of the simulator into a read-only object with the buffer protocol.
+
+ The object is a NumPy array if pFrombuffer is not NULL, and a memoryview otherwise.
+ The memoryview is returned in view. It needs to be released with releaseArray()
+ after the Python function returned, as the memory of val is only valid during the call.
+
+ Arguments:
+  val The array.
+  nRow The number of rows if val is a matrix that is stored row by row, or 0 if val is a vector.
+  n The number of elements of val, or the number of columns if val is a matrix.
+  format The struct format of the elements of val, such as "d".
+  itemSize The size of the elements of val.
+  pFrombuffer The function numpy.frombuffer, or NULL.
+  dtype The NumPy data type of the elements of val.
+  view The memoryview that wraps val.
+*/
+static PyObject* wrapArray(
+	const void* val,
+	size_t nRow,
+	size_t n,
+	char* format,
+	size_t itemSize,
+	PyObject* pFrombuffer,
+	const char* dtype,
+	PyObject** view
+) {
+	Py_buffer buf;
+	Py_ssize_t shape[2];
+	PyObject* pArr;
+	PyObject* pMat;
+
+	shape[0] = (Py_ssize_t)nRow;
+	shape[1] = (Py_ssize_t)n;
+	PyBuffer_FillInfo(&buf, NULL, (void*)val, (Py_ssize_t)((nRow > 0 ? nRow : 1) * n * itemSize), 1, PyBUF_FULL_RO);
+	buf.format = format;
+	buf.itemsize = (Py_ssize_t)itemSize;
+	buf.ndim = (nRow > 0) ? 2 : 1;
+	buf.shape = (nRow > 0) ? shape : shape + 1;
+	buf.strides = NULL;
+	/* The memoryview copies the shape, hence it does not refer to the stack after this call */
+	*view = PyMemoryView_FromBuffer(&buf);
+	if (*view == NULL || pFrombuffer == NULL) {
+		Py_XINCREF(*view);
+		return *view;
+	}
+	pArr = PyObject_CallFunction(pFrombuffer, "Os", *view, dtype);
+	if (pArr == NULL || nRow == 0)
+		return pArr;
+	/* numpy.frombuffer returns a vector */
+	pMat = PyObject_CallMethod(pArr, "reshape", "nn", shape[0], shape[1]);
+	Py_DECREF(pArr);
+	return pMat;
+}
+
+/*
+ Releases the memoryview that has been created by wrapArray().
+
+ Returns 0 on success, or -1 if the Python function kept a reference
+ to the memoryview or to another view of its memory, such as a NumPy array.
+ NumPy arrays do not export the buffer of the memoryview but create their own
+ memoryview, which is registered with the managed buffer of our memoryview.
+*/
+static int releaseArray(PyObject* view) {
+	PyObject* pRet;
+	int isReferenced;
+
+	if (view == NULL)
+		return 0;
+	isReferenced = (Py_REFCNT(view) > 1 || ((PyMemoryViewObject*)view)->mbuf->exports > 1) ? 1 : 0;
+	pRet = PyObject_CallMethod(view, "release", NULL);
+	Py_DECREF(view);
+	if (pRet == NULL) {
+		PyErr_Clear();
+		return -1;
+	}
+	Py_DECREF(pRet);
+	return isReferenced ? -1 : 0;
+}
+
+#define COPY_BUFFER(type) \
+	for (i = 0; i < nEle; ++i) { \
+		if (isInteger) \
+			((int*)val)[i] = (int)((const type*)buf)[i]; \
+		else \
+			((double*)val)[i] = (double)((const type*)buf)[i]; \
+	}
+
+/*
+ Copies the elements of an object with the buffer protocol to an array of the simulator.
+
+ Lists, which also provide the sequence protocol, are left to the caller.
+ Floating point elements are only copied to arrays of doubles.
+
+ Arguments:
+  p The object returned by Python.
+  val The array of doubles, or of integers if isInteger is 1.
+  n The number of elements of val.
+  isInteger Set to 1 if val is an array of integers, and to 0 if it is an array of doubles.
+
+ Returns the number of elements of the buffer, or -1 if p does not provide a
+ buffer with numbers. Matrices are copied row by row, and strided buffers, such as
+ slices or transposed NumPy arrays, are gathered with PyBuffer_ToContiguous().
+ The values are copied only if the number of elements is n.
+*/
+static Py_ssize_t copyFromBuffer(PyObject* p, void* val, size_t n, int isInteger) {
+	Py_buffer view;
+	Py_ssize_t i;
+	Py_ssize_t nEle;
+	const char* format;
+	const void* buf;
+	void* tmp = NULL;
+
+	if (PyList_Check(p) || !PyObject_CheckBuffer(p))
+		return -1;
+	if (PyObject_GetBuffer(p, &view, PyBUF_FULL_RO) != 0) {
+		PyErr_Clear();
+		return -1;
+	}
+	/* Skip the prefix for the native byte order. NumPy and memoryview omit it for native types. */
+	format = (view.format == NULL) ? "B" : view.format;
+	if (*format == '@')
+		format++;
+	if (format[0] == '\0' || format[1] != '\0'
+		|| strchr("dfbB?hHiIlLqQn", format[0]) == NULL
+		|| (isInteger && (format[0] == 'd' || format[0] == 'f'))) {
+		PyBuffer_Release(&view);
+		return -1;
+	}
+	nEle = view.len / view.itemsize;
+	if (nEle == (Py_ssize_t)n) {
+		buf = view.buf;
+		if ((format[0] == 'd' && !isInteger) || (format[0] == 'i' && isInteger)) {
+			/* The elements have the type of val*/
+			if (PyBuffer_ToContiguous(val, &view, view.len, 'C') != 0) {
+				PyErr_Clear();
+				nEle = -1;
+			}
+			PyBuffer_Release(&view);
+			return nEle;
+		}
+		if (!PyBuffer_IsContiguous(&view, 'C')) {
+			tmp = malloc((size_t)view.len);
+			if (tmp == NULL || PyBuffer_ToContiguous(tmp, &view, view.len, 'C') != 0) {
+				PyErr_Clear();
+				free(tmp);
+				PyBuffer_Release(&view);
+				return -1;
+			}
+			buf = tmp;
+		}
+		switch (format[0]) {
+		case 'd': COPY_BUFFER(double) break;
+		case 'f': COPY_BUFFER(float) break;
+		case 'b': COPY_BUFFER(signed char) break;
+		case 'B': COPY_BUFFER(unsigned char) break;
+		case '?': COPY_BUFFER(unsigned char) break;
+		case 'h': COPY_BUFFER(short) break;
+		case 'H': COPY_BUFFER(unsigned short) break;
+		case 'i': COPY_BUFFER(int) break;
+		case 'I': COPY_BUFFER(unsigned int) break;
+		case 'l': COPY_BUFFER(long) break;
+		case 'L': COPY_BUFFER(unsigned long) break;
+		case 'q': COPY_BUFFER(PY_LONG_LONG) break;
+		case 'Q': COPY_BUFFER(unsigned PY_LONG_LONG) break;
+		default: COPY_BUFFER(Py_ssize_t) break; /* 'n' */
+		}
+		free(tmp);
+	}
+	PyBuffer_Release(&view);
+	return nEle;
+}
+#undef COPY_BUFFER
+#endif
+
+
+/*
+ Releases the global interpreter lock and reports an error.
+
+ ModelicaFormatError does not return, hence the lock that has been
+ acquired with PyGILState_Ensure() is released before it is called.
+ If ModelicaFormatError is NULL, such as when the object is freed,
+ the error is written to stderr, and the function returns with the lock held.
+*/
+static void pythonFormatError(
+	PyGILState_STATE gstate,
+	void(*ModelicaFormatError)(const char *string, ...),
+	const char *fmt,
+	...
+) {
+	char msg[4096];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(msg, sizeof(msg), fmt, args);
+	va_end(args);
+	if (ModelicaFormatError == NULL) {
+		if (PyErr_Occurred())
+			PyErr_Print();
+		fprintf(stderr, "%s\n", msg);
+		return;
+	}
+	PyGILState_Release(gstate);
+	(*ModelicaFormatError)("%s", msg);
+}
+
+/*
+ Returns the item at position iArg of the argument tuple pArgs as a list
+ with n elements.
+
+ The list of the previous call is reused, unless the Python function
+ kept a reference to it, in which case a new list is put into the tuple.
+ Returns NULL if the list cannot be allocated.
+*/
+static PyObject* getArgumentList(PyObject* pArgs, Py_ssize_t iArg, Py_ssize_t n) {
+	PyObject* p = PyTuple_GET_ITEM(pArgs, iArg);
+	if (p == NULL || !PyList_CheckExact(p) || PyList_GET_SIZE(p) != n || Py_REFCNT(p) > 1) {
+		p = PyList_New(n);
+		if (p != NULL) {
+			/* Reference to p stolen here, and reference to the previous item released*/
+			PyTuple_SetItem(pArgs, iArg, p);
+		}
+	}
+	return p;
+}
+
+/*
+ Returns a list of nRow lists with nCol numbers each, which are the
+ values of the matrix val that is stored row by row, or NULL on failure.
+*/
+static PyObject* newMatrix(const void* val, size_t nRow, size_t nCol, int isInteger) {
+	PyObject* pMat = PyList_New((Py_ssize_t)nRow);
+	PyObject* pRow;
+	PyObject* pEle;
+	size_t iRow, iCol;
+
+	if (pMat == NULL)
+		return NULL;
+	for (iRow = 0; iRow < nRow; ++iRow) {
+		pRow = PyList_New((Py_ssize_t)nCol);
+		if (pRow == NULL) {
+			Py_DECREF(pMat);
+			return NULL;
+		}
+		/* pRow reference stolen here*/
+		PyList_SET_ITEM(pMat, iRow, pRow);
+		for (iCol = 0; iCol < nCol; ++iCol) {
+			if (isInteger)
+				pEle = PyLong_FromLong((long)((const int*)val)[iRow * nCol + iCol]);
+			else
+				pEle = PyFloat_FromDouble(((const double*)val)[iRow * nCol + iCol]);
+			if (pEle == NULL) {
+				Py_DECREF(pMat);
+				return NULL;
+			}
+			/* pEle reference stolen here*/
+			PyList_SET_ITEM(pRow, iCol, pEle);
+		}
+	}
+	return pMat;
+}
+
+/*
+ Copies the number p to element i of the array val of doubles,
+ or of integers if isInteger is 1.
+ Returns 0 on success, or -1 if p is not a number of this type.
+*/
+static int copyNumber(PyObject* p, void* val, size_t i, int isInteger) {
+	if (isInteger) {
+		const long v = PyLong_AsLong(p);
+		if (v == -1 && PyErr_Occurred()) {
+			PyErr_Clear();
+			return -1;
+		}
+		((int*)val)[i] = (int)v;
+	}
+	else {
+		const double v = PyFloat_AsDouble(p);
+		if (v == -1.0 && PyErr_Occurred()) {
+			PyErr_Clear();
+			return -1;
+		}
+		((double*)val)[i] = v;
+	}
+	return 0;
+}
+
+/*
+ Copies a matrix with nRow rows and nCol columns that has been returned by
+ Python to the array val, row by row.
+
+ The matrix may be an object with the buffer protocol, such as a NumPy array,
+ or a list of rows. Each row may be a list of numbers or an object with the buffer
+ protocol, or, if nCol is 1, a number.
+ Returns 0 on success, or -1 if p is not such a matrix.
+*/
+static int copyMatrix(PyObject* p, void* val, size_t nRow, size_t nCol, int isInteger) {
+	PyObject* pRow;
+	void* rowVal;
+	size_t iRow, iCol;
+	Py_ssize_t nBuf = -1;
+
+#if PY_MAJOR_VERSION >= 3
+	nBuf = copyFromBuffer(p, val, nRow * nCol, isInteger);
+#endif
+	if (nBuf >= 0)
+		return (nBuf == (Py_ssize_t)(nRow * nCol)) ? 0 : -1;
+	if (!PyList_Check(p) || PyList_GET_SIZE(p) != (Py_ssize_t)nRow)
+		return -1;
+	for (iRow = 0; iRow < nRow; ++iRow) {
+		pRow = PyList_GET_ITEM(p, iRow);
+		rowVal = isInteger ? (void*)((int*)val + iRow * nCol) : (void*)((double*)val + iRow * nCol);
+#if PY_MAJOR_VERSION >= 3
+		nBuf = copyFromBuffer(pRow, rowVal, nCol, isInteger);
+#endif
+		if (nBuf >= 0) {
+			if (nBuf != (Py_ssize_t)nCol)
+				return -1;
+		}
+		else if (PyList_Check(pRow)) {
+			if (PyList_GET_SIZE(pRow) != (Py_ssize_t)nCol)
+				return -1;
+			for (iCol = 0; iCol < nCol; ++iCol) {
+				if (copyNumber(PyList_GET_ITEM(pRow, iCol), rowVal, iCol, isInteger) != 0)
+					return -1;
+			}
+		}
+		else if (nCol != 1 || copyNumber(pRow, rowVal, 0, isInteger) != 0)
+			return -1;
+	}
+	return 0;
+}
+
+/*
+ Calls the Python function with the first nRow samples of the batch,
+ and stores the returned values in dblResults and intResults.
+
+ The caller must hold the global interpreter lock.
+ Returns 0 on success. On failure, ModelicaFormatError is called, or, if it is NULL,
+ the error is written to stderr and -1 is returned.
+*/
+static int callBatch(
+	pythonPtr* ptrMemory,
+	size_t nRow,
+	const char* functionName,
+	void(*ModelicaFormatError)(const char *string, ...),
+	PyGILState_STATE gstate
+) {
+	PyObject *pArgs, *pValue, *pItem, *obj;
+	PyObject *pType, *pExc, *pTraceBack;
+	PyObject* pViewDbl = NULL;
+	PyObject* pViewInt = NULL;
+	Py_ssize_t iArg = 0;
+	Py_ssize_t nArg = 0;
+	Py_ssize_t iRet = 0;
+	Py_ssize_t nRet = 0;
+	size_t i;
+
+	if (ptrMemory->nDblWri > 0)
+		nArg++;
+	if (ptrMemory->nIntWri > 0)
+		nArg++;
+	if (ptrMemory->nStrWri > 0)
+		nArg++;
+	if (ptrMemory->passPythonObject > 0)
+		nArg++;
+	pArgs = PyTuple_New(nArg);
+	if (pArgs == NULL) {
+		pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate the arguments of Python function \"%s\".", functionName);
+		return -1;
+	}
+
+	/* a) Matrix of doubles, with one row per sample*/
+	if (ptrMemory->nDblWri > 0) {
+#if PY_MAJOR_VERSION >= 3
+		if (ptrMemory->passBuffer)
+			pItem = wrapArray(ptrMemory->dblBatch, nRow, ptrMemory->nDblWri, "d", sizeof(double), ptrMemory->pFrombuffer, "float64", &pViewDbl);
+		else
+#endif
+		pItem = newMatrix(ptrMemory->dblBatch, nRow, ptrMemory->nDblWri, 0);
+		if (pItem == NULL) {
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert double arguments to Python format for function \"%s\".", functionName);
+			return -1;
+		}
+		PyTuple_SET_ITEM(pArgs, iArg, pItem);
+		iArg++;
+	}
+	/* b) Matrix of integers, with one row per sample*/
+	if (ptrMemory->nIntWri > 0) {
+#if PY_MAJOR_VERSION >= 3
+		if (ptrMemory->passBuffer)
+			pItem = wrapArray(ptrMemory->intBatch, nRow, ptrMemory->nIntWri, "i", sizeof(int), ptrMemory->pFrombuffer, "intc", &pViewInt);
+		else
+#endif
+		pItem = newMatrix(ptrMemory->intBatch, nRow, ptrMemory->nIntWri, 1);
+		if (pItem == NULL) {
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert integer arguments to Python format for function \"%s\".", functionName);
+			return -1;
+		}
+		PyTuple_SET_ITEM(pArgs, iArg, pItem);
+		iArg++;
+	}
+	/* c) Strings of the first sample, as a scalar or a list*/
+	if (ptrMemory->nStrWri > 0) {
+		if (ptrMemory->nStrWri == 1)
+			pItem = PyString_FromString(ptrMemory->strBatch[0]);
+		else {
+			pItem = PyList_New((Py_ssize_t)ptrMemory->nStrWri);
+			for (i = 0; pItem != NULL && i < ptrMemory->nStrWri; ++i) {
+				obj = PyString_FromString(ptrMemory->strBatch[i]);
+				if (obj == NULL) {
+					Py_DECREF(pItem);
+					pItem = NULL;
+				}
+				else
+					PyList_SET_ITEM(pItem, i, obj);
+			}
+		}
+		if (pItem == NULL) {
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert string arguments to Python format for function \"%s\".", functionName);
+			return -1;
+		}
+		PyTuple_SET_ITEM(pArgs, iArg, pItem);
+		iArg++;
+	}
+	/* d) Python object*/
+	if (ptrMemory->passPythonObject > 0) {
+		obj = (ptrMemory->ptr == NULL) ? Py_None : (PyObject*)ptrMemory->ptr;
+		Py_INCREF(obj);
+		PyTuple_SET_ITEM(pArgs, iArg, obj);
+		iArg++;
+	}
+
+	/* Call the Python function*/
+	pValue = PyObject_CallObject(ptrMemory->pFunc, pArgs);
+	Py_DECREF(pArgs);
+	if (pValue == NULL) {
+		PyErr_Fetch(&pType, &pExc, &pTraceBack);
+		Py_XDECREF(pType);
+		Py_XDECREF(pTraceBack);
+		pythonFormatError(gstate, ModelicaFormatError, "Call to Python function \"%s\" failed for a batch of %i samples.\n\
+The error message is %s.",
+functionName, (int)nRow,
+(pExc == NULL) ? "" : PyString_AsString(PyObject_Repr(pExc)));
+		return -1;
+	}
+	/* Parse the return values, which are a matrix of doubles, a matrix of integers and the Python object*/
+	if (ptrMemory->nDblRea > 0)
+		nRet++;
+	if (ptrMemory->nIntRea > 0)
+		nRet++;
+	if (ptrMemory->passPythonObject > 0)
+		nRet++;
+	if (nRet > 1 && !(PyList_Check(pValue) && PyList_GET_SIZE(pValue) == nRet)) {
+		pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" must return a list with %i elements.\n\
+The returned object is \"%s\"",
+functionName, (int)nRet, PyString_AsString(PyObject_Repr(pValue)));
+		return -1;
+	}
+	if (ptrMemory->nDblRea > 0) {
+		pItem = (nRet == 1) ? pValue : PyList_GET_ITEM(pValue, iRet);
+		iRet++;
+		if (copyMatrix(pItem, ptrMemory->dblResults, nRow, ptrMemory->nDblRea, 0) != 0) {
+			pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" must return a matrix of doubles with %i rows and %i columns.\n\
+The returned object is \"%s\"",
+functionName, (int)nRow, (int)ptrMemory->nDblRea, PyString_AsString(PyObject_Repr(pValue)));
+			return -1;
+		}
+	}
+	if (ptrMemory->nIntRea > 0) {
+		pItem = (nRet == 1) ? pValue : PyList_GET_ITEM(pValue, iRet);
+		iRet++;
+		if (copyMatrix(pItem, ptrMemory->intResults, nRow, ptrMemory->nIntRea, 1) != 0) {
+			pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" must return a matrix of integers with %i rows and %i columns.\n\
+The returned object is \"%s\"",
+functionName, (int)nRow, (int)ptrMemory->nIntRea, PyString_AsString(PyObject_Repr(pValue)));
+			return -1;
+		}
+	}
+	if (ptrMemory->passPythonObject > 0) {
+		obj = (nRet == 1) ? pValue : PyList_GET_ITEM(pValue, iRet);
+		Py_INCREF(obj);
+		Py_XDECREF((PyObject*)ptrMemory->ptr);
+		ptrMemory->ptr = (void*)obj;
+	}
+	Py_DECREF(pValue);
+#if PY_MAJOR_VERSION >= 3
+	/* Invalidate the arrays that share the memory of the batch.*/
+	/* This is done after the returned values have been copied and released,*/
+	/* as Python may return a view of an argument.*/
+	if (releaseArray(pViewDbl) != 0 || releaseArray(pViewInt) != 0) {
+		pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" kept a reference to an array argument after it returned.\n\
+The arrays are only valid during the call.\n\
+Copy the values if they need to be stored, or unset %s.",
+functionName, PYTHON_ARRAYS);
+		return -1;
+	}
+#endif
+	return 0;
+}
+
+/*
+ Exchanges the values of one sample with a batched Python function.
+
+ The values written are queued. The values read are those of the sample
+ nBatch samples earlier, which Python returned with the previous batch.
+ Once the batch is complete, the Python function is called.
+*/
+static void exchangeBatch(
+	pythonPtr* ptrMemory,
+	const char * functionName,
+	const double * dblValWri,
+	double * dblValRea,
+	const int * intValWri,
+	int * intValRea,
+	const char ** strValWri,
+	void(*ModelicaFormatError)(const char *string, ...)
+) {
+	const size_t iRow = ptrMemory->iBatch;
+	PyGILState_STATE gstate;
+	size_t i;
+
+	/* Modelica has no arrays with zero length. Hence, dblValRea and intValRea have size 1 if nDblRea = 0 or nIntRea = 0.*/
+	if (ptrMemory->nDblRea > 0)
+		memcpy(dblValRea, ptrMemory->dblResults + iRow * ptrMemory->nDblRea, ptrMemory->nDblRea * sizeof(double));
+	else
+		dblValRea[0] = 0;
+	if (ptrMemory->nIntRea > 0)
+		memcpy(intValRea, ptrMemory->intResults + iRow * ptrMemory->nIntRea, ptrMemory->nIntRea * sizeof(int));
+	else
+		intValRea[0] = 0;
+
+	memcpy(ptrMemory->dblBatch + iRow * ptrMemory->nDblWri, dblValWri, ptrMemory->nDblWri * sizeof(double));
+	memcpy(ptrMemory->intBatch + iRow * ptrMemory->nIntWri, intValWri, ptrMemory->nIntWri * sizeof(int));
+	if (iRow == 0) {
+		/* The strings of the first sample are passed for the whole batch*/
+		for (i = 0; i < ptrMemory->nStrWri; ++i) {
+			free(ptrMemory->strBatch[i]);
+			ptrMemory->strBatch[i] = malloc(strlen(strValWri[i]) + 1);
+			if (ptrMemory->strBatch[i] == NULL)
+				(*ModelicaFormatError)("Failed to allocate memory for the string arguments of Python function \"%s\".", functionName);
+			strcpy(ptrMemory->strBatch[i], strValWri[i]);
+		}
+	}
+	ptrMemory->iBatch++;
+
+	if (ptrMemory->iBatch == ptrMemory->nBatch) {
+		ptrMemory->iBatch = 0;
+		gstate = PyGILState_Ensure();
+		callBatch(ptrMemory, ptrMemory->nBatch, functionName, ModelicaFormatError, gstate);
+		PyGILState_Release(gstate);
+	}
+}
+
 /* Create the structure and initialize its pointer to NULL. */
 void* initPythonMemory()
 {
@@ -62,6 +624,17 @@ void* initPythonMemory()
 	ptr->pModule = NULL;
 	ptr->pFunc = NULL;
 	ptr->pythonPath = NULL;
+	ptr->passBuffer = 0;
+	ptr->pFrombuffer = NULL;
+	ptr->pArgs = NULL;
+	ptr->nBatch = 0;
+	ptr->iBatch = 0;
+	ptr->dblBatch = NULL;
+	ptr->intBatch = NULL;
+	ptr->strBatch = NULL;
+	ptr->dblResults = NULL;
+	ptr->intResults = NULL;
+	ptr->worker = NULL;
 	return (void*)ptr;
 }
 
@@ -84,7 +657,19 @@ void pythonExchangeValuesNoModelica(const char * moduleName,
 	PyObject *pItemDbl = NULL;
 	PyObject *pItemInt = NULL;
 	PyObject* obj;
+	PyObject* pViewDbl = NULL;
+	PyObject* pViewInt = NULL;
+	PyObject* pNumpy;
+	PyObject* pBatch;
+	long nBatch;
+	PyGILState_STATE gstate;
+	Py_ssize_t nBuf = -1;
+	const char* arrays;
+#if PY_MAJOR_VERSION >= 3
+	wchar_t* arg = L"";
+#else
 	char* arg = "";
+#endif
 	Py_ssize_t i;
 	Py_ssize_t iArg = 0;
 	Py_ssize_t nArg = 0;
@@ -93,6 +678,21 @@ void pythonExchangeValuesNoModelica(const char * moduleName,
 	pythonPtr* ptrMemory = (pythonPtr*)memory;
 	size_t lenPath = strlen("PYTHONPATH=");
 
+	/* Run the function in a worker process if requested, see PYTHON_WORKER*/
+	if (ptrMemory->worker != NULL || (!ptrMemory->isInitialized && usePythonWorker())) {
+		pythonWorkerExchangeValues(&(ptrMemory->worker), moduleName, functionName, pythonPath,
+			dblValWri, nDblWri, dblValRea, nDblRea,
+			intValWri, nIntWri, intValRea, nIntRea,
+			strValWri, nStrWri, ModelicaFormatError, passPythonObject);
+		return;
+	}
+
+	/* Batched calls only call Python once the batch is complete*/
+	if (ptrMemory->isInitialized && ptrMemory->nBatch > 0) {
+		exchangeBatch(ptrMemory, functionName, dblValWri, dblValRea, intValWri, intValRea, strValWri, ModelicaFormatError);
+		return;
+	}
+
 	if (ptrMemory->pythonPath == NULL) {
 		/* Construct the python path */
 		ptrMemory->pythonPath = malloc(sizeof(char) * (lenPath + 1));
@@ -110,19 +710,29 @@ void pythonExchangeValuesNoModelica(const char * moduleName,
 	}
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* Initialize Python interpreter*/
-	if (!Py_IsInitialized())
+	if (!ptrMemory->isInitialized && !Py_IsInitialized()) {
 		Py_Initialize();
-	/* Set the entries for sys.argv.*/
-	/* This is required if a script uses sys.argv, such as bacpypes.*/
-	/* See also http://stackoverflow.com/questions/19381441/python-modelica-connection-fails-due-to-import-error*/
-	PySys_SetArgv(0, &arg);
+#if PY_MAJOR_VERSION < 3 || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 7)
+		PyEval_InitThreads();
+#endif
+		/* Release the global interpreter lock, which is acquired below for each call.*/
+		/* This allows the simulator to call Python from other threads.*/
+		PyEval_SaveThread();
+	}
+
+	gstate = PyGILState_Ensure();
 
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* Load Python module*/
 	if (!ptrMemory->isInitialized) {
+		/* Set the entries for sys.argv.*/
+		/* This is required if a script uses sys.argv, such as bacpypes.*/
+		/* See also http://stackoverflow.com/questions/19381441/python-modelica-connection-fails-due-to-import-error*/
+		PySys_SetArgv(0, &arg);
+
 		pName = PyString_FromString(moduleName);
 		if (!pName) {
-			(*ModelicaFormatError)("Failed to convert moduleName '%s' to Python object.\n", moduleName);
+			pythonFormatError(gstate, ModelicaFormatError, "Failed to convert moduleName '%s' to Python object.\n", moduleName);
 		}
 
 		ptrMemory->pModule = PyImport_Import(pName);
@@ -136,7 +746,7 @@ void pythonExchangeValuesNoModelica(const char * moduleName,
 			if (pTraceBack != NULL)
 				Py_DECREF(pTraceBack);
 			/* Py_Finalize(); // removed, see note at other Py_Finalize() statement*/
-			(*ModelicaFormatError)("Failed to load \"%s\".\n\
+			pythonFormatError(gstate, ModelicaFormatError, "Failed to load \"%s\".\n\
 This may occur if you did not set the PYTHONPATH environment variable\n\
 or if the Python module contains a syntax error.\n\
 The error message is \"%s\"",
@@ -154,12 +764,75 @@ PyString_AsString(PyObject_Repr(pValue)));
 			if (PyErr_Occurred())
 				PyErr_Print();
 			/* Py_Finalize(); // removed, see note at other Py_Finalize() statement*/
-			(*ModelicaFormatError)(
+			pythonFormatError(gstate, ModelicaFormatError,
 				"Cannot find function \"%s\".\nMake sure PYTHONPATH contains the path of the module that contains this function.\n",
 				functionName);
 		}
+
+		/* Set how arrays are passed to the Python function*/
+		ptrMemory->passBuffer = 0;
+		ptrMemory->pFrombuffer = NULL;
+		arrays = getenv(PYTHON_ARRAYS);
+		if (arrays != NULL && strcmp(arrays, "list") != 0) {
+			if (strcmp(arrays, "memoryview") != 0 && strcmp(arrays, "numpy") != 0)
+				pythonFormatError(gstate, ModelicaFormatError, "Environment variable %s is set to '%s', but it must be list, memoryview or numpy.",
+					PYTHON_ARRAYS, arrays);
+#if PY_MAJOR_VERSION >= 3
+			ptrMemory->passBuffer = 1;
+			if (strcmp(arrays, "numpy") == 0) {
+				/* Use memoryviews if NumPy is not installed*/
+				pNumpy = PyImport_ImportModule("numpy");
+				if (pNumpy == NULL)
+					PyErr_Clear();
+				else {
+					ptrMemory->pFrombuffer = PyObject_GetAttrString(pNumpy, "frombuffer");
+					Py_DECREF(pNumpy);
+					if (ptrMemory->pFrombuffer == NULL)
+						PyErr_Clear();
+				}
+			}
+#endif
+		}
+
+		/* Set up batched calls if the Python function declares the number of samples per call*/
+		ptrMemory->nBatch = 0;
+		pBatch = PyObject_GetAttrString(ptrMemory->pFunc, PYTHON_BATCH_SIZE);
+		if (pBatch == NULL)
+			PyErr_Clear();
+		else {
+			nBatch = PyLong_AsLong(pBatch);
+			Py_DECREF(pBatch);
+			if (nBatch == -1 && PyErr_Occurred())
+				pythonFormatError(gstate, ModelicaFormatError, "Attribute %s of Python function \"%s\" must be an integer.",
+					PYTHON_BATCH_SIZE, functionName);
+			if (nBatch > 1) {
+				ptrMemory->nBatch = (size_t)nBatch;
+				ptrMemory->iBatch = 0;
+				ptrMemory->nDblWri = nDblWri;
+				ptrMemory->nIntWri = nIntWri;
+				ptrMemory->nStrWri = nStrWri;
+				ptrMemory->nDblRea = nDblRea;
+				ptrMemory->nIntRea = nIntRea;
+				ptrMemory->passPythonObject = passPythonObject;
+				/* The results are zero until the first batch has been computed*/
+				ptrMemory->dblBatch = malloc((nBatch * nDblWri + 1) * sizeof(double));
+				ptrMemory->intBatch = malloc((nBatch * nIntWri + 1) * sizeof(int));
+				ptrMemory->strBatch = calloc(nStrWri + 1, sizeof(char*));
+				ptrMemory->dblResults = calloc(nBatch * nDblRea + 1, sizeof(double));
+				ptrMemory->intResults = calloc(nBatch * nIntRea + 1, sizeof(int));
+				if (ptrMemory->dblBatch == NULL || ptrMemory->intBatch == NULL || ptrMemory->strBatch == NULL
+					|| ptrMemory->dblResults == NULL || ptrMemory->intResults == NULL)
+					pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate memory for batched calls of Python function \"%s\".", functionName);
+			}
+		}
 		ptrMemory->isInitialized = 1;
 	}
+
+	if (ptrMemory->nBatch > 0) {
+		PyGILState_Release(gstate);
+		exchangeBatch(ptrMemory, functionName, dblValWri, dblValRea, intValWri, intValRea, strValWri, ModelicaFormatError);
+		return;
+	}
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* The function is loaded.*/
 	/*//////////////////////////////////////////////////////////////////////////*/
@@ -172,93 +845,125 @@ PyString_AsString(PyObject_Repr(pValue)));
 		nArg++;
 	if (passPythonObject > 0)
 		nArg++;
-	if (nArg > 0)
-		pArgs = PyTuple_New(nArg);
+	/* Reuse the argument tuple of the previous call, unless the Python function*/
+	/* kept a reference to it, such as through *args.*/
+	if (nArg > 0) {
+		if (ptrMemory->pArgs == NULL || PyTuple_GET_SIZE(ptrMemory->pArgs) != nArg || Py_REFCNT(ptrMemory->pArgs) > 1) {
+			Py_XDECREF(ptrMemory->pArgs);
+			ptrMemory->pArgs = PyTuple_New(nArg);
+			if (!ptrMemory->pArgs)
+				pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate the arguments of Python function \"%s\".", functionName);
+		}
+		pArgs = ptrMemory->pArgs;
+	}
 	else
 		pArgs = NULL;
 
 	/* Convert the arguments*/
 	/* a) Convert double[]*/
-	if (nDblWri > 0) {
-		pArgsDbl = PyList_New(nDblWri);
+#if PY_MAJOR_VERSION >= 3
+	if (nDblWri > 1 && ptrMemory->passBuffer) {
+		/* Pass the values without copying them*/
+		pArgsDbl = wrapArray(dblValWri, 0, nDblWri, "d", sizeof(double), ptrMemory->pFrombuffer, "float64", &pViewDbl);
+		if (!pArgsDbl)
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert double arguments to a Python buffer for function \"%s\".", functionName);
+		PyTuple_SetItem(pArgs, iArg, pArgsDbl);
+		iArg++;
+	}
+	else
+#endif
+	if (nDblWri == 1) {
+		/* If there is only a scalar double, then don't build a list.*/
+		/* Just put the scalar value into the list of arguments*/
+		pValue = PyFloat_FromDouble(dblValWri[0]);
+		if (!pValue)
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert double argument number %i to Python format.", 0);
+		PyTuple_SetItem(pArgs, iArg, pValue);
+		iArg++;
+	}
+	else if (nDblWri > 0) {
+		pArgsDbl = getArgumentList(pArgs, iArg, (Py_ssize_t)nDblWri);
+		if (!pArgsDbl)
+			pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate the double arguments of Python function \"%s\".", functionName);
 		for (i = 0; i < nDblWri; ++i) {
 			/* Convert argument to a python float*/
 			pValue = PyFloat_FromDouble(dblValWri[i]);
 			if (!pValue) {
 				/* Failed to convert argument.*/
-				Py_DECREF(pArgsDbl);
-				Py_DECREF(ptrMemory->pModule);
 				/* According to the Modelica specification,*/
 				/* the function ModelicaError never returns to the calling function.*/
-				(*ModelicaFormatError)("Cannot convert double argument number %i to Python format.", i);
+				pythonFormatError(gstate, ModelicaFormatError, "Cannot convert double argument number %i to Python format.", (int)i);
 			}
-			/* pValue reference stolen here*/
+			/* pValue reference stolen here, and reference to the value of the previous call released*/
 			PyList_SetItem(pArgsDbl, i, pValue);
 		}
-		/* If there is only a scalar double, then don't build a list.*/
-		/* Just put the scalar value into the list of arguments*/
-		if (nDblWri == 1)
-			PyTuple_SetItem(pArgs, iArg, PyList_GetItem(pArgsDbl, (Py_ssize_t)0));
-		else
-			PyTuple_SetItem(pArgs, iArg, pArgsDbl);
 		iArg++;
 	}
 	/* b) Convert int[]*/
-	if (nIntWri > 0) {
-		pArgsInt = PyList_New(nIntWri);
+#if PY_MAJOR_VERSION >= 3
+	if (nIntWri > 1 && ptrMemory->passBuffer) {
+		/* Pass the values without copying them*/
+		pArgsInt = wrapArray(intValWri, 0, nIntWri, "i", sizeof(int), ptrMemory->pFrombuffer, "intc", &pViewInt);
+		if (!pArgsInt)
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert integer arguments to a Python buffer for function \"%s\".", functionName);
+		PyTuple_SetItem(pArgs, iArg, pArgsInt);
+		iArg++;
+	}
+	else
+#endif
+	if (nIntWri == 1) {
+		/* If there is only a scalar integer, then don't build a list.*/
+		/* Just put the scalar value into the list of arguments*/
+		pValue = PyLong_FromLong((long)intValWri[0]);
+		if (!pValue)
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert integer argument number %i to Python format.", 0);
+		PyTuple_SetItem(pArgs, iArg, pValue);
+		iArg++;
+	}
+	else if (nIntWri > 0) {
+		pArgsInt = getArgumentList(pArgs, iArg, (Py_ssize_t)nIntWri);
+		if (!pArgsInt)
+			pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate the integer arguments of Python function \"%s\".", functionName);
 		for (i = 0; i < nIntWri; ++i) {
 			/* Convert argument to a python integer*/
 			pValue = PyLong_FromLong((long)intValWri[i]);
 			if (!pValue) {
 				/* Failed to convert argument.*/
-				Py_DECREF(pArgsInt);
-				Py_DECREF(ptrMemory->pModule);
 				/* According to the Modelica specification,*/
 				/* the function ModelicaError never returns to the calling function.*/
-				(*ModelicaFormatError)("Cannot convert integer argument number %i to Python format.", i);
+				pythonFormatError(gstate, ModelicaFormatError, "Cannot convert integer argument number %i to Python format.", (int)i);
 			}
-			/* pValue reference stolen here*/
+			/* pValue reference stolen here, and reference to the value of the previous call released*/
 			PyList_SetItem(pArgsInt, i, pValue);
 		}
-		/* If there is only a scalar integer, then don't build a list.*/
-		/* Just put the scalar value into the list of arguments*/
-		if (nIntWri == 1)
-			PyTuple_SetItem(pArgs, iArg, PyList_GetItem(pArgsInt, (Py_ssize_t)0));
-		else
-			PyTuple_SetItem(pArgs, iArg, pArgsInt);
 		iArg++;
 	}
 	/* c) Convert char **, an array of character arrays*/
-	if (nStrWri > 0) {
-		pArgsStr = PyList_New(nStrWri);
-
+	/* According to the Modelica Specification, strings are terminated by '\0'*/
+	if (nStrWri == 1) {
+		/* If there is only a scalar string, then don't build a list.*/
+		/* Just put the scalar value into the list of arguments.*/
+		pValue = PyString_FromString(strValWri[0]);
+		if (!pValue)
+			pythonFormatError(gstate, ModelicaFormatError, "Cannot convert string argument number %i to Python format.", 0);
+		PyTuple_SetItem(pArgs, iArg, pValue);
+		iArg++;
+	}
+	else if (nStrWri > 0) {
+		pArgsStr = getArgumentList(pArgs, iArg, (Py_ssize_t)nStrWri);
+		if (!pArgsStr)
+			pythonFormatError(gstate, ModelicaFormatError, "Failed to allocate the string arguments of Python function \"%s\".", functionName);
 		for (i = 0; i < nStrWri; ++i) {
-			/* Convert argument to a python float*/
-			/*      Py_ssize_t len = 0;*/
-			/* According to the Modelica Specification, strings are terminated by '\0'*/
-			/* Seek the string length*/
-			/*      while (strValWri[i][len] != '\0')*/
-			/*	len++;*/
-
-			/*      pValue = PyString_FromStringAndSize(strValWri[i], len);*/
 			pValue = PyString_FromString(strValWri[i]);
 			if (!pValue) {
 				/* Failed to convert argument.*/
-				Py_DECREF(pArgsStr);
-				Py_DECREF(ptrMemory->pModule);
 				/* According to the Modelica specification,*/
 				/* the function ModelicaError never returns to the calling function.*/
-				(*ModelicaFormatError)("Cannot convert string argument number %i to Python format.", i);
+				pythonFormatError(gstate, ModelicaFormatError, "Cannot convert string argument number %i to Python format.", (int)i);
 			}
-			/* pValue reference stolen here*/
+			/* pValue reference stolen here, and reference to the value of the previous call released*/
 			PyList_SetItem(pArgsStr, i, pValue);
 		}
-		/* If there is only a scalar string, then don't build a list.*/
-		/* Just put the scalar value into the list of arguments.*/
-		if (nStrWri == 1)
-			PyTuple_SetItem(pArgs, iArg, PyList_GetItem(pArgsStr, (Py_ssize_t)0));
-		else
-			PyTuple_SetItem(pArgs, iArg, pArgsStr);
 		iArg++;
 	}
 
@@ -266,8 +971,9 @@ PyString_AsString(PyObject_Repr(pValue)));
 	if (passPythonObject > 0) {
 		/* Put the memory into the argument list.*/
 		/* In the first call, put Py_None int obj, but in subsequent calls, use ptr. */
-		obj = (ptrMemory->ptr == NULL) ? Py_None : ptrMemory->ptr;
-
+		obj = (ptrMemory->ptr == NULL) ? Py_None : (PyObject*)ptrMemory->ptr;
+		/* The tuple owns a reference to obj, as does ptrMemory->ptr */
+		Py_INCREF(obj);
 		PyTuple_SetItem(pArgs, iArg, obj);
 		iArg++;
 	}
@@ -276,8 +982,6 @@ PyString_AsString(PyObject_Repr(pValue)));
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* Call the Python function*/
 	pValue = PyObject_CallObject(ptrMemory->pFunc, pArgs);
-	if (pArgs != NULL)
-		Py_DECREF(pArgs);
 
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* Check whether the call to the Python function failed.*/
@@ -289,9 +993,7 @@ PyString_AsString(PyObject_Repr(pValue)));
 			Py_DECREF(pType);
 		if (pTraceBack != NULL)
 			Py_DECREF(pTraceBack);
-		Py_DECREF(ptrMemory->pFunc);
-		Py_DECREF(ptrMemory->pModule);
-		(*ModelicaFormatError)("Call to Python function \"%s\" failed.\n \
+		pythonFormatError(gstate, ModelicaFormatError, "Call to Python function \"%s\" failed.\n \
 This is often due to an error in the Python script,\n \
 or because the list of arguments of the Python function is incorrect.\n \
 Check the module \"%s\".\n \
@@ -318,7 +1020,7 @@ PyString_AsString(PyObject_Repr(pValue)));
 		if (nRet > 1) {
 			/* Check whether it is a list*/
 			if (!PyList_Check(pValue)) {
-				(*ModelicaFormatError)("Python function \"%s\" does not return a list.\n\
+				pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" does not return a list.\n\
 The returned object is \"%s\"",
 functionName, PyString_AsString(PyObject_Repr(pValue)));
 			}
@@ -329,11 +1031,11 @@ functionName, PyString_AsString(PyObject_Repr(pValue)));
 		/* Hence, we only check for nRet==2.*/
 		if (nRet == 2) {
 			if (nRet != PyList_Size(pValue)) {
-				(*ModelicaFormatError)("Python function \"%s\", returns a list with %i elements,\n \
+				pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\", returns a list with %i elements,\n \
 but expected two elements.\n\
 The returned object is \"%s\"",
 functionName,
-PyList_Size(pValue),
+(int)PyList_Size(pValue),
 PyString_AsString(PyObject_Repr(pValue)));
 			}
 		}
@@ -348,12 +1050,20 @@ PyString_AsString(PyObject_Repr(pValue)));
 				pItemDbl = PyList_GetItem(pValue, iRet);
 				iRet++;
 			}
+#if PY_MAJOR_VERSION >= 3
+			/* Copy objects with the buffer protocol, such as NumPy arrays, in bulk*/
+			nBuf = (nDblRea > 1) ? copyFromBuffer(pItemDbl, dblValRea, nDblRea, 0) : -1;
+#endif
+			if (nBuf >= 0 && nBuf != (Py_ssize_t)nDblRea)
+				pythonFormatError(gstate, ModelicaFormatError, "For Python function \"%s\", Modelica declares that Python returns %i doubles,\
+ but Python returned %i values.",
+functionName, (int)nDblRea, (int)nBuf);
 			/* Check the number of return arguments*/
-			if (nDblRea > 1 && nDblRea != PyList_Size(pItemDbl))
-				(*ModelicaFormatError)("For Python function \"%s\", Modelica declares that Python returns %i doubles,\
+			if (nDblRea > 1 && nBuf < 0 && nDblRea != PyList_Size(pItemDbl))
+				pythonFormatError(gstate, ModelicaFormatError, "For Python function \"%s\", Modelica declares that Python returns %i doubles,\
  but Python returned %i values.\n\
 The returned object is \"%s\"",
-functionName, nDblRea, PyList_Size(pItemDbl),
+functionName, (int)nDblRea, (int)PyList_Size(pItemDbl),
 PyString_AsString(PyObject_Repr(pValue)));
 
 			/* The number of arguments is correct. Retrieve them and parse them.*/
@@ -364,12 +1074,12 @@ PyString_AsString(PyObject_Repr(pValue)));
 				if (PyFloat_Check(pItemDbl) || PyLong_Check(pItemDbl) || PyInt_Check(pItemDbl))
 					dblValRea[0] = PyFloat_AsDouble(pItemDbl);
 				else
-					(*ModelicaFormatError)("Python function \"%s\" returns an invalid object for a scalar double value.\n\
+					pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" returns an invalid object for a scalar double value.\n\
 There should only be one double value returned.\n\
 The returned object is \"%s\".",
 functionName, PyString_AsString(PyObject_Repr(pValue)));
 			}
-			else { /* We have nDblRea > 1, iterate through the list*/
+			else if (nBuf < 0) { /* We have nDblRea > 1 and a list, iterate through the list*/
 				for (pIndVal = 0; pIndVal < PyList_Size(pItemDbl); ++pIndVal) {
 					PyObject *p = PyList_GetItem(pItemDbl, pIndVal);
 					/* Check whether it is a float or an integer.*/
@@ -377,7 +1087,7 @@ functionName, PyString_AsString(PyObject_Repr(pValue)));
 					if (PyFloat_Check(p) || PyLong_Check(p) || PyInt_Check(p))
 						dblValRea[pIndVal] = PyFloat_AsDouble(p);
 					else
-						(*ModelicaFormatError)("Python function \"%s\" returns an invalid object for a scalar double value.\n\
+						pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" returns an invalid object for a scalar double value.\n\
 The returned object is \"%s\".",
 functionName, PyString_AsString(PyObject_Repr(pValue)));
 				} /* for(...)*/
@@ -400,12 +1110,20 @@ functionName, PyString_AsString(PyObject_Repr(pValue)));
 				pItemInt = PyList_GetItem(pValue, iRet);
 				iRet++;
 			}
+#if PY_MAJOR_VERSION >= 3
+			/* Copy objects with the buffer protocol, such as NumPy arrays, in bulk*/
+			nBuf = (nIntRea > 1) ? copyFromBuffer(pItemInt, intValRea, nIntRea, 1) : -1;
+#endif
+			if (nBuf >= 0 && nBuf != (Py_ssize_t)nIntRea)
+				pythonFormatError(gstate, ModelicaFormatError, "For Python function \"%s\", Modelica declares that Python returns %i integers,\
+ but Python returned %i values.",
+functionName, (int)nIntRea, (int)nBuf);
 			/* Check the number of return arguments*/
-			if (nIntRea > 1 && nIntRea != PyList_Size(pItemInt))
-				(*ModelicaFormatError)("For Python function \"%s\", Modelica declares that Python returns %i integers,\
+			if (nIntRea > 1 && nBuf < 0 && nIntRea != PyList_Size(pItemInt))
+				pythonFormatError(gstate, ModelicaFormatError, "For Python function \"%s\", Modelica declares that Python returns %i integers,\
  but Python returned %i values.\n\
 The returned object is \"%s\"",
-functionName, nIntRea, PyList_Size(pItemInt),
+functionName, (int)nIntRea, (int)PyList_Size(pItemInt),
 PyString_AsString(PyObject_Repr(pValue)));
 
 			/* The number of arguments is correct. Retrieve them and parse them.*/
@@ -413,16 +1131,16 @@ PyString_AsString(PyObject_Repr(pValue)));
 			if (nIntRea == 1) {
 				/* Check whether it is an integer.*/
 				if (!(PyLong_Check(pItemInt) || PyInt_Check(pItemDbl)))
-					(*ModelicaFormatError)("Python function \"%s\" returns an invalid object for a scalar integer value.\n\
+					pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" returns an invalid object for a scalar integer value.\n\
 The returned object is \"%s\".",
 functionName, PyString_AsString(PyObject_Repr(pValue)));
 				intValRea[0] = PyInt_AsLong(pItemInt);
 			}
-			else { /* We have nIntRea > 1, iterate through the list*/
+			else if (nBuf < 0) { /* We have nIntRea > 1 and a list, iterate through the list*/
 				for (pIndVal = 0; pIndVal < PyList_Size(pItemInt); ++pIndVal) {
 					PyObject *p = PyList_GetItem(pItemInt, pIndVal);
 					if (!PyLong_Check(p))
-						(*ModelicaFormatError)("Python function \"%s\" returns an invalid object for a scalar integer value.\n\
+						pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" returns an invalid object for a scalar integer value.\n\
 The returned object is \"%s\".",
 functionName, PyString_AsString(PyObject_Repr(pValue)));
 					intValRea[pIndVal] = PyInt_AsLong(p);
@@ -438,16 +1156,43 @@ functionName, PyString_AsString(PyObject_Repr(pValue)));
 		/*//////////////////////////////////////////////////////////////////////////*/
 		/* Parse the memory to the Python object*/
 		if (passPythonObject > 0) {
-			ptrMemory->ptr = (void*)PyList_GetItem(pValue, iRet);
+			/* Keep a reference to the new object, as pValue is released below,*/
+			/* and release the reference to the object of the previous call*/
+			obj = PyList_GetItem(pValue, iRet);
+			Py_XINCREF(obj);
+			Py_XDECREF((PyObject*)ptrMemory->ptr);
+			ptrMemory->ptr = (void*)obj;
 			iRet++;
 		}
 	}
 	/*//////////////////////////////////////////////////////////////////////////*/
 	/* Decrement the reference counters*/
-	/* causes sometimes a segmentation fault    Py_DECREF(pValue);*/
-	/* causes sometimes a segmentation fault    Py_DECREF(pFunc);*/
-	/* causes sometimes a segmentation fault    Py_DECREF(pModule);*/
-	/* causes sometimes a segmentation fault    Py_DECREF(pModule);*/
+	/* The module, the function and the argument tuple are kept until freePythonMemory() is called.*/
+	Py_DECREF(pValue);
+#if PY_MAJOR_VERSION >= 3
+	/* Drop the references of the argument tuple to the arrays that share the memory*/
+	/* of the simulator, unless Python kept the tuple, and invalidate these arrays.*/
+	/* This is done after the returned values have been copied and released,*/
+	/* as Python may return a view of an argument.*/
+	if (pViewDbl != NULL || pViewInt != NULL) {
+		if (Py_REFCNT(pArgs) == 1) {
+			if (pViewDbl != NULL) {
+				Py_INCREF(Py_None);
+				PyTuple_SetItem(pArgs, 0, Py_None);
+			}
+			if (pViewInt != NULL) {
+				Py_INCREF(Py_None);
+				PyTuple_SetItem(pArgs, (nDblWri > 0) ? 1 : 0, Py_None);
+			}
+		}
+		if (releaseArray(pViewDbl) != 0 || releaseArray(pViewInt) != 0)
+			pythonFormatError(gstate, ModelicaFormatError, "Python function \"%s\" kept a reference to an array argument after it returned.\n\
+The arrays share the memory of the simulator and are only valid during the call.\n\
+Copy the values if they need to be stored, or unset %s.",
+functionName, PYTHON_ARRAYS);
+	}
+#endif
+	PyGILState_Release(gstate);
 	/* Undo all initializations*/
 	/* We uncommented Py_Finalize() because it caused a segmentation fault on Ubuntu 12.04 32 bit.*/
 	/* The segmentation fault was randomly produced by the statement, and often observed when running*/
@@ -486,6 +1231,34 @@ void freePythonMemory(void* object)
 {
 	if (object != NULL) {
 		pythonPtr* p = (pythonPtr*)object;
+		size_t i;
+		if (p->worker != NULL)
+			freePythonWorker(p->worker);
+		if (Py_IsInitialized()) {
+			PyGILState_STATE gstate = PyGILState_Ensure();
+			/* Send the samples that remain queued to Python, whose results are not used*/
+			if (p->nBatch > 0 && p->iBatch > 0) {
+				PyObject* pName = PyObject_Repr(p->pFunc);
+				callBatch(p, p->iBatch, (pName == NULL) ? "" : PyString_AsString(pName), NULL, gstate);
+				Py_XDECREF(pName);
+				p->iBatch = 0;
+			}
+			Py_XDECREF((PyObject*)p->ptr);
+			Py_XDECREF(p->pArgs);
+			Py_XDECREF(p->pFrombuffer);
+			Py_XDECREF(p->pFunc);
+			Py_XDECREF(p->pModule);
+			PyGILState_Release(gstate);
+		}
+		if (p->strBatch != NULL) {
+			for (i = 0; i < p->nStrWri; ++i)
+				free(p->strBatch[i]);
+		}
+		free(p->strBatch);
+		free(p->dblBatch);
+		free(p->intBatch);
+		free(p->dblResults);
+		free(p->intResults);
 		free(p->pythonPath);
 		free(p);
 	}
@@ -40,6 +40,25 @@
 
 #include "pythonObjectStructure.h"
 
+/* Environment variable that sets how arrays of doubles and integers are passed to Python.*/
+/* If not set or set to list, they are passed as lists of Python numbers.*/
+/* If set to memoryview or numpy, they are passed as read-only memoryviews or, if NumPy*/
+/* can be imported, as read-only NumPy arrays that share the memory of the simulator.*/
+/* These arrays are only valid during the call and must be copied if they are stored.*/
+/* Regardless of this setting, the Python function may return arrays as lists or as*/
+/* objects with the buffer protocol, such as NumPy arrays, which are then copied in bulk.*/
+#define PYTHON_ARRAYS "MODELICA_BUILDINGS_PYTHON_ARRAYS"
+
+/* Attribute of the Python function that declares the number of samples K per call.*/
+/* If it is set to K > 1, the values written by K consecutive calls are queued,*/
+/* and the Python function is called once with a K x n matrix for each data type.*/
+/* It must return a K x m matrix for each data type, whose rows are returned by the*/
+/* next K calls. Hence, the values read lag the values written by K samples, and*/
+/* are zero for the first K samples. Use it only for functions whose outputs are*/
+/* not fed back to their inputs within K samples, such as for logging or estimation.*/
+/* Samples that remain queued are sent to Python when the object is freed.*/
+#define PYTHON_BATCH_SIZE "modelica_batch_size"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +27,24 @@ typedef struct pythonPtr
   PyObject* pModule;
   PyObject* pFunc;
   char* pythonPath;
+  int passBuffer;        /* Flag, 1 if arrays are passed to Python as buffers rather than lists */
+  PyObject* pFrombuffer; /* Function numpy.frombuffer, or NULL if arrays are passed as memoryviews */
+  PyObject* pArgs;       /* Tuple with the arguments, reused between the calls */
+  /* Batched calls, see PYTHON_BATCH_SIZE */
+  size_t nBatch;         /* Number of samples per call of the Python function, or 0 if the calls are not batched */
+  size_t iBatch;         /* Number of samples in the current batch */
+  size_t nDblWri;        /* Number of doubles written per sample */
+  size_t nIntWri;        /* Number of integers written per sample */
+  size_t nStrWri;        /* Number of strings written per batch */
+  size_t nDblRea;        /* Number of doubles read per sample */
+  size_t nIntRea;        /* Number of integers read per sample */
+  int passPythonObject;  /* Flag, 1 if the Python object is passed */
+  double* dblBatch;      /* Doubles written of the current batch, with nBatch rows and nDblWri columns */
+  int* intBatch;         /* Integers written of the current batch, with nBatch rows and nIntWri columns */
+  char** strBatch;       /* Strings of the first sample of the current batch */
+  double* dblResults;    /* Doubles read in the previous batch, with nBatch rows and nDblRea columns */
+  int* intResults;       /* Integers read in the previous batch, with nBatch rows and nIntRea columns */
+  void* worker;          /* Worker process that runs the function, or NULL, see PYTHON_WORKER */
 } pythonPtr;
 
 #endif
@@ -0,0 +1,702 @@
+/*
+ * Functions that call a Python function in a worker process.
+ *
+ * The worker is the executable PYTHON_WORKER_EXECUTABLE, which is installed
+ * in the directory of this library and started with posix_spawn(), and which
+ * runs the embedded interpreter of pythonInterpreter.c in its own process.
+ * The simulator is not forked, as a fork of a multithreaded simulator
+ * only copies the calling thread, and locks held by other threads,
+ * such as those of malloc or of the Python interpreter, would never be released.
+ * A crash of a Python extension only terminates the worker,
+ * which is restarted, and the global interpreter locks of different
+ * workers are independent.
+ *
+ * The shared memory is passed to the worker as the file descriptor
+ * PYTHON_WORKER_SHARED_FD, and the read end of a pipe, whose write end
+ * is closed if the simulator terminates, as PYTHON_WORKER_PIPE_FD.
+ * All other file descriptors that the simulator opens for the workers
+ * have FD_CLOEXEC set, so that they are not inherited by other workers
+ * or by other processes that the simulator starts.
+ *
+ * agent                                 10/19/2026
+ */
+#define _GNU_SOURCE
+#include "pythonWorker.h"
+#include "pythonInterpreter.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#if defined(_WIN32)
+
+int usePythonWorker(){
+	return 0;
+}
+
+int runPythonWorker(int argc, char* argv[]){
+	fprintf(stderr, "Python worker processes are not supported on Windows.\n");
+	return 1;
+}
+
+void pythonWorkerExchangeValues(void** worker,
+	const char * moduleName,
+	const char * functionName,
+	const char * pythonPath,
+	const double * dblValWri, size_t nDblWri,
+	double * dblValRea, size_t nDblRea,
+	const int * intValWri, size_t nIntWri,
+	int * intValRea, size_t nIntRea,
+	const char ** strValWri, size_t nStrWri,
+	void(*ModelicaFormatError)(const char *string, ...),
+	int passPythonObject)
+{
+	(*ModelicaFormatError)("Python worker processes are not supported on Windows. Unset %s.", PYTHON_WORKER);
+}
+
+void freePythonWorker(void* worker){
+}
+
+#else
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+/* Shared libraries on macOS cannot access environ directly */
+#include <crt_externs.h>
+#define workerEnviron (*_NSGetEnviron())
+#else
+extern char** environ;
+#define workerEnviron environ
+#endif
+
+/* File descriptors of the shared memory and of the read end of the pipe in the worker */
+#define PYTHON_WORKER_SHARED_FD 3
+#define PYTHON_WORKER_PIPE_FD 4
+
+/* Commands of a slot */
+enum pythonWorkerCommand {workerCall, workerStop};
+
+/* Status of a slot whose call has not yet been answered by the worker */
+#define PYTHON_WORKER_PENDING -1
+
+/* Header of a slot of the ring, which is followed by the doubles, the integers and the strings */
+typedef struct pythonWorkerSlot {
+	int command;                          /* Command, see pythonWorkerCommand */
+	int status;                           /* 0 if the call succeeded, 1 if Python reported an error, and PYTHON_WORKER_PENDING before the response */
+	char message[PYTHON_WORKER_MESSAGE];  /* Error message if status is 1 */
+} pythonWorkerSlot;
+
+typedef struct pythonWorker {
+	char* moduleName;
+	char* functionName;
+	char* pythonPath;
+	size_t nDblWri;
+	size_t nIntWri;
+	size_t nStrWri;
+	size_t nDblRea;
+	size_t nIntRea;
+	int passPythonObject;
+
+	size_t lenStr;           /* Number of characters available for the strings of a slot, including the '\0' */
+	size_t slotSize;         /* Size of a slot in bytes */
+	char* shared;            /* Shared memory with PYTHON_WORKER_SLOTS slots */
+	size_t sharedSize;       /* Size of the shared memory in bytes */
+	size_t iPost;            /* Slot to which the next call is written */
+	size_t nPending;         /* Number of calls whose response has not yet been read */
+
+	sem_t* semRequest;       /* Posted by the simulator for each call */
+	sem_t* semResponse;      /* Posted by the worker for each response, and by the watcher if the worker terminated */
+	char semName[2][32];     /* Names of semRequest and semResponse, which are removed once the worker opened them */
+	pid_t pid;               /* Process id of the worker */
+	int pipeFd;              /* Write end of a pipe that is closed if the simulator terminates */
+	pthread_t watcher;       /* Thread that waits for the termination of the worker */
+	int terminated;          /* Flag, set to 1 by the watcher when the worker terminated, guarded by workerMutex */
+	int exitStatus;          /* Status of the worker, as returned by waitpid */
+} pythonWorker;
+
+/* Sequence number that makes the names of the semaphores and of the shared memory unique */
+static unsigned long nWorkers = 0;
+static pthread_mutex_t workerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Variable whose address is used to find the directory of this library */
+static int workerAnchor = 0;
+
+/* Error handling of the worker process, which reports the error to the simulator */
+static jmp_buf workerJmp;
+static char* workerMessage = NULL;
+static int isWorkerProcess = 0;
+
+int usePythonWorker(){
+	const char* env;
+	if (isWorkerProcess)
+		return 0;
+	env = getenv(PYTHON_WORKER);
+	return (env != NULL && strcmp(env, "1") == 0) ? 1 : 0;
+}
+
+static pythonWorkerSlot* getSlot(const pythonWorker* w, size_t i){
+	return (pythonWorkerSlot*)(w->shared + i * w->slotSize);
+}
+
+/* Return the doubles of slot, which are the nDblWri values written followed by the values read */
+static double* getDoubles(pythonWorkerSlot* slot){
+	return (double*)((char*)slot + sizeof(pythonWorkerSlot));
+}
+
+static int* getIntegers(const pythonWorker* w, pythonWorkerSlot* slot){
+	/* Modelica has no arrays with zero length, hence at least one value is read */
+	return (int*)(getDoubles(slot) + w->nDblWri + (w->nDblRea > 0 ? w->nDblRea : 1));
+}
+
+static char* getStrings(const pythonWorker* w, pythonWorkerSlot* slot){
+	return (char*)(getIntegers(w, slot) + w->nIntWri + (w->nIntRea > 0 ? w->nIntRea : 1));
+}
+
+static void semWait(sem_t* sem){
+	while (sem_wait(sem) != 0 && errno == EINTR){
+	}
+}
+
+static char* copyString(const char* str){
+	char* s = (str == NULL) ? NULL : malloc(strlen(str) + 1);
+	if (s != NULL)
+		strcpy(s, str);
+	return s;
+}
+
+/* Error function of the worker process, which returns to the loop in runWorker */
+static void workerFormatError(const char *string, ...){
+	va_list args;
+	va_start(args, string);
+	vsnprintf(workerMessage, PYTHON_WORKER_MESSAGE, string, args);
+	va_end(args);
+	longjmp(workerJmp, 1);
+}
+
+/* Thread of the worker process that terminates it if the simulator terminated */
+static void* watchSimulator(void* arg){
+	char c;
+	while (read(PYTHON_WORKER_PIPE_FD, &c, 1) != 0 && errno == EINTR){
+	}
+	_exit(1);
+	return NULL;
+}
+
+/* Thread of the simulator that waits until the worker process terminated */
+static void* watchWorker(void* arg){
+	pythonWorker* w = (pythonWorker*)arg;
+	while (waitpid(w->pid, &(w->exitStatus), 0) < 0 && errno == EINTR){
+	}
+	pthread_mutex_lock(&workerMutex);
+	w->terminated = 1;
+	pthread_mutex_unlock(&workerMutex);
+	sem_post(w->semResponse);
+	return NULL;
+}
+
+static int isTerminated(pythonWorker* w){
+	int terminated;
+	pthread_mutex_lock(&workerMutex);
+	terminated = w->terminated;
+	pthread_mutex_unlock(&workerMutex);
+	return terminated;
+}
+
+/*
+ Wait for the response of the oldest pending call, and return its slot,
+ or NULL if the worker terminated before it responded.
+ The worker sets the status before it posts the response, hence a post that leaves the slot pending
+ is the one of the watcher. A response that the worker posted before it terminated is still returned.
+*/
+static pythonWorkerSlot* waitResponse(pythonWorker* w){
+	pythonWorkerSlot* slot = getSlot(w, (w->iPost + PYTHON_WORKER_SLOTS - w->nPending) % PYTHON_WORKER_SLOTS);
+	semWait(w->semResponse);
+	if (slot->status == PYTHON_WORKER_PENDING)
+		return NULL;
+	w->nPending--;
+	return slot;
+}
+
+/* Set the size of the slots and of the shared memory of w */
+static void setSlotSize(pythonWorker* w){
+	w->slotSize = sizeof(pythonWorkerSlot)
+		+ (w->nDblWri + (w->nDblRea > 0 ? w->nDblRea : 1)) * sizeof(double)
+		+ (w->nIntWri + (w->nIntRea > 0 ? w->nIntRea : 1)) * sizeof(int)
+		+ w->lenStr;
+	w->slotSize = (w->slotSize + 7) / 8 * 8;
+	w->sharedSize = PYTHON_WORKER_SLOTS * w->slotSize;
+}
+
+/*
+ Main function of the worker executable, which is started by startWorker() with the arguments
+ moduleName functionName pythonPath nDblWri nDblRea nIntWri nIntRea nStrWri lenStr passPythonObject
+ semRequest semResponse
+ The pythonPath is an empty string if it is NULL.
+ The function returns 0 once the simulator stopped the worker, and 1 if the worker cannot be set up.
+*/
+int runPythonWorker(int argc, char* argv[]){
+	pythonWorker worker;
+	pythonWorker* w = &worker;
+	void* memory;
+	const char** strVal;
+	pythonWorkerSlot* slot;
+	pthread_t watchdog;
+	double* dblVal;
+	int* intVal;
+	char* str;
+	size_t iSlot = 0;
+	size_t i;
+
+	if (argc != 13){
+		fprintf(stderr, "%s must only be started by the Python interface of the Buildings library.\n", argv[0]);
+		return 1;
+	}
+	isWorkerProcess = 1;
+	if (pthread_create(&watchdog, NULL, watchSimulator, NULL) != 0)
+		return 1;
+
+	memset(w, 0, sizeof(pythonWorker));
+	w->moduleName = argv[1];
+	w->functionName = argv[2];
+	w->pythonPath = (argv[3][0] == '\0') ? NULL : argv[3];
+	w->nDblWri = (size_t)strtoul(argv[4], NULL, 10);
+	w->nDblRea = (size_t)strtoul(argv[5], NULL, 10);
+	w->nIntWri = (size_t)strtoul(argv[6], NULL, 10);
+	w->nIntRea = (size_t)strtoul(argv[7], NULL, 10);
+	w->nStrWri = (size_t)strtoul(argv[8], NULL, 10);
+	w->lenStr = (size_t)strtoul(argv[9], NULL, 10);
+	w->passPythonObject = atoi(argv[10]);
+	setSlotSize(w);
+	w->shared = mmap(NULL, w->sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED, PYTHON_WORKER_SHARED_FD, 0);
+	close(PYTHON_WORKER_SHARED_FD);
+	w->semRequest = sem_open(argv[11], 0);
+	w->semResponse = sem_open(argv[12], 0);
+	if (w->shared == MAP_FAILED || w->semRequest == SEM_FAILED || w->semResponse == SEM_FAILED)
+		return 1;
+
+	memory = initPythonMemory();
+	strVal = malloc((w->nStrWri + 1) * sizeof(char*));
+	if (memory == NULL || strVal == NULL)
+		return 1;
+	/* Tell the simulator that the worker is ready */
+	sem_post(w->semResponse);
+
+	for(;;){
+		semWait(w->semRequest);
+		slot = getSlot(w, iSlot);
+		if (slot->command == workerStop)
+			break;
+		dblVal = getDoubles(slot);
+		intVal = getIntegers(w, slot);
+		str = getStrings(w, slot);
+		for (i = 0; i < w->nStrWri; i++){
+			strVal[i] = str;
+			str += strlen(str) + 1;
+		}
+		workerMessage = slot->message;
+		if (setjmp(workerJmp) == 0){
+			pythonExchangeValuesNoModelica(w->moduleName, w->functionName, w->pythonPath,
+				dblVal, w->nDblWri,
+				dblVal + w->nDblWri, w->nDblRea,
+				intVal, w->nIntWri,
+				intVal + w->nIntWri, w->nIntRea,
+				strVal, w->nStrWri,
+				workerFormatError, memory, w->passPythonObject);
+			slot->status = 0;
+		}
+		else
+			slot->status = 1;
+		sem_post(w->semResponse);
+		iSlot = (iSlot + 1) % PYTHON_WORKER_SLOTS;
+	}
+	/* Free the Python object, which also sends the queued samples of batched functions */
+	freePythonMemory(memory);
+	free(strVal);
+	return 0;
+}
+
+/* Open the semaphore with the name name, which is removed once the worker opened it */
+static sem_t* openSemaphore(unsigned long iWorker, char type, char* name, size_t n){
+	snprintf(name, n, "/mblpy%ld.%lu%c", (long)getpid(), iWorker, type);
+	return sem_open(name, O_CREAT | O_EXCL, 0600, 0);
+}
+
+/* Open shared memory of size bytes. Return its file descriptor, or -1 on failure */
+static int openSharedMemory(unsigned long iWorker, size_t size){
+	char name[32];
+	int fd;
+	snprintf(name, sizeof(name), "/mblpy%ld.%lum", (long)getpid(), iWorker);
+	/* The file descriptor of shm_open has FD_CLOEXEC set. The name is not needed as the descriptor is passed to the worker. */
+	fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0)
+		return -1;
+	shm_unlink(name);
+	if (ftruncate(fd, (off_t)size) != 0){
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/* Open a pipe whose file descriptors have FD_CLOEXEC set. Return 0 on success */
+static int openPipe(int fd[2]){
+#if defined(__linux__)
+	return pipe2(fd, O_CLOEXEC);
+#else
+	if (pipe(fd) != 0)
+		return -1;
+	if (fcntl(fd[0], F_SETFD, FD_CLOEXEC) != 0 || fcntl(fd[1], F_SETFD, FD_CLOEXEC) != 0){
+		close(fd[0]);
+		close(fd[1]);
+		return -1;
+	}
+	return 0;
+#endif
+}
+
+/* Return the absolute name of the worker executable, which is in the directory of this library, or NULL */
+static char* getWorkerExecutable(){
+	Dl_info info;
+	const char* sep;
+	char* exe;
+	char name[64];
+	size_t lenDir;
+
+	if (dladdr(&workerAnchor, &info) == 0 || info.dli_fname == NULL)
+		return NULL;
+	snprintf(name, sizeof(name), PYTHON_WORKER_EXECUTABLE, PY_MAJOR_VERSION, PY_MINOR_VERSION);
+	sep = strrchr(info.dli_fname, '/');
+	lenDir = (sep == NULL) ? 0 : (size_t)(sep - info.dli_fname + 1);
+	exe = malloc(lenDir + strlen(name) + 1);
+	if (exe == NULL)
+		return NULL;
+	memcpy(exe, info.dli_fname, lenDir);
+	strcpy(exe + lenDir, name);
+	return exe;
+}
+
+static void closeWorker(pythonWorker* w){
+	if (w->semRequest != NULL && w->semRequest != SEM_FAILED){
+		sem_unlink(w->semName[0]);
+		sem_close(w->semRequest);
+	}
+	if (w->semResponse != NULL && w->semResponse != SEM_FAILED){
+		sem_unlink(w->semName[1]);
+		sem_close(w->semResponse);
+	}
+	if (w->shared != MAP_FAILED)
+		munmap(w->shared, w->sharedSize);
+	if (w->pipeFd >= 0)
+		close(w->pipeFd);
+	free(w->moduleName);
+	free(w->functionName);
+	free(w->pythonPath);
+	free(w);
+}
+
+/* Start a worker process. Return NULL on failure, in which case errno is set */
+static pythonWorker* startWorker(
+	const char * moduleName,
+	const char * functionName,
+	const char * pythonPath,
+	size_t nDblWri, size_t nDblRea,
+	size_t nIntWri, size_t nIntRea,
+	const char ** strValWri, size_t nStrWri,
+	int passPythonObject)
+{
+	pythonWorker* w;
+	unsigned long iWorker;
+	size_t i;
+	int fd[2] = {-1, -1};
+	int shmFd = -1;
+	int spawnFd[2] = {-1, -1};
+	char* exe;
+	char* argv[14];
+	char num[7][24];
+	posix_spawn_file_actions_t actions;
+	int ret = 0;
+
+	w = calloc(1, sizeof(pythonWorker));
+	if (w == NULL)
+		return NULL;
+	w->pipeFd = -1;
+	w->shared = MAP_FAILED;
+	w->moduleName = copyString(moduleName);
+	w->functionName = copyString(functionName);
+	w->pythonPath = copyString(pythonPath);
+	w->nDblWri = nDblWri;
+	w->nIntWri = nIntWri;
+	w->nStrWri = nStrWri;
+	w->nDblRea = nDblRea;
+	w->nIntRea = nIntRea;
+	w->passPythonObject = passPythonObject;
+
+	/* Reserve space for strings that are longer than those of the first call */
+	w->lenStr = 4096;
+	for (i = 0; i < nStrWri; i++)
+		w->lenStr += 2 * strlen(strValWri[i]) + 1;
+	setSlotSize(w);
+
+	pthread_mutex_lock(&workerMutex);
+	iWorker = nWorkers++;
+	pthread_mutex_unlock(&workerMutex);
+	w->semRequest = openSemaphore(iWorker, 'q', w->semName[0], sizeof(w->semName[0]));
+	w->semResponse = openSemaphore(iWorker, 'r', w->semName[1], sizeof(w->semName[1]));
+	shmFd = openSharedMemory(iWorker, w->sharedSize);
+	if (shmFd >= 0)
+		w->shared = mmap(NULL, w->sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED, shmFd, 0);
+	exe = getWorkerExecutable();
+
+	if (w->moduleName == NULL || w->functionName == NULL || (pythonPath != NULL && w->pythonPath == NULL)
+		|| w->shared == MAP_FAILED || w->semRequest == SEM_FAILED || w->semResponse == SEM_FAILED
+		|| exe == NULL || openPipe(fd) != 0){
+		ret = errno;
+		free(exe);
+		if (shmFd >= 0)
+			close(shmFd);
+		closeWorker(w);
+		errno = ret;
+		return NULL;
+	}
+
+	/* Copy the descriptors to numbers above those of the worker, so that they do not */
+	/* overwrite each other when they are duplicated to PYTHON_WORKER_SHARED_FD and PYTHON_WORKER_PIPE_FD */
+	spawnFd[0] = fcntl(shmFd, F_DUPFD_CLOEXEC, PYTHON_WORKER_PIPE_FD + 1);
+	spawnFd[1] = fcntl(fd[0], F_DUPFD_CLOEXEC, PYTHON_WORKER_PIPE_FD + 1);
+	close(shmFd);
+	close(fd[0]);
+	w->pipeFd = fd[1];
+
+	snprintf(num[0], sizeof(num[0]), "%lu", (unsigned long)nDblWri);
+	snprintf(num[1], sizeof(num[1]), "%lu", (unsigned long)nDblRea);
+	snprintf(num[2], sizeof(num[2]), "%lu", (unsigned long)nIntWri);
+	snprintf(num[3], sizeof(num[3]), "%lu", (unsigned long)nIntRea);
+	snprintf(num[4], sizeof(num[4]), "%lu", (unsigned long)nStrWri);
+	snprintf(num[5], sizeof(num[5]), "%lu", (unsigned long)w->lenStr);
+	snprintf(num[6], sizeof(num[6]), "%d", passPythonObject);
+	argv[0] = exe;
+	argv[1] = w->moduleName;
+	argv[2] = w->functionName;
+	argv[3] = (w->pythonPath == NULL) ? "" : w->pythonPath;
+	for (i = 0; i < 7; i++)
+		argv[4 + i] = num[i];
+	argv[11] = w->semName[0];
+	argv[12] = w->semName[1];
+	argv[13] = NULL;
+
+	/* dup2 to another descriptor clears FD_CLOEXEC, hence only these two descriptors are inherited */
+	if (spawnFd[0] < 0 || spawnFd[1] < 0)
+		ret = errno;
+	else if ((ret = posix_spawn_file_actions_init(&actions)) == 0){
+		ret = posix_spawn_file_actions_adddup2(&actions, spawnFd[0], PYTHON_WORKER_SHARED_FD);
+		if (ret == 0)
+			ret = posix_spawn_file_actions_adddup2(&actions, spawnFd[1], PYTHON_WORKER_PIPE_FD);
+		if (ret == 0)
+			ret = posix_spawn(&(w->pid), exe, &actions, NULL, argv, workerEnviron);
+		posix_spawn_file_actions_destroy(&actions);
+	}
+	if (spawnFd[0] >= 0)
+		close(spawnFd[0]);
+	if (spawnFd[1] >= 0)
+		close(spawnFd[1]);
+	free(exe);
+	if (ret == 0 && (ret = pthread_create(&(w->watcher), NULL, watchWorker, w)) != 0){
+		kill(w->pid, SIGKILL);
+		waitpid(w->pid, NULL, 0);
+	}
+	if (ret != 0){
+		closeWorker(w);
+		errno = ret;
+		return NULL;
+	}
+
+	/* Wait until the worker opened the semaphores, or terminated because it could not be set up */
+	semWait(w->semResponse);
+	sem_unlink(w->semName[0]);
+	sem_unlink(w->semName[1]);
+	if (isTerminated(w)){
+		pthread_join(w->watcher, NULL);
+		closeWorker(w);
+		errno = ECHILD;
+		return NULL;
+	}
+	return w;
+}
+
+/* Stop the worker, report errors of calls whose response has not yet been read, and free it */
+static void stopWorker(pythonWorker* w){
+	pythonWorkerSlot* slot;
+
+	/* Read the responses of the pending calls */
+	while (w->nPending > 0 && !isTerminated(w)){
+		slot = waitResponse(w);
+		if (slot == NULL)
+			break;
+		if (slot->status != 0)
+			fprintf(stderr, "Python function \"%s\" in worker process %ld: %s\n",
+				w->functionName, (long)w->pid, slot->message);
+	}
+	if (!isTerminated(w)){
+		getSlot(w, w->iPost)->command = workerStop;
+		sem_post(w->semRequest);
+	}
+	/* The watcher returns once the worker terminated */
+	pthread_join(w->watcher, NULL);
+	closeWorker(w);
+}
+
+/* Return a description of the termination of the worker */
+static void describeTermination(const pythonWorker* w, char* msg, size_t n){
+	if (WIFSIGNALED(w->exitStatus))
+		snprintf(msg, n, "was terminated by signal %d", WTERMSIG(w->exitStatus));
+	else
+		snprintf(msg, n, "exited with status %d", WEXITSTATUS(w->exitStatus));
+}
+
+/*
+ Post a call to the worker, and wait for its response unless the call reads no values.
+ Return 0 on success, 1 if Python reported an error, whose message is copied to msg,
+ and -1 if the worker terminated.
+*/
+static int callWorker(pythonWorker* w,
+	const double * dblValWri,
+	double * dblValRea,
+	const int * intValWri,
+	int * intValRea,
+	const char ** strValWri,
+	char* msg)
+{
+	pythonWorkerSlot* slot;
+	char* str;
+	size_t len;
+	size_t i;
+	const int wait = (w->nDblRea > 0 || w->nIntRea > 0) ? 1 : 0;
+
+	/* If all slots are in use, read the response of the oldest call, which is in the next slot */
+	if (w->nPending == PYTHON_WORKER_SLOTS){
+		slot = waitResponse(w);
+		if (slot == NULL)
+			return -1;
+		if (slot->status != 0){
+			strcpy(msg, slot->message);
+			return 1;
+		}
+	}
+
+	/* Write the call to the next slot */
+	slot = getSlot(w, w->iPost);
+	slot->command = workerCall;
+	slot->status = PYTHON_WORKER_PENDING;
+	memcpy(getDoubles(slot), dblValWri, w->nDblWri * sizeof(double));
+	memcpy(getIntegers(w, slot), intValWri, w->nIntWri * sizeof(int));
+	str = getStrings(w, slot);
+	len = 0;
+	for (i = 0; i < w->nStrWri; i++){
+		const size_t n = strlen(strValWri[i]) + 1;
+		if (len + n > w->lenStr){
+			snprintf(msg, PYTHON_WORKER_MESSAGE, "The strings are longer than the %lu characters that are reserved for them.",
+				(unsigned long)w->lenStr);
+			return 1;
+		}
+		memcpy(str + len, strValWri[i], n);
+		len += n;
+	}
+	sem_post(w->semRequest);
+	w->iPost = (w->iPost + 1) % PYTHON_WORKER_SLOTS;
+	w->nPending++;
+
+	/* Modelica has no arrays with zero length, hence the dummy values are set to zero */
+	if (w->nDblRea == 0)
+		dblValRea[0] = 0;
+	if (w->nIntRea == 0)
+		intValRea[0] = 0;
+	if (!wait)
+		return 0;
+
+	/* Read the responses of the pending calls, of which this call is the last one */
+	while (w->nPending > 0){
+		slot = waitResponse(w);
+		if (slot == NULL)
+			return -1;
+		if (slot->status != 0){
+			strcpy(msg, slot->message);
+			return 1;
+		}
+	}
+	memcpy(dblValRea, getDoubles(slot) + w->nDblWri, w->nDblRea * sizeof(double));
+	memcpy(intValRea, getIntegers(w, slot) + w->nIntWri, w->nIntRea * sizeof(int));
+	return 0;
+}
+
+void pythonWorkerExchangeValues(void** worker,
+	const char * moduleName,
+	const char * functionName,
+	const char * pythonPath,
+	const double * dblValWri, size_t nDblWri,
+	double * dblValRea, size_t nDblRea,
+	const int * intValWri, size_t nIntWri,
+	int * intValRea, size_t nIntRea,
+	const char ** strValWri, size_t nStrWri,
+	void(*ModelicaFormatError)(const char *string, ...),
+	int passPythonObject)
+{
+	pythonWorker* w = (pythonWorker*)*worker;
+	char msg[PYTHON_WORKER_MESSAGE];
+	char termination[64];
+	int nRestart = 0;
+	int ret;
+
+	for(;;){
+		if (w == NULL){
+			w = startWorker(moduleName, functionName, pythonPath,
+				nDblWri, nDblRea, nIntWri, nIntRea, strValWri, nStrWri, passPythonObject);
+			*worker = w;
+			if (w == NULL && errno == ECHILD)
+				(*ModelicaFormatError)("The worker process for Python function \"%s\" of module \"%s\" terminated during its start.",
+					functionName, moduleName);
+			if (w == NULL)
+				(*ModelicaFormatError)("Failed to start the worker process for Python function \"%s\" of module \"%s\": %s.\n\
+ The executable " PYTHON_WORKER_EXECUTABLE " must be in the same directory as the Python library of the Buildings library.",
+					functionName, moduleName, strerror(errno), PY_MAJOR_VERSION, PY_MINOR_VERSION);
+		}
+		ret = callWorker(w, dblValWri, dblValRea, intValWri, intValRea, strValWri, msg);
+		if (ret == 0)
+			return;
+		if (ret == 1)
+			(*ModelicaFormatError)("%s", msg);
+
+		/* The worker terminated. Restart it once, and repeat the call. */
+		/* The Python object, if any, and calls that did not wait for their response are lost. */
+		describeTermination(w, termination, sizeof(termination));
+		stopWorker(w);
+		w = NULL;
+		*worker = NULL;
+		if (nRestart > 0)
+			(*ModelicaFormatError)("The worker process for Python function \"%s\" of module \"%s\" %s after it has been restarted.",
+				functionName, moduleName, termination);
+		fprintf(stderr, "Warning: The worker process for Python function \"%s\" of module \"%s\" %s. Restarting it.\n",
+			functionName, moduleName, termination);
+		nRestart++;
+	}
+}
+
+void freePythonWorker(void* worker){
+	if (worker != NULL)
+		stopWorker((pythonWorker*)worker);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Functions that call a Python function in a worker process
+ * rather than in the embedded interpreter of the simulator.
+ *
+ * Each Python object, and hence each moduleName and functionName pair
+ * of a model, is served by its own worker process, which is started
+ * at the first call and kept until the object is freed.
+ * The values are exchanged through a ring of slots in shared memory,
+ * and the requests and responses are signaled with semaphores.
+ * Calls that do not read values from Python do not wait for the
+ * response, hence the worker processes of such functions run in parallel
+ * with the simulator and with each other.
+ *
+ * agent                                 10/19/2026
+ */
+#ifndef BUILDINGS_PYTHONWORKER_H
+#define BUILDINGS_PYTHONWORKER_H
+
+#include <stddef.h>  /* stddef defines size_t */
+
+/* Environment variable that, if set to 1, runs the Python functions in worker processes.*/
+/* Worker processes are only supported on Linux and macOS.*/
+#define PYTHON_WORKER "MODELICA_BUILDINGS_PYTHON_WORKER"
+
+/* Name of the executable of the worker process, which is in the directory of this library.*/
+/* The arguments of the format are the major and the minor version of Python.*/
+#define PYTHON_WORKER_EXECUTABLE "ModelicaBuildingsPython%d.%dWorker"
+
+/* Number of slots of the ring, which is the maximum number of calls that are*/
+/* posted to a worker without waiting for their response.*/
+#define PYTHON_WORKER_SLOTS 8
+
+/* Size of the error message of a slot.*/
+#define PYTHON_WORKER_MESSAGE 4096
+
+/* Return 1 if the Python functions run in worker processes, and 0 otherwise.*/
+int usePythonWorker();
+
+/* Exchange values with the Python function in the worker process *worker,*/
+/* which is started if *worker is NULL, and restarted once if it terminates.*/
+/* The arguments are as for pythonExchangeValuesNoModelica.*/
+void pythonWorkerExchangeValues(void** worker,
+	const char * moduleName,
+	const char * functionName,
+	const char * pythonPath,
+	const double * dblValWri, size_t nDblWri,
+	double * dblValRea, size_t nDblRea,
+	const int * intValWri, size_t nIntWri,
+	int * intValRea, size_t nIntRea,
+	const char ** strValWri, size_t nStrWri,
+	void(*ModelicaFormatError)(const char *string, ...),
+	int passPythonObject);
+
+/* Stop the worker process and free its resources.*/
+void freePythonWorker(void* worker);
+
+/* Main function of the worker executable.*/
+int runPythonWorker(int argc, char* argv[]);
+
+#endif
@@ -0,0 +1,11 @@
+/*
+ * Main program of the worker process that runs a Python function,
+ * see pythonWorker.h.
+ *
+ * agent                                 10/19/2026
+ */
+#include "pythonWorker.h"
+
+int main(int argc, char* argv[]){
+	return runPythonWorker(argc, argv);
+}
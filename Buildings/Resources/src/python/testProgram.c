@@ -28,10 +28,7 @@ int main(int nArgs, char ** args){
   size_t nStrWri = 0;
 
   int i;
-  pythonPtr* ptr = malloc(sizeof(pythonPtr));
-  /* Set ptr to null as pythonExchangeValuesNoModelica is checking for this */
-  ptr->ptr = NULL;
-  ptr->isInitialized = 0;
+  void* ptr = initPythonMemory();
 
   for(i=0; i < 3  ; i++){
     printf("Calling pythonExchangeValuesNoModelica with i = %d.\n", i);
@@ -49,5 +46,6 @@ int main(int nArgs, char ** args){
       1
     );
   }
+  freePythonMemory(ptr);
   return 0;
 }